@@ -27,10 +27,14 @@
 #include "bobshelp.h"
 #include "terminal.h"
 #include "inout.h"
+#include "injector.h"
+#include "schedule.h"
 
-Acia1::Acia1(TerminalIO &p_terminalIO, Inout &p_inout) :
+Acia1::Acia1(TerminalIO &p_terminalIO, Inout &p_inout,
+             Scheduler &p_scheduler) :
              terminalIO(p_terminalIO)
              , inout(p_inout)
+             , scheduler(p_scheduler)
 {
 }
 
@@ -38,11 +42,33 @@ void Acia1::resetIo()
 {
     Mc6850::resetIo();
     terminalIO.reset_serial();
+    if (inputInjector != nullptr)
+    {
+        inputInjector->ResetDelay();
+    }
+}
+
+void Acia1::set_input_injector(InputInjector *p_inputInjector)
+{
+    inputInjector = p_inputInjector;
 }
 
 void Acia1::requestInput()
 {
-    if (terminalIO.has_char_serial())
+    // Injected text has priority over the terminal input.
+    const bool isCharAvailable =
+        (inputInjector != nullptr && inputInjector->IsCharAvailable()) ||
+        terminalIO.has_char_serial();
+
+    // The status is also read for each output character, so only a guest
+    // blocked waiting for input is notified.
+    if (inputPollDetector.OnPoll(scheduler.get_event_cycles(),
+                                 isCharAvailable))
+    {
+        Notify(NotifyId::InputRequested);
+    }
+
+    if (isCharAvailable)
     {
         activeTransition();
     }
@@ -52,6 +78,17 @@ Byte Acia1::readInput()
 {
     Byte temp;
 
+    inputPollDetector.OnTransfer();
+    if (inputInjector != nullptr)
+    {
+        const auto optional_char = inputInjector->ReadChar();
+
+        if (optional_char.has_value())
+        {
+            return optional_char.value();
+        }
+    }
+
     temp = 0;
 
     if (terminalIO.has_char_serial())
@@ -64,6 +101,7 @@ Byte Acia1::readInput()
 
 void Acia1::writeOutput(Byte val)
 {
+    inputPollDetector.OnTransfer();
     if (inout.read_serpar() == 0x00)
     {
         // Redirect serial output to gui.
@@ -75,6 +113,26 @@ void Acia1::writeOutput(Byte val)
     }
 }
 
+bool Acia1::isTransmitReady()
+{
+    // Output redirected to the gui is never blocked.
+    if (inout.read_serpar() == 0x00 || terminalIO.can_write_char_serial())
+    {
+        return true;
+    }
+
+    // The guest waits for the transmit data register being empty,
+    // this status read is no input request.
+    inputPollDetector.OnTransfer();
+
+    return false;
+}
+
+const LatencyHistogram *Acia1::getHostLatency()
+{
+    return terminalIO.get_host_latency();
+}
+
 
 void Acia1::set_irq()
 {
@@ -28,9 +28,12 @@
 #include "typedefs.h"
 #include "mc6850.h"
 #include "bobservd.h"
+#include "turboctl.h"
 
 class TerminalIO;
 class Inout;
+class InputInjector;
+class Scheduler;
 
 class Acia1 : public Mc6850, public BObserved
 {
@@ -39,6 +42,9 @@ private:
 
     TerminalIO &terminalIO;
     Inout &inout;
+    Scheduler &scheduler;
+    InputInjector *inputInjector{};
+    InputPollDetector inputPollDetector;
 
 public:
     // read data from serial line
@@ -53,16 +59,25 @@ public:
     // request for an input ready to be read
     void requestInput() override;
 
+    // check if the serial line can accept a character
+    bool isTransmitReady() override;
+
     void resetIo() override;
 
+    // Inject text into the serial input. If nullptr no text is injected.
+    void set_input_injector(InputInjector *p_inputInjector);
+
     const char *getName() override
     {
         return "acia1";
     };
 
+    // Host time needed for the I/O of the terminal.
+    const LatencyHistogram *getHostLatency() override;
+
 public:
     Acia1() = delete;
-    Acia1(TerminalIO &p_terminalIO, Inout &p_inout);
+    Acia1(TerminalIO &p_terminalIO, Inout &p_inout, Scheduler &p_scheduler);
     ~Acia1() override = default;
     Acia1(const Acia1 &src) = delete;
     Acia1(Acia1 &&src) = delete;
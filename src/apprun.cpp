@@ -35,6 +35,7 @@
 #include "soptions.h"
 #include "qtgui.h"
 #include "scpulog.h"
+#include "breltime.h"
 #include "warnoff.h"
 #include <Qt>
 #include <QObject>
@@ -42,8 +43,10 @@
 #include <QMessageBox>
 #include "warnon.h"
 #include <cstdlib>
+#include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <string>
 
 
 ApplicationRunner::ApplicationRunner(struct sOptions &p_options,
@@ -59,16 +62,21 @@ ApplicationRunner::ApplicationRunner(struct sOptions &p_options,
     scheduler(cpu, inout),
     terminalIO(scheduler, std::move(termImpl)),
     mmu(memory),
-    acia1(terminalIO, inout),
+    acia1(terminalIO, inout, scheduler),
     pia1(scheduler, keyboardIO, p_options),
     pia2(cpu, keyboardIO, joystickIO),
-    pia2v5(cpu),
+    pia2v5(cpu, scheduler),
     drisel(fdc),
     command(inout, scheduler, fdc, options),
     tstdev(512U),
     gui(cpu, memory, scheduler, inout, vico1, vico2,
         joystickIO, keyboardIO, terminalIO, pia1, p_options),
-    hostTimer(Mc146818::HOST_TIMER_ID, configFile)
+    videoCapture(scheduler, memory, vico1, vico2, p_options),
+    idleLoopDetector(cpu),
+    diskDriverHle(cpu, memory, fdc),
+    turboControl([this](bool isTurbo){ scheduler.set_turbo(isTurbo); }),
+    hostTimer(Mc146818::HOST_TIMER_ID, configFile),
+    schedulerTimer(Scheduler::HOST_TIMER_ID, configFile)
 {
     if (options.startup_command.size() > MAX_COMMAND)
     {
@@ -155,6 +163,50 @@ ApplicationRunner::ApplicationRunner(struct sOptions &p_options,
     ioDevices.insert({ tstdev.getName(), tstdev });
 
     scheduler.set_frequency(options.frequency);
+    const auto pacingSlice =
+        configFile->GetRuntimeSupportOption("frequencyPacingSlice");
+    if (!pacingSlice.empty())
+    {
+        scheduler.set_pacing_slice(static_cast<DWord>(std::stoul(pacingSlice)));
+    }
+
+    const auto maxDisplayRefreshRate =
+        configFile->GetRuntimeSupportOption("maxDisplayRefreshRate");
+    const auto syncDisplayRefresh =
+        configFile->GetRuntimeSupportOption("syncDisplayRefresh");
+    gui.SetDisplayRefreshRate(maxDisplayRefreshRate.empty() ?
+                              DEFAULT_DISPLAY_REFRESH_RATE :
+                              std::stoi(maxDisplayRefreshRate),
+                              syncDisplayRefresh == "1");
+
+    // Idle loop detection is active by default.
+    if (configFile->GetRuntimeSupportOption("idleLoopDetection") != "0")
+    {
+        memory.set_idle_loop_detector(&idleLoopDetector);
+    }
+
+    // High-level emulation of the FLEX disk driver is inactive by default.
+    // It needs the entry points of the disk driver of the boot ROM.
+    const auto entryPoints =
+        configFile->GetDiskDriverEntryPoints(options.hex_file);
+    if (!options.isEurocom2V5 && entryPoints.has_value() &&
+        configFile->GetRuntimeSupportOption("diskDriverHLE") == "1")
+    {
+        diskDriverHle.Install(entryPoints.value());
+    }
+
+    const auto turboOnDemand =
+        configFile->GetRuntimeSupportOption("turboOnDemand");
+    if (!turboOnDemand.empty() && turboOnDemand != "0")
+    {
+        turboControl.SetQuietTime(std::stoul(turboOnDemand));
+        pia1.Attach(turboControl);
+        acia1.Attach(turboControl);
+        fdc.Attach(turboControl);
+        scheduler.add_timer_hook([this](QWord /*totalCycles*/){
+            turboControl.OnTimer(BRelativeTime::GetTimeUsll());
+        });
+    }
 
     if (options.isEurocom2V5)
     {
@@ -171,14 +223,24 @@ ApplicationRunner::ApplicationRunner(struct sOptions &p_options,
     terminalIO.Attach(gui);
     command.Attach(cpu);
     command.Attach(gui);
+    command.Attach(videoCapture);
+    command.Attach(memory);
     vico1.Attach(memory);
     vico2.Attach(memory);
+    memory.Attach(gui);
     if (options.useRtc)
     {
         rtc.Attach(cpu);
         rtc.Attach(hostTimer);
         gui.Attach(hostTimer);
         hostTimer.Attach(rtc);
+
+        // With emulated time the RTC is timed by the scheduler,
+        // the host timer is not used.
+        if (configFile->GetRuntimeSupportOption("rtcEmulatedTime") == "1")
+        {
+            rtc.set_emulated_time(&scheduler);
+        }
     }
 }
 
@@ -193,6 +255,12 @@ void ApplicationRunner::AddIoDevicesToMemory()
     const auto pairOfParams = configFile->GetIoDeviceLogging();
     const auto logFilePath = std::get<0>(pairOfParams);
     const auto deviceNames = std::get<1>(pairOfParams);
+    const auto logFilter = configFile->GetIoDeviceLogFilter();
+
+    if (!deviceNames.empty())
+    {
+        ioTracer = std::make_unique<IoTracer>(fs::u8path(logFilePath));
+    }
 
     // Reserve space for all devices otherwise references get invalidated.
     debugLogDevices.reserve(deviceParams.size());
@@ -209,7 +277,8 @@ void ApplicationRunner::AddIoDevicesToMemory()
             if (deviceNames.find(name) != deviceNames.end())
             {
                 // Wrap the I/O-device by the I/O-device logger
-                debugLogDevices.emplace_back(std::ref(deviceRef), logFilePath);
+                debugLogDevices.emplace_back(std::ref(deviceRef), *ioTracer,
+                                             cpu, logFilter);
                 auto lastPos = debugLogDevices.size() - 1;
                 deviceRef =
                       dynamic_cast<IoDevice &>(debugLogDevices.at(lastPos));
@@ -352,14 +421,41 @@ int ApplicationRunner::startup(QApplication &app)
     auto optional_boot_char = configFile->GetBootCharacter(options.hex_file);
     if (options.term_mode && terminalIO.is_terminal_supported())
     {
-        terminalIO.set_startup_command(options.startup_command);
+        acia1.set_input_injector(&inputInjector);
     }
     else
     {
-        keyboardIO.set_startup_command(options.startup_command);
+        pia1.set_input_injector(&inputInjector);
+    }
+    if (!options.startup_command.empty())
+    {
+        inputInjector.Inject(options.startup_command + "\r");
+    }
+    if (!options.inputScriptPath.empty() &&
+        !inputInjector.InjectFile(options.inputScriptPath))
+    {
+        std::cerr << "*** Error: Unable to read input script file " <<
+                     options.inputScriptPath << '\n';
     }
     keyboardIO.set_boot_char(optional_boot_char);
 
+    if (!options.capturePath.empty() && options.captureCycleInterval != 0U)
+    {
+        videoCapture.StartSequence(options.capturePath,
+                                   options.captureCycleInterval);
+    }
+
+#ifndef USE_POSIX_TIMERS
+    // The scheduler tick is driven by a host timer. If it is not
+    // available the GUI timer is used. POSIX timers are not used because
+    // they notify within a signal handler.
+    HostTimerUpdate_t params{TIME_BASE * 1000, Scheduler::HOST_TIMER_ID,
+                             false};
+    schedulerTimer.Attach(scheduler);
+    schedulerTimer.UpdateFrom(NotifyId::SetHostTimer, &params);
+    gui.SetSchedulerTick(!params.isValid);
+#endif
+
     // start CPU thread
     cpuThread = std::make_unique<std::thread>(&Scheduler::run, &scheduler);
 
@@ -378,6 +474,13 @@ void ApplicationRunner::cleanup()
         scheduler.request_new_state(CpuState::Exit);
         cpuThread->join(); // wait for termination of CPU thread
         cpuThread.reset();
+
+        if (!options.capturePath.empty() &&
+            options.captureCycleInterval == 0U)
+        {
+            // Capture the final screen.
+            videoCapture.CaptureFrame(options.capturePath);
+        }
     }
 }
 
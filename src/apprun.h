@@ -47,7 +47,13 @@
 #include "drisel.h"
 #include "tstdev.h"
 #include "iodevdbg.h"
+#include "iotrace.h"
 #include "hosttime.h"
+#include "vidcaptr.h"
+#include "idleloop.h"
+#include "fdrvhle.h"
+#include "turboctl.h"
+#include "injector.h"
 #include "fcnffile.h"
 #include <string>
 #include <vector>
@@ -101,8 +107,15 @@ private:
     VideoControl2 vico2;
     TestDevice tstdev;
     QtGui gui;
+    VideoCapture videoCapture;
+    IdleLoopDetector idleLoopDetector;
+    FlexDiskDriverHle diskDriverHle;
+    TurboControl turboControl;
+    InputInjector inputInjector;
     HostTimer hostTimer;
+    HostTimer schedulerTimer;
     std::map<std::string, IoDevice &> ioDevices;
+    std::unique_ptr<IoTracer> ioTracer;
     std::vector<IoDeviceDebug> debugLogDevices;
     std::unique_ptr<std::thread> cpuThread;
 };
@@ -25,14 +25,24 @@
 #ifndef BCOMMAND_INCLUDED
 #define BCOMMAND_INCLUDED
 
+#include <atomic>
 #include <memory>
 
 class BCommand
 {
+    // The scheduler queues commands without lock and without memory
+    // allocation using the following link members.
+    friend class Scheduler;
 
 public:
-    BCommand(const BCommand &src) = default;
-    BCommand &operator=(const BCommand &src) = default;
+    // The queue state is not copied.
+    BCommand(const BCommand & /*src*/)
+    {
+    }
+    BCommand &operator=(const BCommand & /*src*/)
+    {
+        return *this;
+    }
     BCommand(BCommand &&src) = delete;
     BCommand &operator=(BCommand &&src) = delete;
     virtual ~BCommand() = default;
@@ -41,6 +51,11 @@ public:
 
 protected:
     BCommand() = default;
+
+private:
+    std::atomic<bool> isQueued{};
+    BCommand *nextQueued{};
+    std::shared_ptr<BCommand> queuedSelf;
 };
 
 using BCommandSPtr = std::shared_ptr<BCommand>;
@@ -24,6 +24,7 @@
 #define BOBSHELP_INCLUDED
 
 #include <cstdint>
+#include <string>
 
 enum class NotifyId : uint8_t
 {
@@ -39,6 +40,11 @@ enum class NotifyId : uint8_t
     KeyPressedOnCPU, // key pressed in context of CPU thread.
     SetHostTimer, // Activate or disable timer based on host time interval.
     HostTimerEvent, // Signals a host timer event.
+    VideoRamChanged, // Video RAM has changed, called on CPU thread.
+    CaptureVideo, // Capture video RAM into a file, called on CPU thread.
+    InputRequested, // Guest polls for keyboard or serial input, CPU thread.
+    DiskActive, // A floppy disk command is executed, called on CPU thread.
+    WriteIoStatistics, // Write I/O device statistics, called on CPU thread.
 };
 
 struct HostTimerUpdate_t
@@ -48,5 +54,22 @@ struct HostTimerUpdate_t
       bool isValid;
 };
 
+// If cycleInterval is 0 a single frame is captured into filePath,
+// otherwise a frame is captured each cycleInterval CPU cycles.
+// An empty filePath stops capturing frames.
+struct VideoCaptureRequest_t
+{
+      std::string filePath;
+      std::uint64_t cycleInterval;
+      bool isAccepted;
+};
+
+// Write the access statistics of all I/O devices as JSON into filePath.
+struct IoStatisticsRequest_t
+{
+      std::string filePath;
+      bool isAccepted;
+};
+
 #endif // #ifndef BOBSHELP_INCLUDED
 
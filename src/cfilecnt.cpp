@@ -0,0 +1,521 @@
+/*
+    cfilecnt.cpp  Write-back sector cache with journal for disk containers.
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "misc1.h"
+#include "cfilecnt.h"
+#include "filecntb.h"
+#include "filecnts.h"
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <system_error>
+#include <optional>
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <ios>
+#include <fstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// Each journal record consists of a header followed by the sector data.
+// All values are stored in big endian byte order:
+// Offset  Size  Description
+//      0     4  Magic number, identifies a journal record
+//      4     1  Track number
+//      5     1  Sector number
+//      6     2  Number of data bytes
+//      8     4  CRC32 of track, sector, size and data bytes
+static constexpr DWord JOURNAL_MAGIC = 0x464A4E4CU;
+static constexpr std::size_t JOURNAL_HEADER_SIZE = 12U;
+
+FlexCachedDisk::FlexCachedDisk(IFlexDiskBySectorPtr p_disk,
+                               std::size_t p_maxSectors)
+    : disk(std::move(p_disk))
+    , maxSectors(p_maxSectors)
+{
+    assert(disk != nullptr);
+    assert(maxSectors != 0U);
+
+    isCacheEnabled = disk->IsFlexFormat() &&
+                     disk->GetBytesPerSector() == SECTOR_SIZE;
+
+    if (!isCacheEnabled || disk->IsWriteProtected())
+    {
+        // All accesses are passed through, no journal needed.
+        return;
+    }
+
+    journalPath = GetJournalPath(disk->GetPath());
+    // Sectors of an interrupted session are written into the disk
+    // before any new access. If this fails the journal is kept and the
+    // disk is write protected.
+    if (!ReplayJournal())
+    {
+        isReplayError = true;
+        isCacheEnabled = false;
+        return;
+    }
+
+    journal.open(journalPath,
+                 std::ios::out | std::ios::trunc | std::ios::binary);
+    // If the journal can not be created all accesses are passed through.
+    isCacheEnabled = journal.is_open();
+}
+
+FlexCachedDisk::~FlexCachedDisk()
+{
+    // Errors when writing back are ignored. If not successful the
+    // journal is kept and replayed when opening the disk next time.
+    if (Checkpoint() && journal.is_open())
+    {
+        journal.close();
+        std::error_code error;
+        fs::remove(journalPath, error);
+    }
+}
+
+fs::path FlexCachedDisk::GetJournalPath(const fs::path &diskPath)
+{
+    auto path = diskPath;
+
+    path += ".jnl";
+
+    return path;
+}
+
+/****************************************
+ IFlexDiskBase interface implementation
+ ****************************************/
+
+bool FlexCachedDisk::IsWriteProtected() const
+{
+    return isReplayError || isWriteBackError || disk->IsWriteProtected();
+}
+
+bool FlexCachedDisk::GetDiskAttributes(
+        FlexDiskAttributes &diskAttributes) const
+{
+    // Attributes like free sectors are read from the disk itself.
+    WriteBackAll();
+
+    return disk->GetDiskAttributes(diskAttributes);
+}
+
+DiskType FlexCachedDisk::GetFlexDiskType() const
+{
+    return disk->GetFlexDiskType();
+}
+
+DiskOptions FlexCachedDisk::GetFlexDiskOptions() const
+{
+    auto options = disk->GetFlexDiskOptions();
+
+    if (isCacheEnabled)
+    {
+        options |= DiskOptions::Cached;
+    }
+
+    return options;
+}
+
+fs::path FlexCachedDisk::GetPath() const
+{
+    return disk->GetPath();
+}
+
+/****************************************
+ IFlexDiskBySector interface implementation
+ ****************************************/
+
+bool FlexCachedDisk::ReadSector(Byte *buffer, int trk, int sec,
+                                std::optional<int> side) const
+{
+    if (!IsCacheable(trk, sec))
+    {
+        return disk->ReadSector(buffer, trk, sec, side);
+    }
+
+    const auto key = GetKey(trk, sec);
+    const auto *entry = Find(key);
+
+    if (entry == nullptr)
+    {
+        if (!disk->ReadSector(buffer, trk, sec, side))
+        {
+            return false;
+        }
+
+        Insert(key, buffer, false);
+
+        return true;
+    }
+
+    std::memcpy(buffer, entry->data.data(), entry->data.size());
+
+    return true;
+}
+
+bool FlexCachedDisk::WriteSector(const Byte *buffer, int trk, int sec,
+                                 std::optional<int> side)
+{
+    if (isReplayError || isWriteBackError)
+    {
+        // The journal contains sectors which could not be written back.
+        return false;
+    }
+
+    if (!IsCacheable(trk, sec) || disk->IsWriteProtected())
+    {
+        return disk->WriteSector(buffer, trk, sec, side);
+    }
+
+    const auto key = GetKey(trk, sec);
+
+    // The sector is only accepted if it has been stored in the journal.
+    if (!AppendToJournal(key, buffer))
+    {
+        return false;
+    }
+
+    auto *entry = Find(key);
+    if (entry == nullptr)
+    {
+        Insert(key, buffer, true);
+    }
+    else
+    {
+        std::memcpy(entry->data.data(), buffer, entry->data.size());
+        entry->isDirty = true;
+    }
+
+    if (journalRecords >= maxSectors)
+    {
+        // Keep the journal size limited.
+        Checkpoint();
+    }
+
+    return true;
+}
+
+bool FlexCachedDisk::FormatSector(const Byte *buffer, int trk, int sec,
+                                  int side, unsigned sizecode)
+{
+    // Formatting may change the disk geometry. The cache is written back
+    // and dropped, formatting is passed through.
+    if (!Checkpoint())
+    {
+        return false;
+    }
+
+    cache.clear();
+    entryForKey.clear();
+
+    return disk->FormatSector(buffer, trk, sec, side, sizecode);
+}
+
+bool FlexCachedDisk::IsFlexFormat() const
+{
+    return disk->IsFlexFormat();
+}
+
+bool FlexCachedDisk::IsTrackValid(int track) const
+{
+    return disk->IsTrackValid(track);
+}
+
+bool FlexCachedDisk::IsSectorValid(int track, int sector) const
+{
+    return disk->IsSectorValid(track, sector);
+}
+
+unsigned FlexCachedDisk::GetBytesPerSector() const
+{
+    return disk->GetBytesPerSector();
+}
+
+bool FlexCachedDisk::Sync()
+{
+    return Checkpoint();
+}
+
+/****************************************
+ Private member functions
+ ****************************************/
+
+bool FlexCachedDisk::IsCacheable(int trk, int sec) const
+{
+    return isCacheEnabled && trk >= 0 && trk <= 255 && sec >= 0 &&
+           sec <= 255 && disk->IsTrackValid(trk) &&
+           disk->IsSectorValid(trk, sec);
+}
+
+Word FlexCachedDisk::GetKey(int trk, int sec)
+{
+    return static_cast<Word>((trk << 8U) | sec);
+}
+
+FlexCachedDisk::CacheEntry *FlexCachedDisk::Find(Word key) const
+{
+    const auto iter = entryForKey.find(key);
+
+    if (iter == entryForKey.end())
+    {
+        return nullptr;
+    }
+
+    // Move the entry to the front, it is the most recently used one.
+    cache.splice(cache.begin(), cache, iter->second);
+
+    return &cache.front();
+}
+
+void FlexCachedDisk::Insert(Word key, const Byte *buffer, bool isDirty) const
+{
+    auto iter = cache.end();
+
+    if (cache.size() >= maxSectors)
+    {
+        // Reuse the least recently used entry which has been written back.
+        // Entries which can not be written back are kept.
+        const auto riter = std::find_if(cache.rbegin(), cache.rend(),
+                [this](CacheEntry &entry){ return WriteBack(entry); });
+
+        if (riter != cache.rend())
+        {
+            iter = std::prev(riter.base());
+        }
+    }
+
+    if (iter != cache.end())
+    {
+        entryForKey.erase(iter->key);
+        cache.splice(cache.begin(), cache, iter);
+    }
+    else
+    {
+        cache.emplace_front(CacheEntry{0U, false,
+                std::vector<Byte>(disk->GetBytesPerSector())});
+    }
+
+    auto &entry = cache.front();
+
+    entry.key = key;
+    entry.isDirty = isDirty;
+    std::memcpy(entry.data.data(), buffer, entry.data.size());
+    entryForKey[key] = cache.begin();
+}
+
+bool FlexCachedDisk::WriteBack(CacheEntry &entry) const
+{
+    if (!entry.isDirty)
+    {
+        return true;
+    }
+
+    if (isWriteBackError)
+    {
+        // Retried on the next checkpoint.
+        return false;
+    }
+
+    const auto trk = static_cast<int>(entry.key >> 8U);
+    const auto sec = static_cast<int>(entry.key & 0xFFU);
+
+    if (!disk->WriteSector(entry.data.data(), trk, sec))
+    {
+        // The sector is still contained in the cache and the journal.
+        // Until a checkpoint succeeds the disk is write protected.
+        isWriteBackError = true;
+        return false;
+    }
+
+    entry.isDirty = false;
+
+    return true;
+}
+
+void FlexCachedDisk::WriteBackAll() const
+{
+    // Write back in ascending track/sector order.
+    std::vector<CacheEntry *> dirtyEntries;
+
+    for (auto &entry : cache)
+    {
+        if (entry.isDirty)
+        {
+            dirtyEntries.push_back(&entry);
+        }
+    }
+
+    std::sort(dirtyEntries.begin(), dirtyEntries.end(),
+            [](const CacheEntry *lhs, const CacheEntry *rhs){
+                return lhs->key < rhs->key;
+            });
+
+    for (auto *entry : dirtyEntries)
+    {
+        WriteBack(*entry);
+    }
+}
+
+bool FlexCachedDisk::Checkpoint()
+{
+    // Sectors which failed before are written back again.
+    isWriteBackError = false;
+    WriteBackAll();
+
+    if (isWriteBackError || !disk->Sync())
+    {
+        // Keep the journal, it is replayed when opening the disk next time.
+        isWriteBackError = true;
+        CommitJournal();
+        return false;
+    }
+
+    if (journal.is_open() && journalRecords != 0U)
+    {
+        journal.close();
+        journal.open(journalPath,
+                     std::ios::out | std::ios::trunc | std::ios::binary);
+        journalRecords = 0U;
+        uncommittedRecords = 0U;
+
+        return journal.is_open();
+    }
+
+    return true;
+}
+
+bool FlexCachedDisk::AppendToJournal(Word key, const Byte *buffer)
+{
+    if (!journal.is_open())
+    {
+        return false;
+    }
+
+    const auto size = static_cast<Word>(disk->GetBytesPerSector());
+    std::array<Byte, JOURNAL_HEADER_SIZE> header{};
+
+    flx::setValueBigEndian<DWord>(&header[0], JOURNAL_MAGIC);
+    flx::setValueBigEndian<Word>(&header[4], key);
+    flx::setValueBigEndian<Word>(&header[6], size);
+    flx::setValueBigEndian<DWord>(&header[8],
+            GetChecksum(&header[4], buffer, size));
+
+    journal.write(reinterpret_cast<const char *>(header.data()),
+                  header.size());
+    journal.write(reinterpret_cast<const char *>(buffer), size);
+    // The record is passed to the host operating system, so it survives
+    // an emulator crash. Syncing it to the storage device is expensive,
+    // it is done for a group of records.
+    journal.flush();
+    if (journal.fail())
+    {
+        return false;
+    }
+
+    ++journalRecords;
+    ++uncommittedRecords;
+
+    return uncommittedRecords < JOURNAL_COMMIT_RECORDS || CommitJournal();
+}
+
+// Sync all journal records to the storage device.
+bool FlexCachedDisk::CommitJournal()
+{
+    if (uncommittedRecords == 0U)
+    {
+        return true;
+    }
+
+    if (!flx::syncFile(journalPath))
+    {
+        return false;
+    }
+
+    uncommittedRecords = 0U;
+
+    return true;
+}
+
+DWord FlexCachedDisk::GetChecksum(const Byte *header, const Byte *buffer,
+                                  Word size)
+{
+    crc32.Reset();
+    for (std::size_t index = 0U; index < 4U; ++index)
+    {
+        crc32.Add(header[index]);
+    }
+    for (std::size_t index = 0U; index < size; ++index)
+    {
+        crc32.Add(buffer[index]);
+    }
+
+    return crc32.GetResult();
+}
+
+bool FlexCachedDisk::ReplayJournal()
+{
+    std::ifstream istream(journalPath, std::ios::in | std::ios::binary);
+
+    if (!istream.is_open())
+    {
+        return true;
+    }
+
+    const auto expectedSize = static_cast<Word>(disk->GetBytesPerSector());
+    std::array<Byte, JOURNAL_HEADER_SIZE> header{};
+    std::vector<Byte> buffer(expectedSize);
+
+    // Replaying stops at the first incomplete or invalid record,
+    // it has been written while the host or emulator crashed.
+    while (istream.read(reinterpret_cast<char *>(header.data()),
+                        header.size()))
+    {
+        const auto key = flx::getValueBigEndian<Word>(&header[4]);
+        const auto size = flx::getValueBigEndian<Word>(&header[6]);
+        const auto trk = static_cast<int>(key >> 8U);
+        const auto sec = static_cast<int>(key & 0xFFU);
+
+        if (flx::getValueBigEndian<DWord>(&header[0]) != JOURNAL_MAGIC ||
+            size != expectedSize ||
+            !istream.read(reinterpret_cast<char *>(buffer.data()), size) ||
+            flx::getValueBigEndian<DWord>(&header[8]) !=
+                GetChecksum(&header[4], buffer.data(), size))
+        {
+            break;
+        }
+
+        if (!disk->WriteSector(buffer.data(), trk, sec))
+        {
+            return false;
+        }
+    }
+
+    return disk->Sync();
+}
@@ -0,0 +1,135 @@
+/*
+    cfilecnt.h  Write-back sector cache with journal for disk containers.
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef CFILECNT_INCLUDED
+#define CFILECNT_INCLUDED
+
+#include "typedefs.h"
+#include "filecntb.h"
+#include "filecnts.h"
+#include "crc.h"
+#include <cstddef>
+#include <optional>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+class FlexDiskAttributes;
+
+// class FlexCachedDisk is a write-back sector cache in front of any
+// IFlexDiskBySector container. It keeps up to maxSectors sectors in RAM,
+// the least recently used sector is removed first, if it has been changed
+// it is written back into the container.
+// Each written sector is also appended to a journal file next to the
+// container (see GetJournalPath()) and passed to the host operating
+// system. The journal is synced to the storage device each
+// JOURNAL_COMMIT_RECORDS records (group commit), so if the host crashes
+// at most the last JOURNAL_COMMIT_RECORDS - 1 sectors are lost.
+// On a checkpoint all changed sectors are written back into the container,
+// it is synced and the journal is truncated. A checkpoint is done on
+// Sync(), on destruction or if the journal contains maxSectors records.
+// If the emulator or host crashes the journal is replayed into the
+// container when it is opened the next time.
+// If a sector can not be written back the journal is kept and the disk is
+// write protected until the next successful checkpoint. If the journal
+// can not be replayed it is kept and the disk is write protected as long
+// as it is opened.
+// Sectors are only cached if the container has a FLEX compatible format,
+// otherwise or if the journal can not be created all accesses are passed
+// through.
+class FlexCachedDisk : public IFlexDiskBySector
+{
+    struct CacheEntry
+    {
+        Word key;
+        bool isDirty;
+        std::vector<Byte> data;
+    };
+    using CacheList_t = std::list<CacheEntry>;
+
+public:
+    FlexCachedDisk() = delete;
+    FlexCachedDisk(IFlexDiskBySectorPtr p_disk, std::size_t p_maxSectors);
+    ~FlexCachedDisk() override;
+    FlexCachedDisk(const FlexCachedDisk &src) = delete;
+    FlexCachedDisk(FlexCachedDisk &&src) = delete;
+    FlexCachedDisk &operator= (const FlexCachedDisk &src) = delete;
+    FlexCachedDisk &operator= (FlexCachedDisk &&src) = delete;
+
+    static fs::path GetJournalPath(const fs::path &diskPath);
+
+    static constexpr std::size_t JOURNAL_COMMIT_RECORDS = 16U;
+
+    // IFlexDiskBase interface declaration
+    bool IsWriteProtected() const override;
+    bool GetDiskAttributes(FlexDiskAttributes &diskAttributes) const override;
+    DiskType GetFlexDiskType() const override;
+    DiskOptions GetFlexDiskOptions() const override;
+    fs::path GetPath() const override;
+
+    // IFlexDiskBySector interface declaration
+    bool ReadSector(Byte *buffer, int trk, int sec,
+            std::optional<int> side = std::nullopt) const override;
+    bool WriteSector(const Byte *buffer, int trk, int sec,
+            std::optional<int> side = std::nullopt) override;
+    bool FormatSector(const Byte *buffer, int trk, int sec, int side,
+                      unsigned sizecode) override;
+    bool IsFlexFormat() const override;
+    bool IsTrackValid(int track) const override;
+    bool IsSectorValid(int track, int sector) const override;
+    unsigned GetBytesPerSector() const override;
+    bool Sync() override;
+
+private:
+    static Word GetKey(int trk, int sec);
+    bool IsCacheable(int trk, int sec) const;
+    CacheEntry *Find(Word key) const;
+    void Insert(Word key, const Byte *buffer, bool isDirty) const;
+    bool WriteBack(CacheEntry &entry) const;
+    void WriteBackAll() const;
+    bool Checkpoint();
+    bool AppendToJournal(Word key, const Byte *buffer);
+    bool CommitJournal();
+    DWord GetChecksum(const Byte *header, const Byte *buffer, Word size);
+    bool ReplayJournal();
+
+    IFlexDiskBySectorPtr disk;
+    std::size_t maxSectors;
+    bool isCacheEnabled{};
+    bool isReplayError{};
+    mutable bool isWriteBackError{};
+    fs::path journalPath;
+    std::fstream journal;
+    std::size_t journalRecords{};
+    std::size_t uncommittedRecords{};
+    Crc<DWord> crc32{0x04C11DB7U};
+    // Most recently used sectors are at the front.
+    mutable CacheList_t cache;
+    mutable std::unordered_map<Word, CacheList_t::iterator> entryForKey;
+};
+
+#endif // CFILECNT_INCLUDED
@@ -22,9 +22,14 @@
 
 
 #include "typedefs.h"
+#include "e2.h"
+#include "misc1.h"
 #include "colors.h"
 #include <cstddef>
+#include <cmath>
+#include <array>
 #include <string>
+#include <vector>
 
 
 #ifdef __cplusplus
@@ -742,3 +747,72 @@ bool flx::getColorForName(const std::string &colorName, DWord &rgbColor)
 }
 #endif /* __cplusplus */
 
+std::vector<DWord> flx::createColorTable(const std::string &color,
+                                         bool isInverse)
+{
+    const bool isWithColorScale = (flx::tolower(color) == "default");
+    Word redBase = 255;
+    Word greenBase = 255;
+    Word blueBase = 255;
+    std::vector<DWord> colorTable(MAX_COLORS);
+
+    if (!isWithColorScale)
+    {
+        flx::getRGBForName(color, redBase, greenBase, blueBase);
+    }
+
+    const auto toRgb = [](Byte red, Byte green, Byte blue) -> DWord
+    {
+        return 0xFF000000U | (static_cast<DWord>(red) << 16U) |
+               (static_cast<DWord>(green) << 8U) | static_cast<DWord>(blue);
+    };
+
+    const auto getColor = [&](Byte index) -> DWord
+    {
+        // Use same color values as Enhanced Graphics Adapter (EGA)
+        // or Tandy Color Computer 3 RGB.
+        // For details see:
+        // https://en.wikipedia.org/wiki/Enhanced_Graphics_Adapter
+        // https://exstructus.com/tags/coco/australia-colour-palette/
+        constexpr static std::array<Byte, 4> colorValues{
+            0x00, 0x55, 0xAA, 0xFF
+        };
+        unsigned scale;
+
+        // Create a color scale in the range of 0 - 3 based two color bits
+        // <color>_HIGH and <color>_LOW. Convert the color scale into a
+        // color value in the range of 0 - 255.
+        scale = index & RED_HIGH ? 2U : 0U;
+        scale |= index & RED_LOW ? 1U : 0U;
+        auto red = colorValues[scale];
+        scale = index & GREEN_HIGH ? 2U : 0U;
+        scale |= index & GREEN_LOW ? 1U : 0U;
+        auto green = colorValues[scale];
+        scale = index & BLUE_HIGH ? 2U : 0U;
+        scale |= index & BLUE_LOW ? 1U : 0U;
+        auto blue = colorValues[scale];
+
+        return toRgb(red, green, blue);
+    };
+
+    const auto getColorShade = [&](Byte index) -> DWord
+    {
+        auto dIndex = static_cast<double>(index);
+        auto red = static_cast<Byte>(redBase * sqrt(dIndex / (MAX_COLORS - 1)));
+        auto green = static_cast<Byte>(greenBase * sqrt(dIndex /
+                (MAX_COLORS - 1)));
+        auto blue = static_cast<Byte>(blueBase * sqrt(dIndex /
+                (MAX_COLORS - 1)));
+
+        return toRgb(red, green, blue);
+    };
+
+    for (Byte i = 0; i < static_cast<Byte>(colorTable.size()); ++i)
+    {
+        const auto idx = isInverse ? colorTable.size() - i - 1U : i;
+
+        colorTable[idx] = isWithColorScale ? getColor(i) : getColorShade(i);
+    }
+
+    return colorTable;
+}
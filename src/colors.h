@@ -26,6 +26,7 @@
 #include "typedefs.h"
 #include <cstddef>
 #include <string>
+#include <vector>
 
 
 extern "C" struct sRGBDef
@@ -44,6 +45,11 @@ extern "C" bool getRGBForName(const std::string &colorName, Word &red,
 extern "C" bool getColorForName(const std::string &colorName, DWord &color);
 extern "C" const struct sRGBDef colors[];
 extern "C" const std::size_t color_count;
+// Create a color table with MAX_COLORS entries used to display the video RAM.
+// Each color has the format 0xAARRGGBB, compatible to QRgb.
+// color: A color name or "default" for a multi color palette.
+extern std::vector<DWord> createColorTable(const std::string &color,
+                                           bool isInverse);
 
 }
 #endif
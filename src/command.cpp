@@ -202,6 +202,17 @@ void Command::writeIo(Word /*offset*/, Byte val)
                 {
                     answer_stream << std::fixed << std::setprecision(2)
                                   << scheduler.get_frequency() << " MHz";
+                    if (scheduler.get_turbo())
+                    {
+                        answer_stream << " (turbo)";
+                    }
+                    if (scheduler.is_pacing())
+                    {
+                        answer_stream << std::setprecision(0)
+                                      << ", pacing drift "
+                                      << scheduler.get_pacing_drift()
+                                      << " us";
+                    }
                     answer = answer_stream.str();
                     return;
                 }
@@ -253,6 +264,43 @@ void Command::writeIo(Word /*offset*/, Byte val)
                     return;
                 }
 
+                if (arg1.compare("capture") == 0)
+                {
+                    VideoCaptureRequest_t request{ };
+
+                    if (flx::tolower(arg2).compare("off") != 0)
+                    {
+                        request.filePath = convert_path(arg2).u8string();
+                    }
+                    Notify(NotifyId::CaptureVideo, &request);
+                    if (!request.isAccepted)
+                    {
+                        answer_stream << "EMU error: "
+                                         "Unable to capture video into " <<
+                                         arg2 << ".";
+                        answer = answer_stream.str();
+                    }
+
+                    return;
+                }
+
+                if (arg1.compare("iostat") == 0)
+                {
+                    IoStatisticsRequest_t request{ };
+
+                    request.filePath = convert_path(arg2).u8string();
+                    Notify(NotifyId::WriteIoStatistics, &request);
+                    if (!request.isAccepted)
+                    {
+                        answer_stream << "EMU error: "
+                                         "Unable to write I/O statistics "
+                                         "into " << arg2 << ".";
+                        answer = answer_stream.str();
+                    }
+
+                    return;
+                }
+
                 {
                     std::stringstream stream(arg2);
 
@@ -335,6 +383,33 @@ void Command::writeIo(Word /*offset*/, Byte val)
                 break;
 
             case 3:
+                if (arg1.compare("capture") == 0)
+                {
+                    VideoCaptureRequest_t request{ };
+                    std::stringstream stream(arg3);
+
+                    if ((stream >> request.cycleInterval).fail() ||
+                        request.cycleInterval == 0U)
+                    {
+                        answer_stream << "EMU parameter error: " << arg3 <<
+                                         " is not a valid cycle interval.";
+                        answer = answer_stream.str();
+                        return;
+                    }
+
+                    request.filePath = convert_path(arg2).u8string();
+                    Notify(NotifyId::CaptureVideo, &request);
+                    if (!request.isAccepted)
+                    {
+                        answer_stream << "EMU error: "
+                                         "Unable to capture video into " <<
+                                         arg2 << ".";
+                        answer = answer_stream.str();
+                    }
+
+                    return;
+                }
+
                 {
                     std::stringstream stream(arg3);
 
@@ -374,6 +449,20 @@ void Command::writeIo(Word /*offset*/, Byte val)
                     return;
                 }
 
+                if (arg1.compare("mmount") == 0)
+                {
+                    const auto path = convert_path(arg2);
+                    if (!fdc.mount_drive(path, number, MOUNT_MAPPED))
+                    {
+                        answer_stream << "EMU error: "
+                                         "Unable to mount " << path <<
+                                         " to drive #" << number << ".";
+                        answer = answer_stream.str();
+                    }
+
+                    return;
+                }
+
                 break;
 
             case 4:
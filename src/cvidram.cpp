@@ -0,0 +1,124 @@
+/*
+    cvidram.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "e2.h"
+#include "cvidram.h"
+#include "memory.h"
+#include "vico1.h"
+#include "vico2.h"
+#include <cassert>
+#include <cstring>
+#include <chrono>
+#include <mutex>
+
+
+CReadVideoRam::CReadVideoRam(Memory &p_memory, VideoControl1 &p_vico1,
+        VideoControl2 &p_vico2, VideoRamConsumer p_consumer)
+    : memory(p_memory)
+    , vico1(p_vico1)
+    , vico2(p_vico2)
+    , consumer(p_consumer)
+    , data(static_cast<size_t>(YBLOCKS) * COLOR_PLANES * YBLOCK_SIZE)
+{
+}
+
+void CReadVideoRam::Prepare(Byte p_planes, bool p_isForceUpdate)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    assert(p_planes >= 1U && p_planes <= COLOR_PLANES);
+    planes = p_planes;
+    isForceUpdate = p_isForceUpdate;
+    changedBlocks.reset();
+    isExecuted = false;
+}
+
+void CReadVideoRam::Execute()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        const auto bank = vico1.get_value();
+
+        firstRasterLine = vico2.get_value();
+        isVideoBankValid = memory.is_video_bank_valid(bank);
+
+        for (int blockNumber = 0; blockNumber < YBLOCKS; ++blockNumber)
+        {
+            if (!isForceUpdate && !memory.has_changed(blockNumber, consumer))
+            {
+                continue;
+            }
+
+            memory.reset_changed(blockNumber, consumer);
+            changedBlocks.set(static_cast<size_t>(blockNumber));
+
+            if (isVideoBankValid)
+            {
+                const auto *src = memory.get_video_ram(bank, blockNumber);
+                auto *dst = &data[static_cast<size_t>(blockNumber) *
+                                  COLOR_PLANES * YBLOCK_SIZE];
+
+                for (Byte plane = 0U; plane < planes; ++plane)
+                {
+                    std::memcpy(dst + plane * YBLOCK_SIZE,
+                                src + plane * VIDEORAM_SIZE, YBLOCK_SIZE);
+                }
+            }
+        }
+
+        isExecuted = true;
+    }
+    condition.notify_one();
+}
+
+bool CReadVideoRam::WaitForExecution(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    return condition.wait_for(lock, timeout, [&](){ return isExecuted; });
+}
+
+const CReadVideoRam::BlockSet &CReadVideoRam::GetChangedBlocks() const
+{
+    return changedBlocks;
+}
+
+Byte CReadVideoRam::GetFirstRasterLine() const
+{
+    return firstRasterLine;
+}
+
+bool CReadVideoRam::IsVideoBankValid() const
+{
+    return isVideoBankValid;
+}
+
+Byte const *CReadVideoRam::GetBlockData(int blockNumber) const
+{
+    assert(blockNumber >= 0 && blockNumber < YBLOCKS);
+
+    return &data[static_cast<size_t>(blockNumber) * COLOR_PLANES *
+                 YBLOCK_SIZE];
+}
@@ -0,0 +1,94 @@
+/*
+    cvidram.h
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef CVIDRAM_INCLUDED
+#define CVIDRAM_INCLUDED
+
+#include "typedefs.h"
+#include "e2.h"
+#include "bcommand.h"
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+class Memory;
+class VideoControl1;
+class VideoControl2;
+
+// Take a snapshot of all changed video RAM blocks.
+// Execute() is called on the CPU thread between two instructions, so the
+// copied video RAM and the video control registers are consistent with
+// each other. The changed flags of the copied blocks are reset for the
+// given consumer only.
+class CReadVideoRam : public BCommand
+{
+
+public:
+    using BlockSet = std::bitset<YBLOCKS>;
+
+    CReadVideoRam(Memory &p_memory, VideoControl1 &p_vico1,
+                  VideoControl2 &p_vico2,
+                  VideoRamConsumer p_consumer = VideoRamConsumer::Display);
+    ~CReadVideoRam() override = default;
+    CReadVideoRam(const CReadVideoRam &src) = delete;
+    CReadVideoRam(CReadVideoRam &&src) = delete;
+    CReadVideoRam &operator=(const CReadVideoRam &src) = delete;
+    CReadVideoRam &operator=(CReadVideoRam &&src) = delete;
+    void Execute() override;
+
+    // Prepare the snapshot before passing it to Scheduler::sync_exec().
+    // p_planes: The number of color planes to be copied (1, 3 or 6).
+    // p_isForceUpdate: If true all blocks are copied.
+    void Prepare(Byte p_planes, bool p_isForceUpdate);
+    // Wait until Execute() has been called. Returns false on timeout.
+    bool WaitForExecution(std::chrono::milliseconds timeout);
+
+    const BlockSet &GetChangedBlocks() const;
+    Byte GetFirstRasterLine() const;
+    bool IsVideoBankValid() const;
+    // Get the video RAM of one block. The color planes are stored
+    // consecutively, each of size YBLOCK_SIZE.
+    Byte const *GetBlockData(int blockNumber) const;
+
+private:
+    Memory &memory;
+    VideoControl1 &vico1;
+    VideoControl2 &vico2;
+    VideoRamConsumer consumer;
+    std::vector<Byte> data;
+    BlockSet changedBlocks;
+    Byte planes{1U};
+    Byte firstRasterLine{0U};
+    bool isVideoBankValid{};
+    bool isForceUpdate{};
+    bool isExecuted{};
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+using CReadVideoRamSPtr = std::shared_ptr<CReadVideoRam>;
+
+#endif
@@ -0,0 +1,158 @@
+/*
+    dirwatch.cpp  Watch a host directory for changed files.
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "misc1.h"
+#include "dirwatch.h"
+#ifdef USE_INOTIFY
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+#ifdef USE_INOTIFY
+// Timeout in ms after which the watcher thread checks for exit.
+static constexpr int POLL_TIMEOUT = 100;
+#endif
+
+DirectoryWatcher::DirectoryWatcher(const fs::path &p_directory)
+{
+#ifdef USE_INOTIFY
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    constexpr auto mask = IN_CREATE | IN_DELETE | IN_MODIFY |
+        IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    if (inotify_add_watch(fd, p_directory.u8string().c_str(), mask) < 0)
+    {
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    watcherThread =
+        std::make_unique<std::thread>(&DirectoryWatcher::Run, this);
+#else
+    (void)p_directory;
+#endif
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    isExit.store(true);
+
+#ifdef USE_INOTIFY
+    if (watcherThread)
+    {
+        watcherThread->join();
+        watcherThread.reset();
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+bool DirectoryWatcher::IsActive() const
+{
+#ifdef USE_INOTIFY
+    return watcherThread != nullptr;
+#else
+    return false;
+#endif
+}
+
+bool DirectoryWatcher::HasChanges() const
+{
+    return hasChanges.load(std::memory_order_relaxed);
+}
+
+DirectoryWatcher::Changes DirectoryWatcher::TakeChanges()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    Changes result;
+
+    std::swap(result, changes);
+    hasChanges.store(false, std::memory_order_relaxed);
+
+    return result;
+}
+
+#ifdef USE_INOTIFY
+void DirectoryWatcher::Run()
+{
+    flx::setCurrentThreadName("DirWatchThread");
+
+    alignas(inotify_event) std::array<char, 4096> buffer{};
+    pollfd pfd{fd, POLLIN, 0};
+
+    while (!isExit.load())
+    {
+        if (poll(&pfd, 1U, POLL_TIMEOUT) <= 0)
+        {
+            continue;
+        }
+
+        const auto count = read(fd, buffer.data(), buffer.size());
+        if (count <= 0)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex);
+        for (const char *ptr = buffer.data(); ptr < buffer.data() + count;)
+        {
+            const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0U)
+            {
+                changes.isOverflow = true;
+            }
+            else if (event->len != 0U && (event->mask & IN_ISDIR) == 0U)
+            {
+                changes.filenames.emplace(event->name);
+            }
+
+            ptr += sizeof(inotify_event) + event->len;
+        }
+        hasChanges.store(changes.isOverflow || !changes.filenames.empty(),
+                         std::memory_order_relaxed);
+    }
+}
+#endif
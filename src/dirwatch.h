@@ -0,0 +1,84 @@
+/*
+    dirwatch.h  Watch a host directory for changed files.
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef DIRWATCH_INCLUDED
+#define DIRWATCH_INCLUDED
+
+#ifdef __linux__
+#define USE_INOTIFY
+#endif
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// class DirectoryWatcher watches a host directory on a separate thread.
+// It collects the names of all files which have been created, deleted,
+// renamed or modified. The owner of the watcher takes the collected
+// file names with TakeChanges() and applies them on its own thread.
+// If too many changes happen in a short time the names get lost, in this
+// case isOverflow is set and the owner has to check all files.
+// Watching is only supported on Linux (inotify). On other platforms
+// IsActive() returns false and no changes are reported.
+class DirectoryWatcher
+{
+public:
+    struct Changes
+    {
+        std::set<std::string> filenames;
+        bool isOverflow{};
+    };
+
+    DirectoryWatcher() = delete;
+    explicit DirectoryWatcher(const fs::path &p_directory);
+    ~DirectoryWatcher();
+    DirectoryWatcher(const DirectoryWatcher &src) = delete;
+    DirectoryWatcher(DirectoryWatcher &&src) = delete;
+    DirectoryWatcher &operator=(const DirectoryWatcher &src) = delete;
+    DirectoryWatcher &operator=(DirectoryWatcher &&src) = delete;
+
+    bool IsActive() const;
+    // Can be called with high frequency, it does not lock.
+    bool HasChanges() const;
+    Changes TakeChanges();
+
+private:
+#ifdef USE_INOTIFY
+    void Run();
+
+    int fd{-1};
+    std::unique_ptr<std::thread> watcherThread;
+#endif
+    std::atomic<bool> isExit{};
+    std::atomic<bool> hasChanges{};
+    std::mutex mutex;
+    Changes changes;
+};
+
+#endif // DIRWATCH_INCLUDED
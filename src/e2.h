@@ -109,5 +109,15 @@ const uint8_t MAX_DRIVES = 4; /* Max. number of supported disk drives */
 constexpr float ORIGINAL_FREQUENCY = 1.3396F;
 constexpr float ORIGINAL_PERIOD = (1.0F / ORIGINAL_FREQUENCY);
 
+/* The default maximum display refresh rate [Hz] */
+constexpr int DEFAULT_DISPLAY_REFRESH_RATE = 50;
+
+/* Consumers of video RAM changes. Each of them has its own changed flag */
+/* for each block of video RAM.                                          */
+enum class VideoRamConsumer : uint8_t {
+Display, /* Display video RAM on the screen */
+Capture, /* Capture video RAM into a file */
+};
+
 #endif
 
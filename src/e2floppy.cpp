@@ -24,12 +24,15 @@
 #include "misc1.h"
 #include "e2.h"
 #include "e2floppy.h"
+#include "bobshelp.h"
 #include "filecnts.h"
 #include "flexemu.h"
 #include "efiletim.h"
 #include "filecntb.h"
 #include "ffilecnt.h"
 #include "rfilecnt.h"
+#include "mfilecnt.h"
+#include "cfilecnt.h"
 #include "ndircont.h"
 #include "fcinfo.h"
 #include "flexerr.h"
@@ -59,6 +62,13 @@ E2floppy::E2floppy(const struct sOptions &p_options,
         track[i] = 1; // position all drives to track != 0 !!!
         drive_status[i] = DiskStatus::EMPTY;
     }
+
+    const auto cacheSize =
+        configFile->GetRuntimeSupportOption("diskSectorCache");
+    if (!cacheSize.empty())
+    {
+        sectorCacheSize = static_cast<std::size_t>(std::stoul(cacheSize));
+    }
 }
 
 E2floppy::~E2floppy()
@@ -169,22 +179,33 @@ bool E2floppy::mount_drive(const fs::path &path,
             const bool is_formatted = (fileSize > 0U);
             auto mode = std::ios::in | std::ios::out | std::ios::binary;
 
-            if (is_formatted && option == MOUNT_RAM)
+            if (is_formatted &&
+                (option == MOUNT_RAM || option == MOUNT_MAPPED))
             {
-                try
+                auto CreateDisk = [&](std::ios::openmode p_mode)
                 {
-                    pfloppy = IFlexDiskBySectorPtr(
-                     new FlexRamDisk(containerPath, mode,
+                    if (option == MOUNT_MAPPED)
+                    {
+                        return IFlexDiskBySectorPtr(
+                         new FlexMappedDisk(containerPath, p_mode,
+                                            options.fileTimeAccess));
+                    }
+
+                    return IFlexDiskBySectorPtr(
+                     new FlexRamDisk(containerPath, p_mode,
                                      options.fileTimeAccess));
+                };
+
+                try
+                {
+                    pfloppy = CreateDisk(mode);
                 }
                 catch (FlexException &)
                 {
                     try
                     {
                         mode &= ~std::ios::out;
-                        pfloppy = IFlexDiskBySectorPtr(
-                         new FlexRamDisk(containerPath, mode,
-                                         options.fileTimeAccess));
+                        pfloppy = CreateDisk(mode);
                     }
                     catch (FlexException &)
                     {
@@ -221,6 +242,13 @@ bool E2floppy::mount_drive(const fs::path &path,
                         }
                     }
                 }
+
+                if (pfloppy && is_formatted && sectorCacheSize != 0U)
+                {
+                    pfloppy = IFlexDiskBySectorPtr(
+                     new FlexCachedDisk(std::move(pfloppy),
+                                        sectorCacheSize));
+                }
             }
         }
 
@@ -447,6 +475,11 @@ bool E2floppy::sync_drive(Word drive_nr, tMountOption option)
         result = umount_drive(drive_nr);
         result &= mount_drive(path, drive_nr, option);
     }
+    else
+    {
+        std::lock_guard<std::mutex> guard(status_mutex);
+        result = floppy[drive_nr]->Sync();
+    }
 
     return result;
 }
@@ -469,12 +502,12 @@ void E2floppy::select_drive(Byte new_selected)
     }
 }
 
+// Byte transfers only access the sector buffer, they are executed
+// without locking.
 Byte E2floppy::readByte(Word index, Byte command_un)
 {
     if (pfs != nullptr)
     {
-        std::lock_guard<std::mutex> guard(status_mutex);
-
         switch (command_un)
         {
             case CMD_READSECTOR:
@@ -494,18 +527,7 @@ Byte E2floppy::readByte(Word index, Byte command_un)
 
 Byte E2floppy::readByteInSector(Word index)
 {
-    if (index == pfs->GetBytesPerSector())
-    {
-        drive_status[selected] = DiskStatus::ACTIVE;
-
-        if (!pfs->ReadSector(sector_buffer.data(), getTrack(), getSector(),
-                             getSide() ? 1 : 0))
-        {
-            setStatusReadError();
-        }
-    }
-
-    return sector_buffer[pfs->GetBytesPerSector() - index];
+    return (index <= sectorSize) ? sector_buffer[sectorSize - index] : 0U;
 }
 
 // Unfinished feature.
@@ -562,8 +584,6 @@ void E2floppy::writeByte(Word &index, Byte command_un)
 {
     if (pfs != nullptr)
     {
-        std::lock_guard<std::mutex> guard(status_mutex);
-
         switch (command_un)
         {
             case CMD_WRITESECTOR:
@@ -578,6 +598,41 @@ void E2floppy::writeByte(Word &index, Byte command_un)
     }
 }
 
+// A whole sector is read from the file container once when a read sector
+// transfer starts. The following byte reads are served from the sector
+// buffer. A written sector is stored when the last byte has been written.
+void E2floppy::startSectorTransfer(Byte command_un)
+{
+    if (pfs == nullptr)
+    {
+        return;
+    }
+
+    sectorSize = getBytesPerSector();
+
+    if (command_un != CMD_READSECTOR && command_un != CMD_READSECTOR_MULT)
+    {
+        return;
+    }
+
+    drive_status[selected] = DiskStatus::ACTIVE;
+    Notify(NotifyId::DiskActive);
+
+    bool isSuccess;
+
+    {
+        std::lock_guard<std::mutex> guard(status_mutex);
+        LatencyScope latencyScope(hostLatency);
+        isSuccess = pfs->ReadSector(sector_buffer.data(), getTrack(),
+                                    getSector(), getSide() ? 1 : 0);
+    }
+
+    if (!isSuccess)
+    {
+        setStatusReadError();
+    }
+}
+
 void E2floppy::writeByteInTrack(Word &index)
 {
     Word i;
@@ -588,6 +643,7 @@ void E2floppy::writeByteInTrack(Word &index)
     {
         case WriteTrackState::Inactive:
             drive_status[selected] = DiskStatus::ACTIVE;
+            Notify(NotifyId::DiskActive);
             writeTrackState = WriteTrackState::WaitForIdAddressMark;
             index = 256U;
             break;
@@ -625,6 +681,9 @@ void E2floppy::writeByteInTrack(Word &index)
             sector_buffer[i] = getDataRegister();
             if (--offset == 0U)
             {
+                std::lock_guard<std::mutex> guard(status_mutex);
+                LatencyScope latencyScope(hostLatency);
+
                 pfs->FormatSector(sector_buffer.data(),
                         idAddressMark[Id::Track],
                         idAddressMark[Id::Sector],
@@ -640,6 +699,7 @@ void E2floppy::writeByteInTrack(Word &index)
             if (getDataRegister() == TWO_CRCS)
             {
                 drive_status[selected] = DiskStatus::ACTIVE;
+                Notify(NotifyId::DiskActive);
                 writeTrackState = WriteTrackState::WaitForIdAddressMark;
                 index = 96U;
             }
@@ -649,14 +709,28 @@ void E2floppy::writeByteInTrack(Word &index)
 
 void E2floppy::writeByteInSector(Word index)
 {
-    sector_buffer[pfs->GetBytesPerSector() - index] = getDataRegister();
+    if (index > sectorSize)
+    {
+        return;
+    }
+
+    sector_buffer[sectorSize - index] = getDataRegister();
 
     if (index == 1)
     {
         drive_status[selected] = DiskStatus::ACTIVE;
+        Notify(NotifyId::DiskActive);
+
+        bool isSuccess;
 
-        if (!pfs->WriteSector(sector_buffer.data(), getTrack(), getSector(),
-                              getSide() ? 1 : 0))
+        {
+            std::lock_guard<std::mutex> guard(status_mutex);
+            LatencyScope latencyScope(hostLatency);
+            isSuccess = pfs->WriteSector(sector_buffer.data(), getTrack(),
+                                         getSector(), getSide() ? 1 : 0);
+        }
+
+        if (!isSuccess)
         {
             setStatusWriteError();
         }
@@ -664,6 +738,64 @@ void E2floppy::writeByteInSector(Word index)
 }
 
 
+std::optional<Byte> E2floppy::read_sector(Byte trk, Byte sec, Byte *buffer)
+{
+    if (pfs == nullptr || !pfs->IsFlexFormat() ||
+        pfs->GetBytesPerSector() != SECTOR_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    // The track and sector register contain the values as if the sector
+    // had been read by the controller.
+    setTrack(trk);
+    setSector(sec);
+    if (!pfs->IsSectorValid(trk, sec))
+    {
+        return static_cast<Byte>(STR_RECORDNOTFOUND);
+    }
+
+    drive_status[selected] = DiskStatus::ACTIVE;
+    Notify(NotifyId::DiskActive);
+
+    std::lock_guard<std::mutex> guard(status_mutex);
+    LatencyScope latencyScope(hostLatency);
+
+    return pfs->ReadSector(buffer, trk, sec) ?
+        Byte{0U} : static_cast<Byte>(STR_LOSTDATA);
+}
+
+std::optional<Byte> E2floppy::write_sector(Byte trk, Byte sec,
+                                           const Byte *buffer)
+{
+    if (pfs == nullptr || !pfs->IsFlexFormat() ||
+        pfs->GetBytesPerSector() != SECTOR_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    setTrack(trk);
+    setSector(sec);
+    if (pfs->IsWriteProtected())
+    {
+        return static_cast<Byte>(STR_PROTECTED);
+    }
+
+    if (!pfs->IsSectorValid(trk, sec))
+    {
+        return static_cast<Byte>(STR_RECORDNOTFOUND);
+    }
+
+    drive_status[selected] = DiskStatus::ACTIVE;
+    Notify(NotifyId::DiskActive);
+
+    std::lock_guard<std::mutex> guard(status_mutex);
+    LatencyScope latencyScope(hostLatency);
+
+    return pfs->WriteSector(buffer, trk, sec) ?
+        Byte{0U} : static_cast<Byte>(STR_LOSTDATA);
+}
+
 bool E2floppy::isRecordNotFound() const
 {
     if (pfs == nullptr)
@@ -699,17 +831,19 @@ bool E2floppy::isWriteProtect() const
     return pfs->IsWriteProtected();
 }
 
+// Executed without locking, an active drive is reset to inactive
+// unless it has been changed in the meantime.
 void E2floppy::get_drive_status(std::array<DiskStatus, MAX_DRIVES> &stat)
 {
-    std::lock_guard<std::mutex> guard(status_mutex);
-
     for (auto i = 0U; i < MAX_DRIVES; ++i)
     {
-        stat[i] = drive_status[i];
+        auto status = drive_status[i].load();
 
-        if (drive_status[i] != DiskStatus::EMPTY)
+        stat[i] = status;
+        if (status == DiskStatus::ACTIVE)
         {
-            drive_status[i] = DiskStatus::INACTIVE;
+            drive_status[i].compare_exchange_strong(status,
+                                                    DiskStatus::INACTIVE);
         }
     }
 }
@@ -31,16 +31,21 @@
 #include "e2.h"
 #include "fcinfo.h"
 #include "fcnffile.h"
+#include "bobservd.h"
+#include "iostat.h"
+#include <atomic>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <array>
+#include <cstddef>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
 struct sOptions;
 
-class E2floppy : public Wd1793
+class E2floppy : public Wd1793, public BObserved
 {
 private:
 
@@ -75,17 +80,22 @@ private:
     //  floppy          Pointers to all file containers (drive 4 deselects fdc)
     //  pfs             Pointer to currently selected file container
     //  track           Track number of all drives
-    //  drive_status    Status of all drives
-    //  sector_buffer   Current sector to read from or write to
+    //  drive_status    Status of all drives, polled by the GUI without
+    //                  locking
+    //  sector_buffer   Current sector to read from or write to. It is only
+    //                  accessed on the CPU thread
+    //  sectorSize      Bytes per sector of the current sector transfer
     //  disk_dir        Disk directory
     // Drive nr. 4 means no drive selected
 
     std::array<IFlexDiskBySectorPtr, MAX_DRIVES + 1U> floppy{};
     IFlexDiskBySector *pfs{};
     std::array<Byte, MAX_DRIVES + 1U> track{};
-    std::array<DiskStatus, MAX_DRIVES + 1U> drive_status{};
+    std::array<std::atomic<DiskStatus>, MAX_DRIVES + 1U> drive_status{};
     std::array<Byte, 1024>sector_buffer{};
+    Word sectorSize{};
     fs::path disk_dir;
+    // Protects the file containers against concurrent access.
     mutable std::mutex status_mutex;
     // data for CMD_WRITETRACK
     WriteTrackState writeTrackState{WriteTrackState::Inactive};
@@ -96,6 +106,10 @@ private:
 
     const struct sOptions &options;
     FlexemuConfigFileSPtr configFile;
+    // Number of sectors cached per disk image file, 0 = no cache.
+    std::size_t sectorCacheSize{};
+    // Host time needed to read, write or format a sector.
+    LatencyHistogram hostLatency;
 
 public:
     E2floppy(const struct sOptions &options,
@@ -115,6 +129,10 @@ public:
     {
         return "fdc";
     };
+    const LatencyHistogram *getHostLatency() override
+    {
+        return &hostLatency;
+    }
 
     virtual void get_drive_status(std::array<DiskStatus, MAX_DRIVES> &stat);
     virtual void disk_directory(const fs::path &p_disk_dir);
@@ -133,10 +151,19 @@ public:
     virtual std::string drive_attributes_string(Word drive_nr);
     virtual void select_drive(Byte new_selected);
     virtual IFlexDiskBySector const *get_drive(Word drive_nr) const;
+    // Read or write a sector of the selected drive at once, without
+    // emulating the byte transfer of the controller. Return std::nullopt
+    // if the selected drive has no FLEX compatible format, otherwise the
+    // controller status, 0 if successful.
+    virtual std::optional<Byte> read_sector(Byte trk, Byte sec,
+                                            Byte *buffer);
+    virtual std::optional<Byte> write_sector(Byte trk, Byte sec,
+                                             const Byte *buffer);
 
 private:
 
     bool startCommand(Byte command_un) override;
+    void startSectorTransfer(Byte command_un) override;
     Byte readByte(Word index, Byte command_un) override;
     Byte readByteInSector(Word index);
     Byte readByteInTrack(Word index);
@@ -41,9 +41,9 @@
 #include <QtGlobal>
 #include <QPainter>
 #include <QColor>
-#include <QPixmap>
 #include <QCursor>
-#include <QByteArray>
+#include <QImage>
+#include <QRegion>
 #include <QEvent>
 #include <QKeyEvent>
 #include <QPaintEvent>
@@ -57,9 +57,12 @@
 #include <QWidget>
 #include "warnon.h"
 #include <cassert>
+#include <cstring>
 #include <cstdint>
 #include <array>
+#include <algorithm>
 #include <string>
+#include <bitset>
 #if defined(UNIX) && !defined(X_DISPLAY_MISSING)
 #if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
 #include <QX11Info>
@@ -251,22 +254,22 @@ void E2Screen::paintEvent(QPaintEvent * /*event*/)
 {
     QPainter painter(this);
 
+    // The painter is clipped to the region to be repainted, so only the
+    // dirty rectangles are painted.
     painter.setRenderHint(QPainter::Antialiasing, false);
     painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
     painter.fillRect(QRect(0, 0, width() - 1, height() - 1), backgroundColor);
 
-    if (firstRasterLine != 0U)
+    if (screen.isNull() || scaledScreenSize.isEmpty())
     {
-        auto scaledFirstRasterLine = 0;
+        return;
+    }
 
-        if (doScaledScreenUpdate)
-        {
-            scaledScreen = screen.scaled(scaledScreenSize, Qt::KeepAspectRatio,
-                           transformationMode);
-            doScaledScreenUpdate = false;
-        }
-        scaledFirstRasterLine =
-            firstRasterLine * scaledScreenSize.height() / WINDOWHEIGHT;
+    UpdateScaledScreen();
+
+    if (firstRasterLine != 0U)
+    {
+        const auto scaledFirstRasterLine = GetScaledFirstRasterLine();
 
         // Paint first half display on the bottom of the screen
         auto origin1 =
@@ -274,24 +277,179 @@ void E2Screen::paintEvent(QPaintEvent * /*event*/)
                    scaledFirstRasterLine);
         auto rect1 = QRect(0, 0, scaledScreenSize.width() - 1,
                            scaledFirstRasterLine);
-        painter.drawPixmap(origin1, scaledScreen, rect1);
+        painter.drawImage(origin1, scaledScreen, rect1);
         // Paint second half display on the top of screen
         auto rect2 = QRect(0, scaledFirstRasterLine,
                            scaledScreenSize.width() - 1,
                            scaledScreenSize.height() - scaledFirstRasterLine);
-        painter.drawPixmap(origin, scaledScreen, rect2);
+        painter.drawImage(origin, scaledScreen, rect2);
     }
     else
     {
-        if (doScaledScreenUpdate)
+        painter.drawImage(origin, scaledScreen);
+    }
+}
+
+// Rescale all dirty blocks of the screen into the scaled screen.
+// If the scaled screen size or the transformation mode has changed
+// the whole screen is rescaled.
+void E2Screen::UpdateScaledScreen()
+{
+    if (doScaledScreenUpdate)
+    {
+        if (scaledScreen.size() != scaledScreenSize)
         {
-            scaledScreen = screen.scaled(scaledScreenSize, Qt::KeepAspectRatio,
-                           transformationMode);
-            doScaledScreenUpdate = false;
+            scaledScreen = QImage(scaledScreenSize, QImage::Format_RGB32);
+        }
+        dirtyBlocks.set();
+        doScaledScreenUpdate = false;
+    }
+
+    if (dirtyBlocks.none())
+    {
+        return;
+    }
+
+    const auto factor = GetIntegerScaleFactor();
+
+    for (int blockNumber = 0; blockNumber < YBLOCKS; ++blockNumber)
+    {
+        if (dirtyBlocks.test(static_cast<size_t>(blockNumber)))
+        {
+            if (factor.has_value())
+            {
+                ScaleBlockNearestNeighbour(blockNumber, factor.value());
+            }
+            else
+            {
+                ScaleBlock(blockNumber);
+            }
         }
+    }
+    dirtyBlocks.reset();
+}
 
-        painter.drawPixmap(origin, scaledScreen);
+// Return the scale factor if the screen is scaled by an integer factor
+// without smoothing. In this case the nearest neighbour fast path is used.
+std::optional<int> E2Screen::GetIntegerScaleFactor() const
+{
+    if (transformationMode == Qt::FastTransformation &&
+        scaledScreenSize.width() % WINDOWWIDTH == 0 &&
+        scaledScreenSize.height() ==
+        (scaledScreenSize.width() / WINDOWWIDTH) * WINDOWHEIGHT)
+    {
+        return scaledScreenSize.width() / WINDOWWIDTH;
     }
+
+    return std::nullopt;
+}
+
+// Get the rectangle of a block within the scaled screen.
+QRect E2Screen::GetScaledBlockRect(int blockNumber) const
+{
+    const auto y0 = (blockNumber * BLOCKHEIGHT * scaledScreenSize.height()) /
+                    WINDOWHEIGHT;
+    const auto y1 = ((blockNumber + 1) * BLOCKHEIGHT *
+                     scaledScreenSize.height()) / WINDOWHEIGHT;
+
+    return { 0, y0, scaledScreenSize.width(), y1 - y0 };
+}
+
+int E2Screen::GetScaledFirstRasterLine() const
+{
+    return firstRasterLine * scaledScreenSize.height() / WINDOWHEIGHT;
+}
+
+// Nearest neighbour scaling by an integer factor. Color lookup and
+// scaling is done in one pass, each source pixel is written factor times
+// horizontally, each scaled raster line is duplicated factor times.
+void E2Screen::ScaleBlockNearestNeighbour(int blockNumber, int factor)
+{
+    const auto colors = screen.colorTable();
+    const auto scaledWidth = static_cast<size_t>(scaledScreen.width());
+
+    for (int y = blockNumber * BLOCKHEIGHT;
+         y < (blockNumber + 1) * BLOCKHEIGHT; ++y)
+    {
+        const auto *src = screen.constScanLine(y);
+        auto *firstLine = scaledScreen.scanLine(y * factor);
+        auto *dst = reinterpret_cast<QRgb *>(firstLine);
+
+        for (int x = 0; x < WINDOWWIDTH; ++x)
+        {
+            const auto color = colors[src[x]];
+
+            for (int i = 0; i < factor; ++i)
+            {
+                *(dst++) = color;
+            }
+        }
+
+        for (int i = 1; i < factor; ++i)
+        {
+            std::memcpy(scaledScreen.scanLine((y * factor) + i), firstLine,
+                        scaledWidth * sizeof(QRgb));
+        }
+    }
+}
+
+// Generic scaling of one block, used for smooth or non integer scaling.
+// For smooth scaling one additional raster line above and below the
+// block is scaled too, so there are no visible seams between the blocks.
+void E2Screen::ScaleBlock(int blockNumber)
+{
+    const int margin =
+        (transformationMode == Qt::SmoothTransformation) ? 1 : 0;
+    const auto y0 = std::max(blockNumber * BLOCKHEIGHT - margin, 0);
+    const auto y1 = std::min((blockNumber + 1) * BLOCKHEIGHT + margin,
+                             static_cast<int>(WINDOWHEIGHT));
+    const auto scaledY0 = y0 * scaledScreenSize.height() / WINDOWHEIGHT;
+    const auto scaledY1 = y1 * scaledScreenSize.height() / WINDOWHEIGHT;
+    const auto targetRect = GetScaledBlockRect(blockNumber);
+
+    if (targetRect.isEmpty())
+    {
+        return;
+    }
+
+    const auto scaledPart = screen.copy(0, y0, WINDOWWIDTH, y1 - y0).scaled(
+            scaledScreenSize.width(), scaledY1 - scaledY0,
+            Qt::IgnoreAspectRatio, transformationMode);
+    QPainter painter(&scaledScreen);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(targetRect.topLeft(), scaledPart,
+                      targetRect.translated(0, -scaledY0));
+}
+
+// Map a rectangle of the scaled screen into widget coordinates.
+// The result may consist of two rectangles if the screen is split
+// at the first raster line.
+QRegion E2Screen::MapToWidget(const QRect &scaledRect) const
+{
+    const auto scaledFirstRasterLine = GetScaledFirstRasterLine();
+    const auto scaledWidth = scaledScreenSize.width();
+    const auto scaledHeight = scaledScreenSize.height();
+    QRegion region;
+
+    // Raster lines above the first raster line are painted at the bottom.
+    const auto upper = scaledRect.intersected(
+            QRect(0, 0, scaledWidth, scaledFirstRasterLine));
+    if (!upper.isEmpty())
+    {
+        region += upper.translated(origin.x(),
+                origin.y() + scaledHeight - scaledFirstRasterLine);
+    }
+
+    const auto lower = scaledRect.intersected(
+            QRect(0, scaledFirstRasterLine, scaledWidth,
+                  scaledHeight - scaledFirstRasterLine));
+    if (!lower.isEmpty())
+    {
+        region += lower.translated(origin.x(),
+                                   origin.y() - scaledFirstRasterLine);
+    }
+
+    return region;
 }
 
 void E2Screen::SetMouseCoordinatesAndButtons(QMouseEvent *event)
@@ -390,23 +548,72 @@ QString E2Screen::GetTitle()
            tr("Press CTRL F10 to release mouse");
 }
 
-void E2Screen::UpdateBlock(Byte p_firstRasterLine, int displayBlock,
-                           const QByteArray& bmpData)
+void E2Screen::UpdateBlocks(Byte p_firstRasterLine, const QImage &image,
+                            const std::bitset<YBLOCKS> &blocks)
 {
-    firstRasterLine = p_firstRasterLine;
-    QPixmap pixmap;
+    if (firstRasterLine != p_firstRasterLine)
+    {
+        firstRasterLine = p_firstRasterLine;
+        isFullRepaint = true;
+    }
 
-    assert(displayBlock >= 0 && displayBlock < YBLOCKS);
+    if (blocks.none())
+    {
+        return;
+    }
 
-    pixmap.loadFromData(bmpData, "BMP");;
-    QPainter painter(&screen);
-    painter.drawPixmap(QPoint(0, displayBlock * BLOCKHEIGHT), pixmap);
-    doScaledScreenUpdate = true;
+    if (screen.isNull())
+    {
+        screen = QImage(WINDOWWIDTH, WINDOWHEIGHT, QImage::Format_Indexed8);
+    }
+
+    if (screen.colorTable() != image.colorTable())
+    {
+        screen.setColorTable(image.colorTable());
+        doScaledScreenUpdate = true;
+    }
+
+    // Copy the changed blocks. Keeping a reference to image would
+    // force the video renderer to detach its buffer.
+    for (int displayBlock = 0; displayBlock < YBLOCKS; ++displayBlock)
+    {
+        if (blocks.test(static_cast<size_t>(displayBlock)))
+        {
+            for (int y = displayBlock * BLOCKHEIGHT;
+                 y < (displayBlock + 1) * BLOCKHEIGHT; ++y)
+            {
+                std::memcpy(screen.scanLine(y), image.constScanLine(y),
+                            WINDOWWIDTH);
+            }
+        }
+    }
+    dirtyBlocks |= blocks;
 }
 
+// Repaint the screen. If possible only the dirty blocks are repainted.
 void E2Screen::RepaintScreen()
 {
-    repaint();
+    if (isFullRepaint || doScaledScreenUpdate)
+    {
+        isFullRepaint = false;
+        repaint();
+        return;
+    }
+
+    QRegion region;
+
+    for (int blockNumber = 0; blockNumber < YBLOCKS; ++blockNumber)
+    {
+        if (dirtyBlocks.test(static_cast<size_t>(blockNumber)))
+        {
+            region += MapToWidget(GetScaledBlockRect(blockNumber));
+        }
+    }
+
+    if (!region.isEmpty())
+    {
+        repaint(region);
+    }
 }
 
 void E2Screen::UpdateMouse()
@@ -30,18 +30,19 @@
 #include <QtGlobal>
 #include <QVector>
 #include <QRect>
+#include <QRegion>
 #include <QSize>
 #include <QRgb>
 #include <QWidget>
-#include <QPixmap>
+#include <QImage>
 #include "warnon.h"
 #include "blinxsys.h" // After qt include to avoid automoc issue
 #include "soptions.h" // After qt include to avoid automoc issue
 #include <optional>
+#include <bitset>
 
 class VideoControl2;
 class QPaintEvent;
-class QByteArray;
 class QEvent;
 class QResizeEvent;
 class QMouseEvent;
@@ -73,8 +74,8 @@ public:
              const QColor &p_backgroundColor, QWidget *parent = nullptr);
 
     QSize GetScaledSize() const;
-    void UpdateBlock(Byte firstRasterLine, int displayBlock,
-                     const QByteArray& data);
+    void UpdateBlocks(Byte firstRasterLine, const QImage &image,
+                      const std::bitset<YBLOCKS> &blocks);
     void RepaintScreen();
     void UpdateMouse();
     int GetPixelSizeX() const;
@@ -121,14 +122,22 @@ private:
     void SetCursorPosition(int x, int y);
     void InitializeNumLockIndicatorMask();
     bool IsNumLockOn() const;
+    void UpdateScaledScreen();
+    std::optional<int> GetIntegerScaleFactor() const;
+    QRect GetScaledBlockRect(int blockNumber) const;
+    int GetScaledFirstRasterLine() const;
+    void ScaleBlockNearestNeighbour(int blockNumber, int factor);
+    void ScaleBlock(int blockNumber);
+    QRegion MapToWidget(const QRect &scaledRect) const;
 
     Scheduler &scheduler;
     JoystickIO &joystickIO;
     KeyboardIO &keyboardIO;
     Pia1 &pia1;
     QColor backgroundColor;
-    QPixmap screen{QPixmap(WINDOWWIDTH, WINDOWHEIGHT)};
-    QPixmap scaledScreen;
+    QImage screen; // Indexed 8-bit copy of the video renderer frame
+    QImage scaledScreen;
+    std::bitset<YBLOCKS> dirtyBlocks; // Blocks to be rescaled and repainted
     Qt::TransformationMode transformationMode{Qt::FastTransformation};
     Byte firstRasterLine{0};
     std::optional<int> mouseX;
@@ -143,6 +152,7 @@ private:
     int pixelSize;
     CursorType cursorType{CursorType::Default};
     bool doScaledScreenUpdate{true};
+    bool isFullRepaint{true};
     QSize preferredScreenSize;
     QSize scaledScreenSize;
     QPoint origin;
@@ -28,6 +28,7 @@
 #include "filecntb.h"
 #include "free.h"
 #include <ios>
+#include <algorithm>
 #include <utility>
 #include <optional>
 #include <string>
@@ -73,6 +74,7 @@ FlexemuConfigFile::FlexemuConfigFile(fs::path p_path) :
     InitializeIoDeviceLogging();
     InitializeSerparAddresses();
     InitializeBootCharacters();
+    InitializeDiskDriverEntryPoints();
     InitializeBootSectorFileProperties();
 }
 
@@ -245,6 +247,14 @@ void FlexemuConfigFile::InitializeRuntimeSupportOptions()
     static const auto validKeys = std::set<std::string>{
         "presetRAMPattern",
         "useHostTimerSpinLock",
+        "maxDisplayRefreshRate",
+        "syncDisplayRefresh",
+        "idleLoopDetection",
+        "rtcEmulatedTime",
+        "frequencyPacingSlice",
+        "turboOnDemand",
+        "diskSectorCache",
+        "diskDriverHLE",
     };
     static const auto validRamPatterns = std::set<std::string>{
         "all_zero",
@@ -253,9 +263,65 @@ void FlexemuConfigFile::InitializeRuntimeSupportOptions()
         "random10", "random20", "random30", "random40", "random50",
         "random60", "random70", "random80", "random90",
     };
-    static const auto validSpinLockStrings = std::set<std::string>{
+    static const auto validFlagStrings = std::set<std::string>{
         "0", "1",
     };
+    // Valid display refresh rates are 1 ... 240 Hz.
+    const auto isValidRefreshRate = [](const std::string &value){
+        if (value.empty() || value.size() > 3U ||
+            !std::all_of(value.cbegin(), value.cend(), [](char ch){
+                return ch >= '0' && ch <= '9';
+            }))
+        {
+            return false;
+        }
+
+        const auto rate = std::stoi(value);
+
+        return rate >= 1 && rate <= 240;
+    };
+    // Valid pacing slice times are 0 (off) or 100 ... 10000 us.
+    const auto isValidPacingSlice = [](const std::string &value){
+        if (value.empty() || value.size() > 5U ||
+            !std::all_of(value.cbegin(), value.cend(), [](char ch){
+                return ch >= '0' && ch <= '9';
+            }))
+        {
+            return false;
+        }
+
+        const auto slice = std::stoi(value);
+
+        return slice == 0 || (slice >= 100 && slice <= 10000);
+    };
+    // Valid turbo quiet times are 0 (off) or 10 ... 60000 ms.
+    const auto isValidTurboQuietTime = [](const std::string &value){
+        if (value.empty() || value.size() > 5U ||
+            !std::all_of(value.cbegin(), value.cend(), [](char ch){
+                return ch >= '0' && ch <= '9';
+            }))
+        {
+            return false;
+        }
+
+        const auto quietTime = std::stoi(value);
+
+        return quietTime == 0 || (quietTime >= 10 && quietTime <= 60000);
+    };
+    // Valid disk sector cache sizes are 0 (off) or 16 ... 16384 sectors.
+    const auto isValidSectorCacheSize = [](const std::string &value){
+        if (value.empty() || value.size() > 5U ||
+            !std::all_of(value.cbegin(), value.cend(), [](char ch){
+                return ch >= '0' && ch <= '9';
+            }))
+        {
+            return false;
+        }
+
+        const auto sectors = std::stoi(value);
+
+        return sectors == 0 || (sectors >= 16 && sectors <= 16384);
+    };
 
     BIniFile iniFile(path);
     const std::string section{"RuntimeSupport"};
@@ -268,8 +334,28 @@ void FlexemuConfigFile::InitializeRuntimeSupportOptions()
             (iter.first == "presetRAMPattern" &&
              validRamPatterns.find(iter.second) == validRamPatterns.cend()) ||
             (iter.first == "useHostTimerSpinLock" &&
-             validSpinLockStrings.find(iter.second) ==
-             validSpinLockStrings.cend()))
+             validFlagStrings.find(iter.second) ==
+             validFlagStrings.cend()) ||
+            (iter.first == "maxDisplayRefreshRate" &&
+             !isValidRefreshRate(iter.second)) ||
+            (iter.first == "syncDisplayRefresh" &&
+             validFlagStrings.find(iter.second) ==
+             validFlagStrings.cend()) ||
+            (iter.first == "idleLoopDetection" &&
+             validFlagStrings.find(iter.second) ==
+             validFlagStrings.cend()) ||
+            (iter.first == "rtcEmulatedTime" &&
+             validFlagStrings.find(iter.second) ==
+             validFlagStrings.cend()) ||
+            (iter.first == "frequencyPacingSlice" &&
+             !isValidPacingSlice(iter.second)) ||
+            (iter.first == "turboOnDemand" &&
+             !isValidTurboQuietTime(iter.second)) ||
+            (iter.first == "diskSectorCache" &&
+             !isValidSectorCacheSize(iter.second)) ||
+            (iter.first == "diskDriverHLE" &&
+             validFlagStrings.find(iter.second) ==
+             validFlagStrings.cend()))
         {
             const auto lineNumber = iniFile.GetLineNumber(section, iter.first);
             throw FlexException(FERR_INVALID_LINE_IN_FILE,
@@ -285,6 +371,12 @@ void FlexemuConfigFile::InitializeRuntimeSupportOptions()
     {
         runtimeSupportOptionForKey.emplace("presetRAMPattern", "random20");
         runtimeSupportOptionForKey.emplace("useHostTimerSpinLock", "0");
+        runtimeSupportOptionForKey.emplace("maxDisplayRefreshRate", "50");
+        runtimeSupportOptionForKey.emplace("syncDisplayRefresh", "0");
+        runtimeSupportOptionForKey.emplace("idleLoopDetection", "1");
+        runtimeSupportOptionForKey.emplace("rtcEmulatedTime", "0");
+        runtimeSupportOptionForKey.emplace("frequencyPacingSlice", "0");
+        runtimeSupportOptionForKey.emplace("turboOnDemand", "0");
     }
 }
 
@@ -294,6 +386,11 @@ std::pair<std::string, std::set<std::string> >
     return ioDeviceLogging;
 }
 
+sIoDeviceLogFilter FlexemuConfigFile::GetIoDeviceLogFilter() const
+{
+    return ioDeviceLogFilter;
+}
+
 void FlexemuConfigFile::InitializeIoDeviceLogging()
 {
     std::string logFilePath;
@@ -333,6 +430,51 @@ void FlexemuConfigFile::InitializeIoDeviceLogging()
         {
             logFilePath = iter.second;
         }
+        else if (iter.first == "modes" || iter.first == "offsets")
+        {
+            const bool isModes = (iter.first == "modes");
+            std::stringstream stream(iter.second);
+            std::string item;
+            bool isValid = true;
+
+            if (isModes)
+            {
+                ioDeviceLogFilter.isLogRead = false;
+                ioDeviceLogFilter.isLogWrite = false;
+            }
+
+            while (isValid && std::getline(stream, item, ','))
+            {
+                item = flx::trim(std::move(item));
+                Word offset{};
+
+                if (isModes && item == "read")
+                {
+                    ioDeviceLogFilter.isLogRead = true;
+                }
+                else if (isModes && item == "write")
+                {
+                    ioDeviceLogFilter.isLogWrite = true;
+                }
+                else if (!isModes && flx::convert(item, offset))
+                {
+                    ioDeviceLogFilter.offsets.emplace(offset);
+                }
+                else
+                {
+                    isValid = false;
+                }
+            }
+
+            if (!isValid)
+            {
+                const auto lineNumber =
+                    iniFile.GetLineNumber(section, iter.first);
+                throw FlexException(FERR_INVALID_LINE_IN_FILE,
+                                    lineNumber, iter.first + "=" + iter.second,
+                                    iniFile.GetPath());
+            }
+        }
         else
         {
             const auto lineNumber = iniFile.GetLineNumber(section, iter.first);
@@ -408,6 +550,77 @@ void FlexemuConfigFile::InitializeBootCharacters()
     }
 }
 
+std::optional<sDiskDriverEntryPoints>
+    FlexemuConfigFile::GetDiskDriverEntryPoints(
+        const fs::path &monitorFilePath) const
+{
+    auto filename = monitorFilePath.filename().u8string();
+
+#ifdef _WIN32
+    flx::strlower(filename);
+#endif
+
+    const auto iter = diskDriverEntryPointsForMonitorFile.find(filename);
+
+    return (iter == diskDriverEntryPointsForMonitorFile.cend()) ?
+        std::nullopt : std::optional<sDiskDriverEntryPoints>(iter->second);
+}
+
+// Format: <read_address_hex>,<write_address_hex>[,<cycles>]
+void FlexemuConfigFile::InitializeDiskDriverEntryPoints()
+{
+    BIniFile iniFile(path);
+    const std::string section{"DiskDriverHLE"};
+
+    const auto valueForKey = iniFile.ReadSection(section);
+
+    for (const auto &iter : valueForKey)
+    {
+        auto key = iter.first;
+        std::stringstream stream(iter.second);
+        std::string readString;
+        std::string writeString;
+        std::string cyclesString;
+        std::size_t readAddress{};
+        std::size_t writeAddress{};
+        std::size_t cycles{};
+
+#ifdef _WIN32
+        flx::strlower(key);
+#endif
+
+        if (std::getline(stream, readString, ',') &&
+            std::getline(stream, writeString, ',') &&
+            flx::convert(readString, readAddress, 16) &&
+            readAddress <= 0xFFFF &&
+            flx::convert(writeString, writeAddress, 16) &&
+            writeAddress <= 0xFFFF && readAddress != writeAddress)
+        {
+            sDiskDriverEntryPoints entryPoints{
+                static_cast<Word>(readAddress),
+                static_cast<Word>(writeAddress), std::nullopt };
+
+            if (!std::getline(stream, cyclesString))
+            {
+                diskDriverEntryPointsForMonitorFile.emplace(key, entryPoints);
+                continue;
+            }
+
+            if (flx::convert(cyclesString, cycles) && cycles <= 100000U)
+            {
+                entryPoints.cycles = static_cast<DWord>(cycles);
+                diskDriverEntryPointsForMonitorFile.emplace(key, entryPoints);
+                continue;
+            }
+        }
+
+        const auto lineNumber = iniFile.GetLineNumber(section, iter.first);
+        throw FlexException(FERR_INVALID_LINE_IN_FILE,
+                            lineNumber, iter.first + "=" + iter.second,
+                            iniFile.GetPath());
+    }
+}
+
 BootSectorFileProperties_t FlexemuConfigFile::GetBootSectorFileProperties()
     const
 {
@@ -42,6 +42,16 @@ struct sIoDeviceMapping
     std::optional<Word> byteSize;
 };
 
+// Filter applied to I/O device logging before an access is recorded.
+struct sIoDeviceLogFilter
+{
+    bool isLogRead{true};
+    bool isLogWrite{true};
+    // Logged offsets relative to the device base address.
+    // If empty any offset is logged.
+    std::set<Word> offsets;
+};
+
 struct sBootSectorFileProperties
 {
     std::string bootSectorFile;
@@ -50,6 +60,16 @@ struct sBootSectorFileProperties
 
 using BootSectorFileProperties_t = std::vector<sBootSectorFileProperties>;
 
+// Entry points of the FLEX disk driver READ and WRITE routines which are
+// executed by a high-level emulation.
+struct sDiskDriverEntryPoints
+{
+    Word readAddress{};
+    Word writeAddress{};
+    // CPU cycles charged for one call, if not set the cycles of a RTS.
+    std::optional<DWord> cycles;
+};
+
 class FlexemuConfigFile
 {
 public:
@@ -68,8 +88,11 @@ public:
     std::string GetDebugSupportOption(const std::string &key) const;
     std::string GetRuntimeSupportOption(const std::string &key) const;
     std::pair<std::string, std::set<std::string> > GetIoDeviceLogging() const;
+    sIoDeviceLogFilter GetIoDeviceLogFilter() const;
     std::optional<Word> GetSerparAddress(const fs::path &monitorFilePath) const;
     std::optional<Byte> GetBootCharacter(const fs::path &monitorFilePath) const;
+    std::optional<sDiskDriverEntryPoints> GetDiskDriverEntryPoints(
+            const fs::path &monitorFilePath) const;
     BootSectorFileProperties_t GetBootSectorFileProperties() const;
 
 protected:
@@ -79,6 +102,7 @@ protected:
     void InitializeIoDeviceLogging();
     void InitializeSerparAddresses();
     void InitializeBootCharacters();
+    void InitializeDiskDriverEntryPoints();
     void InitializeBootSectorFileProperties();
 
 private:
@@ -87,8 +111,11 @@ private:
     std::map<std::string, std::string> debugSupportOptionForKey;
     std::map<std::string, std::string> runtimeSupportOptionForKey;
     std::pair<std::string, std::set<std::string> > ioDeviceLogging;
+    sIoDeviceLogFilter ioDeviceLogFilter;
     std::map<std::string, Word> serparAddressForMonitorFile;
     std::map<std::string, Byte> bootCharacterForMonitorFile;
+    std::map<std::string, sDiskDriverEntryPoints>
+        diskDriverEntryPointsForMonitorFile;
     BootSectorFileProperties_t bootSectorFileProperties;
 };
 
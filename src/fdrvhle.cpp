@@ -0,0 +1,111 @@
+/*
+    fdrvhle.cpp  High-level emulation of the FLEX disk driver.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "fdrvhle.h"
+#include "mc6809.h"
+#include "mc6809st.h"
+#include "memory.h"
+#include "e2floppy.h"
+#include <optional>
+
+
+FlexDiskDriverHle::FlexDiskDriverHle(Mc6809 &p_cpu, Memory &p_memory,
+                                     E2floppy &p_fdc)
+    : cpu(p_cpu)
+    , memory(p_memory)
+    , fdc(p_fdc)
+{
+}
+
+void FlexDiskDriverHle::Install(const sDiskDriverEntryPoints &entryPoints)
+{
+    cycles = entryPoints.cycles.has_value() ?
+        static_cast<cycles_t>(entryPoints.cycles.value()) : DEFAULT_CYCLES;
+
+    cpu.set_trap(entryPoints.readAddress, [this](Mc6809CpuStatus &regs){
+        return Read(regs);
+    });
+    cpu.set_trap(entryPoints.writeAddress, [this](Mc6809CpuStatus &regs){
+        return Write(regs);
+    });
+}
+
+// Read sector B on track A into memory at address X.
+std::optional<cycles_t> FlexDiskDriverHle::Read(Mc6809CpuStatus &regs)
+{
+    const auto status = fdc.read_sector(regs.a, regs.b, buffer.data());
+
+    if (!status.has_value())
+    {
+        return std::nullopt;
+    }
+
+    if (status.value() == 0U)
+    {
+        for (const auto value : buffer)
+        {
+            memory.write_byte(regs.x++, value);
+        }
+    }
+
+    return Return(regs, status.value());
+}
+
+// Write memory at address X into sector B on track A.
+std::optional<cycles_t> FlexDiskDriverHle::Write(Mc6809CpuStatus &regs)
+{
+    auto address = regs.x;
+
+    for (auto &value : buffer)
+    {
+        value = memory.read_byte(address++);
+    }
+
+    const auto status = fdc.write_sector(regs.a, regs.b, buffer.data());
+
+    if (!status.has_value())
+    {
+        return std::nullopt;
+    }
+
+    if (status.value() == 0U)
+    {
+        regs.x = address;
+    }
+
+    return Return(regs, status.value());
+}
+
+// Set the result registers and return to the caller (RTS).
+cycles_t FlexDiskDriverHle::Return(Mc6809CpuStatus &regs, Byte status)
+{
+    regs.b = status;
+    regs.cc &= static_cast<Byte>(~CC_BITS_NZV);
+    regs.cc |= static_cast<Byte>((status == 0U) ? CC_BIT_Z : 0U);
+    regs.cc |= static_cast<Byte>((status & 0x80U) ? CC_BIT_N : 0U);
+    regs.pc = memory.read_word(regs.s);
+    regs.s += 2U;
+
+    return cycles;
+}
@@ -0,0 +1,77 @@
+/*
+    fdrvhle.h  High-level emulation of the FLEX disk driver.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef FDRVHLE_INCLUDED
+#define FDRVHLE_INCLUDED
+
+#include "typedefs.h"
+#include "filecnts.h"
+#include "fcnffile.h"
+#include <optional>
+
+
+class Mc6809;
+class Memory;
+class E2floppy;
+struct Mc6809CpuStatus;
+
+// class FlexDiskDriverHle is a high-level emulation of the READ and WRITE
+// routine of the FLEX disk driver. When the CPU reaches the entry point of
+// one of these routines the whole sector is transferred between the
+// selected drive and memory at once instead of polling the floppy disk
+// controller byte by byte. Afterwards the CPU returns to the caller with
+// the registers set as the routine would do:
+//     B:   Error status (0 = no error)
+//     CC:  Z flag set if no error
+//     X:   Points behind the sector in memory
+// If the selected drive has no FLEX compatible format the routine of the
+// guest is executed.
+class FlexDiskDriverHle
+{
+public:
+    // Cycles of a RTS instruction.
+    static constexpr cycles_t DEFAULT_CYCLES = 5U;
+
+    FlexDiskDriverHle() = delete;
+    FlexDiskDriverHle(Mc6809 &p_cpu, Memory &p_memory, E2floppy &p_fdc);
+    ~FlexDiskDriverHle() = default;
+    FlexDiskDriverHle(const FlexDiskDriverHle &src) = delete;
+    FlexDiskDriverHle(FlexDiskDriverHle &&src) = delete;
+    FlexDiskDriverHle &operator=(const FlexDiskDriverHle &src) = delete;
+    FlexDiskDriverHle &operator=(FlexDiskDriverHle &&src) = delete;
+
+    // Has to be called while the CPU thread is not running.
+    void Install(const sDiskDriverEntryPoints &entryPoints);
+
+private:
+    std::optional<cycles_t> Read(Mc6809CpuStatus &regs);
+    std::optional<cycles_t> Write(Mc6809CpuStatus &regs);
+    cycles_t Return(Mc6809CpuStatus &regs, Byte status);
+
+    Mc6809 &cpu;
+    Memory &memory;
+    E2floppy &fdc;
+    cycles_t cycles{DEFAULT_CYCLES};
+    SectorBuffer_t buffer{};
+};
+
+#endif
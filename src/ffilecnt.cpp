@@ -260,6 +260,19 @@ unsigned FlexDisk::GetBytesPerSector() const
     return param.byte_p_sector;
 }
 
+// Write back all changes and wait until finished.
+bool FlexDisk::Sync()
+{
+    if (!fstream.is_open())
+    {
+        return false;
+    }
+
+    fstream.flush();
+    // A write protected disk has no changes to write back.
+    return !fstream.fail() && (IsWriteProtected() || flx::syncFile(path));
+}
+
 bool FlexDisk::IsWriteProtected() const
 {
     return (attributes & WRITE_PROTECT) != 0;
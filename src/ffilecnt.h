@@ -136,6 +136,7 @@ public:
     bool IsTrackValid(int track) const override;
     bool IsSectorValid(int track, int sector) const override;
     unsigned GetBytesPerSector() const override;
+    bool Sync() override;
 
     // IFlexDiskByFile interface declaration (to be used within flexplorer).
     IFlexDiskByFile *begin() override
@@ -0,0 +1,265 @@
+/*
+    fhcache.cpp  LRU cache of open host files.
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "fhcache.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <cassert>
+#include <optional>
+#include <iterator>
+#include <utility>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+FileHandleCache::FileHandleCache(std::size_t p_maxHandles,
+                                 OnClose_t p_onClose)
+    : maxHandles(p_maxHandles)
+    , onClose(std::move(p_onClose))
+{
+    assert(maxHandles != 0U);
+}
+
+FileHandleCache::~FileHandleCache()
+{
+    CloseAll();
+}
+
+std::optional<std::size_t> FileHandleCache::Read(SDWord id,
+        const fs::path &path, Byte *buffer, std::size_t size,
+        std::uint64_t offset)
+{
+    const auto *handle = Open(id, path, false);
+
+    if (handle == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    std::size_t count = 0U;
+
+    // Continue on partial reads until end of file.
+    while (count < size)
+    {
+#ifdef _WIN32
+        OVERLAPPED overlapped{};
+        const auto position = offset + count;
+        DWORD bytes = 0U;
+
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFFU);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32U);
+        if (!ReadFile(handle->handle, buffer + count,
+                      static_cast<DWORD>(size - count), &bytes, &overlapped))
+        {
+            if (GetLastError() == ERROR_HANDLE_EOF)
+            {
+                break;
+            }
+
+            return std::nullopt;
+        }
+#else
+        const auto bytes = pread(handle->fd, buffer + count, size - count,
+                                 static_cast<off_t>(offset + count));
+
+        if (bytes < 0)
+        {
+            return std::nullopt;
+        }
+#endif
+        if (bytes == 0)
+        {
+            break;
+        }
+
+        count += static_cast<std::size_t>(bytes);
+    }
+
+    return count;
+}
+
+bool FileHandleCache::Write(SDWord id, const fs::path &path,
+        const Byte *buffer, std::size_t size, std::uint64_t offset)
+{
+    auto *handle = Open(id, path, true);
+
+    if (handle == nullptr)
+    {
+        return false;
+    }
+
+    handle->isWritten = true;
+
+    std::size_t count = 0U;
+
+    while (count < size)
+    {
+#ifdef _WIN32
+        OVERLAPPED overlapped{};
+        const auto position = offset + count;
+        DWORD bytes = 0U;
+
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFFU);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32U);
+        if (!WriteFile(handle->handle, buffer + count,
+                       static_cast<DWORD>(size - count), &bytes, &overlapped))
+        {
+            return false;
+        }
+#else
+        const auto bytes = pwrite(handle->fd, buffer + count, size - count,
+                                  static_cast<off_t>(offset + count));
+
+        if (bytes < 0)
+        {
+            return false;
+        }
+#endif
+        if (bytes == 0)
+        {
+            return false;
+        }
+
+        count += static_cast<std::size_t>(bytes);
+    }
+
+    return true;
+}
+
+void FileHandleCache::Close(SDWord id)
+{
+    const auto iter = handleForId.find(id);
+
+    if (iter != handleForId.end())
+    {
+        Close(iter->second);
+    }
+}
+
+void FileHandleCache::CloseAll()
+{
+    while (!handles.empty())
+    {
+        Close(handles.begin());
+    }
+}
+
+std::size_t FileHandleCache::GetOpenCount() const
+{
+    return handles.size();
+}
+
+// Return the handle of an open file. If needed open it. If isWrite is
+// true the file is opened for read and write. Otherwise the file is
+// opened for read and write if possible, if not read-only.
+FileHandleCache::Handle *FileHandleCache::Open(SDWord id,
+        const fs::path &path, bool isWrite)
+{
+    const auto iter = handleForId.find(id);
+
+    if (iter != handleForId.end())
+    {
+        auto &handle = *iter->second;
+
+        if (handle.path == path && (!isWrite || handle.isWritable))
+        {
+            // Move the file to the front, it is the most recently used one.
+            handles.splice(handles.begin(), handles, iter->second);
+
+            return &handles.front();
+        }
+
+        Close(iter->second);
+    }
+
+    Handle handle{id, path,
+#ifdef _WIN32
+        INVALID_HANDLE_VALUE,
+#else
+        -1,
+#endif
+        true, false};
+
+#ifdef _WIN32
+    const auto sharing = FILE_SHARE_READ | FILE_SHARE_WRITE;
+
+    handle.handle = CreateFileW(path.wstring().c_str(),
+        GENERIC_READ | GENERIC_WRITE, sharing, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle.handle == INVALID_HANDLE_VALUE && !isWrite)
+    {
+        handle.isWritable = false;
+        handle.handle = CreateFileW(path.wstring().c_str(), GENERIC_READ,
+            sharing, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    }
+    if (handle.handle == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+#else
+    handle.fd = open(path.c_str(), O_RDWR);
+    if (handle.fd < 0 && !isWrite)
+    {
+        handle.isWritable = false;
+        handle.fd = open(path.c_str(), O_RDONLY);
+    }
+    if (handle.fd < 0)
+    {
+        return nullptr;
+    }
+#endif
+
+    if (handles.size() >= maxHandles)
+    {
+        Close(std::prev(handles.end()));
+    }
+
+    handles.push_front(std::move(handle));
+    handleForId[id] = handles.begin();
+
+    return &handles.front();
+}
+
+void FileHandleCache::Close(HandleList_t::iterator iter)
+{
+    const auto id = iter->id;
+    const auto path = std::move(iter->path);
+    const auto isWritten = iter->isWritten;
+
+#ifdef _WIN32
+    CloseHandle(iter->handle);
+#else
+    close(iter->fd);
+#endif
+    handleForId.erase(id);
+    handles.erase(iter);
+
+    if (onClose)
+    {
+        onClose(id, path, isWritten);
+    }
+}
@@ -0,0 +1,103 @@
+/*
+    fhcache.h  LRU cache of open host files.
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef FHCACHE_INCLUDED
+#define FHCACHE_INCLUDED
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "typedefs.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// class FileHandleCache keeps up to maxHandles host files open, each of
+// them identified by a unique id. If more files are needed the least
+// recently used one is closed.
+// Reading and writing uses positioned I/O without any user space buffer,
+// so written data is immediately visible to other readers of the file.
+// The owner has to close a file before it is renamed, deleted or its
+// permissions are changed.
+// The onClose callback is called after a file has been closed. It can
+// be used to set back the file time once per file instead of once per
+// write access.
+class FileHandleCache
+{
+    struct Handle
+    {
+        SDWord id;
+        fs::path path;
+#ifdef _WIN32
+        HANDLE handle;
+#else
+        int fd;
+#endif
+        bool isWritable;
+        bool isWritten;
+    };
+    using HandleList_t = std::list<Handle>;
+
+public:
+    using OnClose_t =
+        std::function<void(SDWord id, const fs::path &path, bool isWritten)>;
+
+    FileHandleCache() = delete;
+    FileHandleCache(std::size_t p_maxHandles, OnClose_t p_onClose);
+    ~FileHandleCache();
+    FileHandleCache(const FileHandleCache &src) = delete;
+    FileHandleCache(FileHandleCache &&src) = delete;
+    FileHandleCache &operator= (const FileHandleCache &src) = delete;
+    FileHandleCache &operator= (FileHandleCache &&src) = delete;
+
+    // Read up to size bytes at offset. Return the number of bytes read,
+    // it is less than size at end of file. Return std::nullopt if the
+    // file can not be opened or read.
+    std::optional<std::size_t> Read(SDWord id, const fs::path &path,
+            Byte *buffer, std::size_t size, std::uint64_t offset);
+    // Write size bytes at offset. A file which does not exist is never
+    // created.
+    bool Write(SDWord id, const fs::path &path, const Byte *buffer,
+            std::size_t size, std::uint64_t offset);
+    void Close(SDWord id);
+    void CloseAll();
+    std::size_t GetOpenCount() const;
+
+private:
+    Handle *Open(SDWord id, const fs::path &path, bool isWrite);
+    void Close(HandleList_t::iterator iter);
+
+    std::size_t maxHandles;
+    OnClose_t onClose;
+    // Most recently used files are at the front.
+    HandleList_t handles;
+    std::unordered_map<SDWord, HandleList_t::iterator> handleForId;
+};
+
+#endif // FHCACHE_INCLUDED
@@ -70,6 +70,8 @@ enum class DiskOptions : uint8_t
     JvcHeader = 1, // A *.dsk (or *.wta) disk image file with a JVC header.
     HasSectorIF = 2, // Has a sector oriented interface.
     RAM = 4, // a disk image file fully loaded in RAM.
+    Mapped = 8, // a disk image file mapped into memory.
+    Cached = 16, // sectors are cached in RAM and written back later.
 };
 
 // This interface gives basic properties access to a FLEX disk image.
@@ -43,7 +43,8 @@ const Word MAX_JVC_HEADERSIZE = 5U;
 enum tMountOption : uint8_t
 {
     MOUNT_DEFAULT = 0,
-    MOUNT_RAM = 1
+    MOUNT_RAM = 1,
+    MOUNT_MAPPED = 2
 };
 
 /* POD structs are needed to read/write from disk image files */
@@ -196,6 +197,9 @@ public:
     virtual bool IsTrackValid(int track) const = 0;
     virtual bool IsSectorValid(int track, int sector) const = 0;
     virtual unsigned GetBytesPerSector() const = 0;
+    // Write back all pending changes into the disk image.
+    // Return false on failure.
+    virtual bool Sync() = 0;
 
     ~IFlexDiskBySector() override = default;
 };
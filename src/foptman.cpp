@@ -126,12 +126,16 @@ void FlexemuOptions::PrintHelp(std::ostream &os)
           "  -F <frequency> (set CPU frequency in MHz)\n"
           "     0.0 sets maximum frequency, -1.0 sets original frequency.\n"
           "  -C <startup command>\n"
+          "  -K <file_path> Type the contents of a text file as keyboard "
+          "input.\n"
+          "     It is typed after the startup command.\n"
 #ifdef UNIX
           "  -t (terminal only mode)\n"
 #ifdef HAVE_TERMIOS_H
           "  -r <two-hex-digit reset key>\n"
 #endif
-          "  -T <terminal_type> ('scroll' or 'curses')\n"
+          "  -T <terminal_type> ('scroll', 'curses', 'pty', 'tcp:<port>' or\n"
+          "     'unix:<path>')\n"
 #endif
           "  -c <color> define foreground color\n"
           "  -i (display inverse video)\n"
@@ -144,6 +148,11 @@ void FlexemuOptions::PrintHelp(std::ostream &os)
           "  -L <file_path> Enable CPU instruction logging.\n"
           "     File extension: *.log or *.txt logs to a text file; "
           "*.csv logs to a csv file.\n"
+          "  -S <file_path> Capture the screen into a file on exit.\n"
+          "     File extension: *.png or *.raw (8-bit color index).\n"
+          "  -I <cycles> Together with -S capture a frame each <cycles> "
+          "CPU cycles.\n"
+          "     A six digit sequence number is appended to the file name.\n"
           "  -h (display this)\n"
           "  -? (display this)\n"
           "  -V (print version number)\n";
@@ -210,7 +219,7 @@ void FlexemuOptions::GetCommandlineOptions(
     float f;
     optind = 1;
     opterr = 1;
-    std::string optstr("mup:f:0:1:2:3:j:F:C:O:L:");
+    std::string optstr("mup:f:0:1:2:3:j:F:C:K:O:L:S:I:");
 #ifdef HAVE_TERMIOS_H
     optstr.append("tr:T:"); // terminal mode, reset key and terminal type
 #endif
@@ -317,6 +326,19 @@ void FlexemuOptions::GetCommandlineOptions(
             case 'C':
                 options.startup_command = optarg;
                 break;
+
+            case 'K':
+                {
+                    const auto tmp = fs::u8path(optarg);
+                    if (!fs::is_regular_file(tmp))
+                    {
+                        std::cerr << "input script file '" <<
+                            tmp << "' does not exist.\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    options.inputScriptPath = tmp;
+                }
+                break;
 #ifdef UNIX
 #ifdef HAVE_TERMIOS_H
 
@@ -341,12 +363,18 @@ void FlexemuOptions::GetCommandlineOptions(
             case 'T':
                 {
                     std::string str(optarg);
+                    // The endpoint of a remote terminal is checked when
+                    // the terminal is initialized.
+                    const auto isRemote = str.compare("pty") == 0 ||
+                        str.compare(0U, 4U, "tcp:") == 0 ||
+                        str.compare(0U, 5U, "unix:") == 0;
 
                     if (str.compare("scroll") != 0 &&
-                        str.compare("curses") != 0)
+                        str.compare("curses") != 0 && !isRemote)
                     {
                         std::cerr << "Invalid -T value: '" << optarg << "'.\n"
-                            "Only 'scroll' and 'curses' is supported.\n";
+                            "Only 'scroll', 'curses', 'pty', 'tcp:<port>' "
+                            "and 'unix:<path>' is supported.\n";
                         exit(EXIT_FAILURE);
                     }
 
@@ -358,6 +386,11 @@ void FlexemuOptions::GetCommandlineOptions(
                     {
                         options.terminalType = 2;
                     }
+                    else
+                    {
+                        options.terminalType = 3;
+                        options.terminalEndpoint = str;
+                    }
                     setReadOnly(FlexemuOptionId::TerminalType);
                 }
                 break;
@@ -428,6 +461,34 @@ void FlexemuOptions::GetCommandlineOptions(
                 }
                 break;
 
+            case 'S':
+                {
+                    const auto tmp = fs::u8path(optarg);
+                    const auto ext = flx::tolower(tmp.extension().u8string());
+                    if (ext != ".png" && ext != ".raw")
+                    {
+                        std::cerr << "capture path '" <<
+                            tmp << "' has an unsupported file extension.\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    options.capturePath = tmp;
+                }
+                break;
+
+            case 'I':
+                {
+                    std::stringstream str(optarg);
+
+                    if (!(str >> options.captureCycleInterval) ||
+                        options.captureCycleInterval == 0U)
+                    {
+                        std::cerr << "Invalid -I value: '" << optarg << "'.\n"
+                            "Only a positive number of cycles is allowed.\n";
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                break;
+
             case 'V':
                 flx::print_versions(std::cout, PROJECT_NAME);
                 exit(EXIT_SUCCESS);
@@ -438,6 +499,12 @@ void FlexemuOptions::GetCommandlineOptions(
                 exit(EXIT_SUCCESS);
         }
     }
+
+    if (options.captureCycleInterval != 0U && options.capturePath.empty())
+    {
+        std::cerr << "Parameter -I needs a capture path set by -S.\n";
+        exit(EXIT_FAILURE);
+    }
 }
 
 
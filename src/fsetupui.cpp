@@ -1315,6 +1315,7 @@ void FlexemuOptionsUi::OnTerminalTypeChanged(TerminalType type)
             c_terminalIgnoreESC->setEnabled(false);
             break;
 
+        case TerminalType::Remote:
         case TerminalType::Dummy:
             break;
     }
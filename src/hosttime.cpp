@@ -29,6 +29,20 @@
 #include <cerrno>
 #include <csignal>
 #endif
+#ifdef USE_TIMERFD
+#include "misc1.h"
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <ctime>
+#include <cerrno>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <array>
+#include <algorithm>
+#endif
 #ifdef _WIN32
 #include "misc1.h"
 #include <thread>
@@ -51,6 +65,252 @@
 static void SignalHandler(int sig, siginfo_t *sigInfo, void *uc);
 #endif
 
+#ifdef USE_TIMERFD
+// class HostTimerThread executes any number of host timers on one thread.
+// It waits on a timerfd armed with the absolute time of the next due
+// timer. An eventfd wakes up the thread if a timer is changed.
+// The thread exists as long as at least one host timer uses it.
+class HostTimerThread
+{
+    struct Entry
+    {
+        std::int64_t cycleTimeNs;
+        std::int64_t nextTimeNs;
+    };
+
+public:
+    HostTimerThread();
+    ~HostTimerThread();
+    HostTimerThread(const HostTimerThread &src) = delete;
+    HostTimerThread(HostTimerThread &&src) = delete;
+    HostTimerThread &operator=(const HostTimerThread &src) = delete;
+    HostTimerThread &operator=(HostTimerThread &&src) = delete;
+
+    static std::shared_ptr<HostTimerThread> GetInstance();
+
+    int GetLastErrno() const
+    {
+        return lastErrno.load();
+    }
+    // Start a timer or change its cycle time.
+    void Set(HostTimer &timer, std::int64_t cycleTimeNs);
+    // Stop a timer. When returning the timer is not notified any more.
+    void Remove(HostTimer &timer);
+
+private:
+    static std::int64_t Now();
+    void Wakeup() const;
+    void Run();
+
+    int timerFd{-1};
+    int eventFd{-1};
+    std::atomic<int> lastErrno{}; // written on the timer thread
+    bool isExit{};
+    std::vector<std::pair<HostTimer *, Entry> > entries;
+    std::mutex mutex; // protects entries and isExit
+    std::mutex notifyMutex; // held while notifying timers
+    std::unique_ptr<std::thread> thread;
+};
+
+HostTimerThread::HostTimerThread()
+{
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd == -1)
+    {
+        lastErrno = errno;
+        return;
+    }
+
+    eventFd = eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd == -1)
+    {
+        lastErrno = errno;
+        return;
+    }
+
+    thread = std::make_unique<std::thread>(&HostTimerThread::Run, this);
+}
+
+HostTimerThread::~HostTimerThread()
+{
+    if (thread)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            isExit = true;
+        }
+        Wakeup();
+        thread->join();
+        thread.reset();
+    }
+
+    if (eventFd != -1)
+    {
+        close(eventFd);
+    }
+
+    if (timerFd != -1)
+    {
+        close(timerFd);
+    }
+}
+
+std::shared_ptr<HostTimerThread> HostTimerThread::GetInstance()
+{
+    static std::mutex instanceMutex;
+    static std::weak_ptr<HostTimerThread> instance;
+    std::lock_guard<std::mutex> guard(instanceMutex);
+
+    auto result = instance.lock();
+    if (!result)
+    {
+        result = std::make_shared<HostTimerThread>();
+        instance = result;
+    }
+
+    return result;
+}
+
+std::int64_t HostTimerThread::Now()
+{
+    constexpr const std::int64_t const1SecNs = 1000000000LL;
+    struct timespec now{};
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (static_cast<std::int64_t>(now.tv_sec) * const1SecNs) +
+           now.tv_nsec;
+}
+
+void HostTimerThread::Wakeup() const
+{
+    const std::uint64_t value = 1U;
+
+    // If the counter overflows the thread is woken up anyway.
+    while (write(eventFd, &value, sizeof(value)) == -1 && errno == EINTR)
+    {
+    }
+}
+
+void HostTimerThread::Set(HostTimer &timer, std::int64_t cycleTimeNs)
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        const Entry entry{cycleTimeNs, Now() + cycleTimeNs};
+        auto iter = std::find_if(entries.begin(), entries.end(),
+                [&](const auto &item){ return item.first == &timer; });
+
+        if (iter != entries.end())
+        {
+            iter->second = entry;
+        }
+        else
+        {
+            entries.emplace_back(&timer, entry);
+        }
+    }
+    Wakeup();
+}
+
+void HostTimerThread::Remove(HostTimer &timer)
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                [&](const auto &item){ return item.first == &timer; }),
+                entries.end());
+    }
+    Wakeup();
+
+    // Wait until a notification which may be in progress has finished.
+    // On the timer thread itself there is nothing to wait for.
+    if (thread && std::this_thread::get_id() != thread->get_id())
+    {
+        std::lock_guard<std::mutex> guard(notifyMutex);
+    }
+}
+
+void HostTimerThread::Run()
+{
+    constexpr const std::int64_t const1SecNs = 1000000000LL;
+    std::vector<HostTimer *> dueTimers;
+    std::array<struct pollfd, 2> fds{};
+
+    flx::setCurrentThreadName("HostTimerThread");
+    fds[0].fd = timerFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = eventFd;
+    fds[1].events = POLLIN;
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> notifyLock(notifyMutex);
+
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            if (isExit)
+            {
+                return;
+            }
+
+            const auto now = Now();
+            std::int64_t nextTimeNs{};
+
+            for (auto &[timer, entry] : entries)
+            {
+                if (entry.nextTimeNs <= now)
+                {
+                    dueTimers.push_back(timer);
+                    entry.nextTimeNs += entry.cycleTimeNs;
+                    if (entry.nextTimeNs <= now)
+                    {
+                        // Skip events which are too late.
+                        entry.nextTimeNs = now + entry.cycleTimeNs;
+                    }
+                }
+
+                if (nextTimeNs == 0 || entry.nextTimeNs < nextTimeNs)
+                {
+                    nextTimeNs = entry.nextTimeNs;
+                }
+            }
+
+            // Arm timer with the absolute time of the next due timer.
+            // A zero time disarms the timer.
+            struct itimerspec timerSpec{};
+            timerSpec.it_value.tv_sec = nextTimeNs / const1SecNs;
+            timerSpec.it_value.tv_nsec = nextTimeNs % const1SecNs;
+            if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &timerSpec,
+                                nullptr) == -1)
+            {
+                lastErrno = errno;
+            }
+        }
+
+        for (auto *timer : dueTimers)
+        {
+            timer->DoNotify();
+        }
+        dueTimers.clear();
+        notifyLock.unlock();
+
+        if (poll(fds.data(), fds.size(), -1) > 0)
+        {
+            std::uint64_t value;
+
+            for (const auto &pfd : fds)
+            {
+                if ((pfd.revents & POLLIN) != 0)
+                {
+                    (void)read(pfd.fd, &value, sizeof(value));
+                }
+            }
+        }
+    }
+}
+#endif
+
 HostTimer::HostTimer(int p_uniqueTimerId,
         const FlexemuConfigFileSPtr &configFile)
     : uniqueTimerId(p_uniqueTimerId)
@@ -97,6 +357,9 @@ HostTimer::HostTimer(int p_uniqueTimerId,
 #else
     (void)configFile;
 #endif
+#ifdef USE_TIMERFD
+    timerThread = HostTimerThread::GetInstance();
+#endif
 #ifdef USE_POSIX_TIMERS
     struct sigevent sigEvent{};
     struct sigaction sigAction{};
@@ -197,6 +460,12 @@ void HostTimer::InitCycleTime(std::int64_t p_cycleTimeNs)
         }
     }
 #endif
+#ifdef USE_TIMERFD
+    if (timerThread->GetLastErrno() == 0)
+    {
+        timerThread->Set(*this, p_cycleTimeNs);
+    }
+#endif
 }
 
 void HostTimer::DisableTimer()
@@ -216,6 +485,9 @@ void HostTimer::DisableTimer()
         lastErrno = errno;
     }
 #endif
+#ifdef USE_TIMERFD
+    timerThread->Remove(*this);
+#endif
 }
 
 void HostTimer::UpdateFrom(NotifyId id, void *param)
@@ -241,6 +513,9 @@ void HostTimer::UpdateFrom(NotifyId id, void *param)
 #endif
 #ifdef USE_POSIX_TIMERS
             params->isValid = (lastErrno == 0);
+#endif
+#ifdef USE_TIMERFD
+            params->isValid = (timerThread->GetLastErrno() == 0);
 #endif
         }
     }
@@ -27,7 +27,9 @@
 #include <windows.h>
 #else
 #include <unistd.h>
-#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
+#ifdef __linux__
+#define USE_TIMERFD
+#elif defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
 #define USE_POSIX_TIMERS
 #endif
 #endif
@@ -43,12 +45,21 @@
 #include <thread>
 #include <memory>
 #endif
+#ifdef USE_TIMERFD
+#include <memory>
+#endif
 #include <functional>
 #include <atomic>
 #include <unordered_map>
 
+#ifdef USE_TIMERFD
+class HostTimerThread;
+#endif
+
 // class HostTimer can send cyclic events with nanosecond accuracy based
 // on the host clock.
+// On Linux all host timers share one timer thread based on timerfd,
+// no signals are used. The events are sent on this thread.
 class HostTimer : public BObserver, public BObserved
 {
 #ifdef USE_POSIX_TIMERS
@@ -76,6 +87,9 @@ private:
     const int sigVal{};
     int lastErrno{};
 #endif
+#ifdef USE_TIMERFD
+    std::shared_ptr<HostTimerThread> timerThread;
+#endif
 #endif
 
 public:
@@ -0,0 +1,58 @@
+/*
+    idleloop.cpp  Detect a guest idle loop polling an I/O register.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "idleloop.h"
+#include "schedcpu.h"
+
+
+IdleLoopDetector::IdleLoopDetector(ScheduledCpu &p_cpu)
+    : cpu(p_cpu)
+{
+}
+
+void IdleLoopDetector::OnIoRead(Word address, Byte value)
+{
+    const auto cycles = cpu.get_cycles();
+    const auto delta = cycles - lastCycles;
+
+    if (!isStateChanged && address == lastAddress && value == lastValue &&
+        delta == lastDelta && delta != 0U && delta <= MAX_LOOP_CYCLES)
+    {
+        if (++matchCount >= MIN_MATCHES)
+        {
+            matchCount = 0U;
+            cpu.set_idle();
+        }
+    }
+    else
+    {
+        matchCount = 0U;
+    }
+
+    lastCycles = cycles;
+    lastDelta = delta;
+    lastAddress = address;
+    lastValue = value;
+    isStateChanged = false;
+}
@@ -0,0 +1,74 @@
+/*
+    idleloop.h  Detect a guest idle loop polling an I/O register.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef IDLELOOP_INCLUDED
+#define IDLELOOP_INCLUDED
+
+#include "typedefs.h"
+
+
+class ScheduledCpu;
+
+// class IdleLoopDetector detects a guest loop which only polls an I/O
+// register, e.g. waiting for a key press.
+// Memory reports each I/O read and each write which changes the emulated
+// state. A loop is detected if the same I/O register is read with the same
+// value, the same number of CPU cycles between two reads and no state
+// change in between. After MIN_MATCHES such reads the CPU is requested to
+// suspend until the next timer event (see ScheduledCpu::set_idle()).
+// All functions are called on the CPU thread.
+class IdleLoopDetector
+{
+public:
+    // Maximum number of CPU cycles of one loop iteration.
+    static constexpr QWord MAX_LOOP_CYCLES = 256U;
+    // Number of matching loop iterations until the CPU is suspended.
+    // It is larger than the number of status polls after which the
+    // terminal implementations check for host input, so that host input
+    // is checked at least once on each timer event.
+    static constexpr DWord MIN_MATCHES = 128U;
+
+    IdleLoopDetector() = delete;
+    explicit IdleLoopDetector(ScheduledCpu &p_cpu);
+    ~IdleLoopDetector() = default;
+    IdleLoopDetector(const IdleLoopDetector &src) = delete;
+    IdleLoopDetector(IdleLoopDetector &&src) = delete;
+    IdleLoopDetector &operator=(const IdleLoopDetector &src) = delete;
+    IdleLoopDetector &operator=(IdleLoopDetector &&src) = delete;
+
+    void OnIoRead(Word address, Byte value);
+    inline void OnStateChange()
+    {
+        isStateChanged = true;
+    }
+
+private:
+    ScheduledCpu &cpu;
+    QWord lastCycles{};
+    QWord lastDelta{};
+    DWord matchCount{};
+    Word lastAddress{};
+    Byte lastValue{};
+    bool isStateChanged{true};
+};
+
+#endif
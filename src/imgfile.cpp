@@ -0,0 +1,195 @@
+/*
+    imgfile.cpp  Write indexed 8-bit images to a file.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "imgfile.h"
+#include <cassert>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// PNG file format, for details see:
+// https://www.w3.org/TR/png/
+// The image data is a zlib stream using uncompressed (stored) deflate blocks,
+// for details see:
+// https://www.rfc-editor.org/rfc/rfc1950
+// https://www.rfc-editor.org/rfc/rfc1951
+
+static DWord crc32(DWord crc, const Byte *data, std::size_t size)
+{
+    static const auto crcTable = [](){
+        std::array<DWord, 256> table{};
+
+        for (DWord n = 0U; n < table.size(); ++n)
+        {
+            DWord value = n;
+
+            for (int k = 0; k < 8; ++k)
+            {
+                value = (value & 1U) ? 0xEDB88320U ^ (value >> 1U) :
+                                       value >> 1U;
+            }
+            table[n] = value;
+        }
+
+        return table;
+    }();
+
+    crc = ~crc;
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        crc = crcTable[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8U);
+    }
+
+    return ~crc;
+}
+
+static DWord adler32(DWord adler, const Byte *data, std::size_t size)
+{
+    DWord a = adler & 0xFFFFU;
+    DWord b = adler >> 16U;
+
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        a = (a + data[i]) % 65521U;
+        b = (b + a) % 65521U;
+    }
+
+    return (b << 16U) | a;
+}
+
+static void appendBigEndian(std::vector<Byte> &buffer, DWord value)
+{
+    buffer.push_back(static_cast<Byte>(value >> 24U));
+    buffer.push_back(static_cast<Byte>(value >> 16U));
+    buffer.push_back(static_cast<Byte>(value >> 8U));
+    buffer.push_back(static_cast<Byte>(value));
+}
+
+static void appendChunk(std::vector<Byte> &buffer, const char *type,
+                        const std::vector<Byte> &data)
+{
+    appendBigEndian(buffer, static_cast<DWord>(data.size()));
+    const auto typeIndex = buffer.size();
+    buffer.insert(buffer.end(), type, type + 4);
+    buffer.insert(buffer.end(), data.cbegin(), data.cend());
+    appendBigEndian(buffer, crc32(0U, &buffer[typeIndex], data.size() + 4U));
+}
+
+static bool writeFile(const fs::path &path, const Byte *data, std::size_t size)
+{
+    std::ofstream ofs(path, std::ios::out | std::ios::binary |
+                            std::ios::trunc);
+
+    if (!ofs.is_open())
+    {
+        return false;
+    }
+
+    ofs.write(reinterpret_cast<const char *>(data),
+              static_cast<std::streamsize>(size));
+
+    return ofs.good();
+}
+
+bool flx::writePngFile(const fs::path &path, int width, int height,
+                       const Byte *pixels, const std::vector<DWord> &colorTable)
+{
+    assert(width > 0 && height > 0);
+    assert(pixels != nullptr);
+    assert(!colorTable.empty() && colorTable.size() <= 256U);
+
+    static constexpr std::array<Byte, 8> signature{
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'
+    };
+    const auto uWidth = static_cast<std::size_t>(width);
+    const auto uHeight = static_cast<std::size_t>(height);
+    std::vector<Byte> buffer(signature.cbegin(), signature.cend());
+    std::vector<Byte> data;
+
+    // Image header: 8-bit indexed color, no interlace.
+    appendBigEndian(data, static_cast<DWord>(width));
+    appendBigEndian(data, static_cast<DWord>(height));
+    data.insert(data.end(), { 8U, 3U, 0U, 0U, 0U });
+    appendChunk(buffer, "IHDR", data);
+
+    data.clear();
+    for (const auto color : colorTable)
+    {
+        data.push_back(static_cast<Byte>(color >> 16U));
+        data.push_back(static_cast<Byte>(color >> 8U));
+        data.push_back(static_cast<Byte>(color));
+    }
+    appendChunk(buffer, "PLTE", data);
+
+    // Each raster line is preceded by filter type 0 (None).
+    std::vector<Byte> rawData;
+    rawData.reserve(uHeight * (uWidth + 1U));
+    for (std::size_t y = 0U; y < uHeight; ++y)
+    {
+        rawData.push_back(0U);
+        rawData.insert(rawData.end(), pixels + (y * uWidth),
+                       pixels + ((y + 1U) * uWidth));
+    }
+
+    // zlib header: deflate, 32K window, no preset dictionary.
+    data.assign({ 0x78U, 0x01U });
+    static constexpr std::size_t maxBlockSize = 0xFFFFU;
+    for (std::size_t offset = 0U; offset < rawData.size();)
+    {
+        const auto size = std::min(maxBlockSize, rawData.size() - offset);
+        const bool isFinal = (offset + size == rawData.size());
+        const auto len = static_cast<Word>(size);
+        const auto nlen = static_cast<Word>(~len);
+
+        data.push_back(isFinal ? 1U : 0U);
+        data.push_back(static_cast<Byte>(len));
+        data.push_back(static_cast<Byte>(len >> 8U));
+        data.push_back(static_cast<Byte>(nlen));
+        data.push_back(static_cast<Byte>(nlen >> 8U));
+        data.insert(data.end(), &rawData[offset], &rawData[offset] + size);
+        offset += size;
+    }
+    appendBigEndian(data, adler32(1U, rawData.data(), rawData.size()));
+    appendChunk(buffer, "IDAT", data);
+
+    data.clear();
+    appendChunk(buffer, "IEND", data);
+
+    return writeFile(path, buffer.data(), buffer.size());
+}
+
+bool flx::writeRawFile(const fs::path &path, const Byte *pixels,
+                       std::size_t size)
+{
+    assert(pixels != nullptr);
+
+    return writeFile(path, pixels, size);
+}
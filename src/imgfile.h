@@ -0,0 +1,50 @@
+/*
+    imgfile.h  Write indexed 8-bit images to a file.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef IMGFILE_INCLUDED
+#define IMGFILE_INCLUDED
+
+#include "typedefs.h"
+#include <cstddef>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+namespace flx
+{
+    // Write an image with indexed 8-bit pixels as PNG file.
+    // pixels:     width * height color indices, row by row, top down.
+    // colorTable: Up to 256 colors in the format 0xAARRGGBB.
+    // The image data is stored uncompressed so no compression library
+    // is needed. Return false if the file could not be written.
+    extern bool writePngFile(const fs::path &path, int width, int height,
+                             const Byte *pixels,
+                             const std::vector<DWord> &colorTable);
+    // Write indexed 8-bit pixels as raw file without any header.
+    // Return false if the file could not be written.
+    extern bool writeRawFile(const fs::path &path, const Byte *pixels,
+                             std::size_t size);
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+    injector.cpp  Inject text into the guest as fast as it is read.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "injector.h"
+#include "asciictl.h"
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <filesystem>
+
+
+void InputInjector::Inject(const std::string &p_text)
+{
+    if (p_text.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex);
+    for (std::string::size_type i = 0U; i < p_text.size(); ++i)
+    {
+        const auto ch = static_cast<Byte>(p_text[i]);
+
+        if (ch == LF)
+        {
+            text.push_back(CR);
+        }
+        else if (ch != CR || i + 1U >= p_text.size() || p_text[i + 1U] != LF)
+        {
+            text.push_back(ch);
+        }
+    }
+    hasText.store(!text.empty(), std::memory_order_release);
+}
+
+bool InputInjector::InjectFile(const fs::path &path)
+{
+    std::ifstream ifs(path, std::ios::in | std::ios::binary);
+
+    if (!ifs.is_open())
+    {
+        return false;
+    }
+
+    const std::string contents{std::istreambuf_iterator<char>(ifs),
+                               std::istreambuf_iterator<char>()};
+    if (ifs.bad())
+    {
+        return false;
+    }
+
+    Inject(contents);
+
+    return true;
+}
+
+void InputInjector::ResetDelay()
+{
+    delay = RESET_DELAY;
+    isCharAvailable = false;
+}
+
+bool InputInjector::IsCharAvailable()
+{
+    // Using an atomic bool is faster than acquiring a lock guard.
+    if (!hasText.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    if (delay != 0U)
+    {
+        --delay;
+        return false;
+    }
+
+    isCharAvailable = true;
+
+    return true;
+}
+
+std::optional<Byte> InputInjector::ReadChar()
+{
+    if (!isCharAvailable)
+    {
+        return std::nullopt;
+    }
+
+    isCharAvailable = false;
+
+    std::lock_guard<std::mutex> guard(mutex);
+    if (text.empty())
+    {
+        return std::nullopt;
+    }
+
+    const auto result = text.front();
+    text.pop_front();
+    hasText.store(!text.empty(), std::memory_order_release);
+    delay = CHAR_DELAY;
+
+    return result;
+}
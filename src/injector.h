@@ -0,0 +1,90 @@
+/*
+    injector.h  Inject text into the guest as fast as it is read.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef INJECTOR_INCLUDED
+#define INJECTOR_INCLUDED
+
+#include "typedefs.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// class InputInjector feeds text, e.g. a startup command or a script file,
+// into a serial or parallel input device of the guest.
+// A character is consumed if the guest has read the status register
+// (IsCharAvailable()) and afterwards the data register (ReadChar()).
+// The next character is delayed for CHAR_DELAY status register reads.
+// Reason: The monitor echoes each character. While doing so it checks
+// for Ctrl-X by reading the status and, if a character is available, the
+// data register. Without a delay every second character would get lost.
+// The delay is counted in status register reads, so the text is still
+// injected with nearly the maximum rate the guest reads it.
+// After a reset the first character is delayed for a number of status
+// register reads. Reason: After output of one line FLEX requests for
+// keyboard input. Any input has to be delayed until the FLEX prompt.
+// Inject() and InjectFile() can be called from any thread, all other
+// functions have to be called on the CPU thread.
+class InputInjector
+{
+public:
+    InputInjector() = default;
+    ~InputInjector() = default;
+    InputInjector(const InputInjector &src) = delete;
+    InputInjector(InputInjector &&src) = delete;
+    InputInjector &operator=(const InputInjector &src) = delete;
+    InputInjector &operator=(InputInjector &&src) = delete;
+
+    // Append text to be injected. A line feed or carriage return
+    // followed by a line feed is converted into a carriage return.
+    void Inject(const std::string &text);
+    // Append the contents of a text file to be injected.
+    // Return false if the file can not be read.
+    bool InjectFile(const fs::path &path);
+    // Restart the delay of the first character after a reset.
+    void ResetDelay();
+
+    // Called on a status register read. Return true if a character is
+    // available.
+    bool IsCharAvailable();
+    // Called on a data register read. If a character has been reported
+    // as available by IsCharAvailable() return it.
+    std::optional<Byte> ReadChar();
+
+    static constexpr Word RESET_DELAY = 500U;
+    static constexpr Word CHAR_DELAY = 2U;
+
+private:
+    std::mutex mutex;
+    std::deque<Byte> text;
+    std::atomic<bool> hasText{};
+    // Only accessed on the CPU thread.
+    Word delay{RESET_DELAY};
+    bool isCharAvailable{};
+};
+
+#endif
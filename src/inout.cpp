@@ -49,7 +49,8 @@ void Inout::set_gui(AbstractGui *p_gui)
 // which need it
 void Inout::update_1_second()
 {
-    if (rtc != nullptr)
+    // With emulated time the RTC is updated by the RTC itself.
+    if (rtc != nullptr && !rtc->is_emulated_time())
     {
         rtc->update_1_second();
     }
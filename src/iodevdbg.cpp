@@ -23,47 +23,45 @@
 #include "typedefs.h"
 #include "iodevdbg.h"
 #include "iodevice.h"
-#include "warnoff.h"
-#include <fmt/format.h>
-#include "warnon.h"
-#include <ios>
+#include "iotrace.h"
+#include "schedcpu.h"
 #include <utility>
-#include <string>
-#include <fstream>
 
 
-IoDeviceDebug::IoDeviceDebug(IoDevice &p_device, std::string p_logFilePath)
+IoDeviceDebug::IoDeviceDebug(IoDevice &p_device, IoTracer &p_tracer,
+        ScheduledCpu &p_cpu, sIoDeviceLogFilter p_filter)
     : device(p_device)
-    , logFilePath(std::move(p_logFilePath))
+    , tracer(p_tracer)
+    , cpu(p_cpu)
+    , filter(std::move(p_filter))
+    , deviceIndex(tracer.AddDevice(device.getName()))
 {
-    std::ofstream fstream(logFilePath,
-                          std::ios_base::out | std::ios_base::trunc);
-
-    if (fstream.is_open())
-    {
-        // Just truncate and close file.
-        fstream.close();
-    }
 }
 
 IoDeviceDebug::IoDeviceDebug(IoDeviceDebug &&src) noexcept
     : device(src.device)
-    , logFilePath(std::move(src.logFilePath))
+    , tracer(src.tracer)
+    , cpu(src.cpu)
+    , filter(std::move(src.filter))
+    , deviceIndex(src.deviceIndex)
 {
 }
 
-Byte IoDeviceDebug::readIo(Word offset)
+bool IoDeviceDebug::IsRecorded(bool isRead, Word offset) const
 {
-    std::ofstream fstream(logFilePath, std::ios_base::out | std::ios_base::app);
+    return (isRead ? filter.isLogRead : filter.isLogWrite) &&
+           (filter.offsets.empty() ||
+            filter.offsets.find(offset) != filter.offsets.end());
+}
 
+Byte IoDeviceDebug::readIo(Word offset)
+{
     Byte result = device.readIo(offset);
 
-    if (fstream.is_open())
+    if (IsRecorded(true, offset))
     {
-        fstream << fmt::format(
-                "mode=read  offset={:4} result={:02X} device={}\n",
-                offset, static_cast<Word>(result), device.getName());
-        fstream.close();
+        tracer.Record({ cpu.get_cycles(), offset, deviceIndex,
+                        IoTraceMode::Read, result });
     }
 
     return result;
@@ -71,33 +69,21 @@ Byte IoDeviceDebug::readIo(Word offset)
 
 void IoDeviceDebug::writeIo(Word offset, Byte value)
 {
-    std::ofstream fstream(logFilePath, std::ios_base::out | std::ios_base::app);
-
     device.writeIo(offset, value);
 
-    if (fstream.is_open())
+    if (IsRecorded(false, offset))
     {
-        fstream << fmt::format(
-                "mode=write offset={:4} value={:02X}  device={}\n",
-                offset, static_cast<Word>(value), device.getName());
-        fstream.close();
+        tracer.Record({ cpu.get_cycles(), offset, deviceIndex,
+                        IoTraceMode::Write, value });
     }
 }
 
 void IoDeviceDebug::resetIo()
 {
-    std::ofstream fstream(logFilePath, std::ios_base::out | std::ios_base::app);
-
     device.resetIo();
 
-    if (fstream.is_open())
-    {
-
-        fstream << "mode=reset device=" << std::string(device.getName())
-                << '\n';
-
-        fstream.close();
-    }
+    tracer.Record({ cpu.get_cycles(), 0U, deviceIndex, IoTraceMode::Reset,
+                    0U });
 }
 
 const char *IoDeviceDebug::getName()
@@ -130,3 +116,7 @@ Word IoDeviceDebug::sizeOfIo()
     return device.sizeOfIo();
 }
 
+const LatencyHistogram *IoDeviceDebug::getHostLatency()
+{
+    return device.getHostLatency();
+}
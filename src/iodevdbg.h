@@ -26,15 +26,22 @@
 #define IODEVDBG_INCLUDED
 
 #include "iodevice.h"
-#include <string>
+#include "fcnffile.h"
 
+class IoTracer;
+class ScheduledCpu;
+
+// class IoDeviceDebug wraps an I/O device and records each access
+// which passes the filter into the I/O tracer, together with the current
+// CPU cycle count.
 class IoDeviceDebug : public IoDevice
 {
 public:
 
     IoDeviceDebug() = delete;
     ~IoDeviceDebug() override = default;
-    IoDeviceDebug(IoDevice &p_device, std::string p_logFilePath);
+    IoDeviceDebug(IoDevice &p_device, IoTracer &p_tracer, ScheduledCpu &p_cpu,
+                  sIoDeviceLogFilter p_filter);
     IoDeviceDebug(const IoDeviceDebug &src) = default;
     IoDeviceDebug(IoDeviceDebug &&src) noexcept;
     // Avoid using copy or move assignment because of device reference
@@ -52,12 +59,20 @@ public:
     const char *getClassDescription() override;
     const char *getVendor() override;
     Word sizeOfIo() override;
+    const LatencyHistogram *getHostLatency() override;
 
 private:
+    bool IsRecorded(bool isRead, Word offset) const;
+
     // Intentionally use a reference.
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
     IoDevice &device;
-    std::string logFilePath;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    IoTracer &tracer;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    ScheduledCpu &cpu;
+    sIoDeviceLogFilter filter;
+    Byte deviceIndex;
 };
 
 #endif
@@ -27,6 +27,8 @@
 
 #include "typedefs.h"
 
+class LatencyHistogram;
+
 // Polymorphic interface, virtual dtor is required.
 // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
 class IoDevice
@@ -47,6 +49,12 @@ public:
     // Vendor of device.
     virtual const char *getVendor() = 0;
     virtual Word sizeOfIo() = 0;
+    // Histogram of the host time needed for device accesses calling out
+    // to host resources, nullptr if not supported by the device.
+    virtual const LatencyHistogram *getHostLatency()
+    {
+        return nullptr;
+    }
     virtual ~IoDevice() = default;
 };
 
@@ -0,0 +1,173 @@
+/*
+    iostat.cpp  I/O device access counters and host latency histograms.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "iostat.h"
+#include "warnoff.h"
+#include <fmt/format.h>
+#include "warnon.h"
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <string>
+
+
+void LatencyHistogram::Add(std::chrono::nanoseconds duration)
+{
+    auto durationUs = static_cast<QWord>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count());
+    std::size_t bucket = 0U;
+
+    while (durationUs != 0U && bucket < BUCKETS - 1U)
+    {
+        durationUs >>= 1U;
+        ++bucket;
+    }
+
+    // A terminal may add durations on its I/O thread and the CPU thread.
+    counts[bucket].fetch_add(1U, std::memory_order_relaxed);
+}
+
+QWord LatencyHistogram::GetCount(std::size_t bucket) const
+{
+    assert(bucket < BUCKETS);
+
+    return counts[bucket].load(std::memory_order_relaxed);
+}
+
+QWord LatencyHistogram::GetTotalCount() const
+{
+    QWord total = 0U;
+
+    for (const auto &count : counts)
+    {
+        total += count.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+QWord LatencyHistogram::GetUpperLimitUs(std::size_t bucket)
+{
+    assert(bucket < BUCKETS);
+
+    return (bucket == BUCKETS - 1U) ? 0U : (QWord(1U) << bucket);
+}
+
+IoDeviceStatistics::IoDeviceStatistics(Word p_size,
+        const LatencyHistogram *p_hostLatency)
+    : size(p_size)
+    , reads(std::make_unique<std::atomic<QWord>[]>(p_size))
+    , writes(std::make_unique<std::atomic<QWord>[]>(p_size))
+    , hostLatency(p_hostLatency)
+{
+}
+
+Word IoDeviceStatistics::GetSize() const
+{
+    return size;
+}
+
+QWord IoDeviceStatistics::GetReadCount(Word offset) const
+{
+    assert(offset < size);
+
+    return reads[offset].load(std::memory_order_relaxed);
+}
+
+QWord IoDeviceStatistics::GetWriteCount(Word offset) const
+{
+    assert(offset < size);
+
+    return writes[offset].load(std::memory_order_relaxed);
+}
+
+QWord IoDeviceStatistics::GetResetCount() const
+{
+    return resets.load(std::memory_order_relaxed);
+}
+
+QWord IoDeviceStatistics::GetTotalReadCount() const
+{
+    QWord total = 0U;
+
+    for (Word offset = 0U; offset < size; ++offset)
+    {
+        total += GetReadCount(offset);
+    }
+
+    return total;
+}
+
+QWord IoDeviceStatistics::GetTotalWriteCount() const
+{
+    QWord total = 0U;
+
+    for (Word offset = 0U; offset < size; ++offset)
+    {
+        total += GetWriteCount(offset);
+    }
+
+    return total;
+}
+
+const LatencyHistogram *IoDeviceStatistics::GetHostLatency() const
+{
+    return hostLatency;
+}
+
+std::string IoDeviceStatistics::ToJson(const std::string &name) const
+{
+    std::string result = fmt::format(
+        "{{\"name\":\"{}\",\"reads\":{},\"writes\":{},\"resets\":{},"
+        "\"registers\":[",
+        name, GetTotalReadCount(), GetTotalWriteCount(), GetResetCount());
+
+    for (Word offset = 0U; offset < size; ++offset)
+    {
+        result += fmt::format(
+            "{}{{\"offset\":{},\"reads\":{},\"writes\":{}}}",
+            offset == 0U ? "" : ",", offset, GetReadCount(offset),
+            GetWriteCount(offset));
+    }
+    result += "]";
+
+    if (hostLatency != nullptr)
+    {
+        // An upper limit of 0 means unlimited.
+        result += ",\"hostLatency\":[";
+        for (std::size_t bucket = 0U; bucket < LatencyHistogram::BUCKETS;
+             ++bucket)
+        {
+            result += fmt::format("{}{{\"upperLimitUs\":{},\"count\":{}}}",
+                bucket == 0U ? "" : ",",
+                LatencyHistogram::GetUpperLimitUs(bucket),
+                hostLatency->GetCount(bucket));
+        }
+        result += "]";
+    }
+    result += "}";
+
+    return result;
+}
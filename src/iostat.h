@@ -0,0 +1,138 @@
+/*
+    iostat.h  I/O device access counters and host latency histograms.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef IOSTAT_INCLUDED
+#define IOSTAT_INCLUDED
+
+#include "typedefs.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+
+// class LatencyHistogram counts durations in logarithmic buckets.
+// Bucket 0 counts durations < 1 us, bucket n counts durations
+// >= 2^(n-1) us and < 2^n us, the last bucket counts all longer durations.
+// Durations can be added and the counts can be read by any thread.
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t BUCKETS = 24U;
+
+    void Add(std::chrono::nanoseconds duration);
+    QWord GetCount(std::size_t bucket) const;
+    QWord GetTotalCount() const;
+    // Upper limit of a bucket in microseconds, 0 for the last bucket.
+    static QWord GetUpperLimitUs(std::size_t bucket);
+
+private:
+    std::array<std::atomic<QWord>, BUCKETS> counts{};
+};
+
+// class LatencyScope adds the host time from construction until
+// destruction to a latency histogram.
+class LatencyScope
+{
+public:
+    LatencyScope() = delete;
+    explicit LatencyScope(LatencyHistogram &p_histogram)
+        : histogram(p_histogram)
+        , start(std::chrono::steady_clock::now())
+    {
+    }
+    ~LatencyScope()
+    {
+        histogram.Add(std::chrono::steady_clock::now() - start);
+    }
+    LatencyScope(const LatencyScope &src) = delete;
+    LatencyScope(LatencyScope &&src) = delete;
+    LatencyScope &operator=(const LatencyScope &src) = delete;
+    LatencyScope &operator=(LatencyScope &&src) = delete;
+
+private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    LatencyHistogram &histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+// class IoDeviceStatistics counts read, write and reset accesses of an
+// I/O device for each register offset. Optionally it refers to a histogram
+// of the host time needed for device accesses calling out to host
+// resources.
+// Accesses are counted on the CPU thread, the counts can be read by any
+// thread.
+class IoDeviceStatistics
+{
+public:
+    IoDeviceStatistics() = delete;
+    IoDeviceStatistics(Word p_size, const LatencyHistogram *p_hostLatency);
+    ~IoDeviceStatistics() = default;
+    IoDeviceStatistics(const IoDeviceStatistics &src) = delete;
+    IoDeviceStatistics(IoDeviceStatistics &&src) = delete;
+    IoDeviceStatistics &operator=(const IoDeviceStatistics &src) = delete;
+    IoDeviceStatistics &operator=(IoDeviceStatistics &&src) = delete;
+
+    // The following count methods are inlined for optimized performance.
+    inline void CountRead(Word offset)
+    {
+        Increment(reads[offset]);
+    }
+
+    inline void CountWrite(Word offset)
+    {
+        Increment(writes[offset]);
+    }
+
+    inline void CountReset()
+    {
+        Increment(resets);
+    }
+
+    Word GetSize() const;
+    QWord GetReadCount(Word offset) const;
+    QWord GetWriteCount(Word offset) const;
+    QWord GetResetCount() const;
+    QWord GetTotalReadCount() const;
+    QWord GetTotalWriteCount() const;
+    const LatencyHistogram *GetHostLatency() const;
+    // Return the statistics as JSON object.
+    std::string ToJson(const std::string &name) const;
+
+private:
+    // Only one thread writes, so no atomic read-modify-write is needed.
+    static void Increment(std::atomic<QWord> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1U,
+                      std::memory_order_relaxed);
+    }
+
+    Word size;
+    std::unique_ptr<std::atomic<QWord>[]> reads;
+    std::unique_ptr<std::atomic<QWord>[]> writes;
+    std::atomic<QWord> resets{};
+    const LatencyHistogram *hostLatency;
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+    iotrace.cpp  Record I/O device accesses into a log file.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "misc1.h"
+#include "iotrace.h"
+#include "warnoff.h"
+#include <fmt/format.h>
+#include "warnon.h"
+#include <cassert>
+#include <chrono>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+// Maximum time the writer thread waits before writing pending records.
+static constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(20);
+
+IoTracer::IoTracer(const fs::path &p_logFilePath)
+    : logStream(p_logFilePath, std::ios_base::out | std::ios_base::trunc)
+{
+    writerThread = std::make_unique<std::thread>(&IoTracer::Run, this);
+}
+
+IoTracer::~IoTracer()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        isExit.store(true);
+    }
+    condition.notify_one();
+
+    if (writerThread)
+    {
+        writerThread->join();
+        writerThread.reset();
+    }
+}
+
+Byte IoTracer::AddDevice(const std::string &deviceName)
+{
+    assert(addedCount == 0U && deviceNames.size() < 256U);
+
+    deviceNames.push_back(deviceName);
+
+    return static_cast<Byte>(deviceNames.size() - 1U);
+}
+
+void IoTracer::Record(const sIoTraceRecord &record)
+{
+    while (!records.push(record))
+    {
+        condition.notify_one();
+        std::this_thread::yield();
+    }
+    ++addedCount;
+
+    // The writer thread is woken up early if the ring buffer
+    // gets half full.
+    if (records.size() == records.capacity() / 2U)
+    {
+        condition.notify_one();
+    }
+}
+
+void IoTracer::Flush()
+{
+    const auto count = addedCount;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    isFlushRequested = true;
+    condition.notify_one();
+    writtenCondition.wait(lock, [&](){ return writtenCount >= count; });
+}
+
+std::string IoTracer::Decode(const sIoTraceRecord &record,
+                             const std::string &deviceName)
+{
+    switch (record.mode)
+    {
+        case IoTraceMode::Read:
+            return fmt::format(
+                "mode=read  offset={:4} result={:02X} device={} cycles={}\n",
+                record.offset, static_cast<Word>(record.value), deviceName,
+                record.cycles);
+
+        case IoTraceMode::Write:
+            return fmt::format(
+                "mode=write offset={:4} value={:02X}  device={} cycles={}\n",
+                record.offset, static_cast<Word>(record.value), deviceName,
+                record.cycles);
+
+        case IoTraceMode::Reset:
+            return fmt::format("mode=reset device={} cycles={}\n",
+                               deviceName, record.cycles);
+    }
+
+    return {};
+}
+
+void IoTracer::Run()
+{
+    flx::setCurrentThreadName("IoTracerThread");
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait_for(lock, WRITE_INTERVAL, [&](){
+                return isExit.load() || isFlushRequested ||
+                       records.size() >= records.capacity() / 2U;
+            });
+            isFlushRequested = false;
+        }
+
+        // All pending records are written before exit.
+        WriteRecords();
+
+        if (isExit.load())
+        {
+            return;
+        }
+    }
+}
+
+void IoTracer::WriteRecords()
+{
+    QWord count = 0U;
+
+    while (!records.empty())
+    {
+        const auto &record = records.front();
+
+        // Any errors when writing to the file are ignored.
+        if (logStream.is_open())
+        {
+            logStream << Decode(record, deviceNames[record.deviceIndex]);
+        }
+        records.pop();
+        ++count;
+    }
+
+    if (count != 0U && logStream.is_open())
+    {
+        logStream.flush();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        writtenCount += count;
+    }
+    writtenCondition.notify_all();
+}
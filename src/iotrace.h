@@ -0,0 +1,104 @@
+/*
+    iotrace.h  Record I/O device accesses into a log file.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef IOTRACE_INCLUDED
+#define IOTRACE_INCLUDED
+
+#include "typedefs.h"
+#include "spscring.h"
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+enum class IoTraceMode : Byte
+{
+    Read,
+    Write,
+    Reset,
+};
+
+struct sIoTraceRecord
+{
+    QWord cycles{};
+    Word offset{};
+    Byte deviceIndex{};
+    IoTraceMode mode{IoTraceMode::Read};
+    Byte value{};
+};
+
+// class IoTracer records I/O device accesses as binary records into a
+// ring buffer. A writer thread decodes the records into text lines and
+// writes them into the log file which is kept open. This keeps the
+// overhead on the CPU thread low.
+// All devices have to be added before the first record is added.
+// Records have to be added from one thread only (the CPU thread).
+class IoTracer
+{
+public:
+    IoTracer() = delete;
+    explicit IoTracer(const fs::path &p_logFilePath);
+    ~IoTracer();
+    IoTracer(const IoTracer &src) = delete;
+    IoTracer(IoTracer &&src) = delete;
+    IoTracer &operator=(const IoTracer &src) = delete;
+    IoTracer &operator=(IoTracer &&src) = delete;
+
+    // Add a device, return the device index to be used in a record.
+    Byte AddDevice(const std::string &deviceName);
+    // If the ring buffer is full wait until the writer thread has
+    // written some records.
+    void Record(const sIoTraceRecord &record);
+    // Wait until all records added until now are written to the log file.
+    void Flush();
+
+    static std::string Decode(const sIoTraceRecord &record,
+                              const std::string &deviceName);
+
+private:
+    void Run();
+    void WriteRecords();
+
+    std::vector<std::string> deviceNames;
+    SpscRing<sIoTraceRecord, 16384U> records;
+    std::ofstream logStream;
+    // Only accessed by the thread adding records.
+    QWord addedCount{};
+    // Protected by mutex.
+    QWord writtenCount{};
+    bool isFlushRequested{};
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::condition_variable writtenCondition;
+    std::atomic<bool> isExit{};
+    std::unique_ptr<std::thread> writerThread;
+};
+
+#endif
@@ -34,9 +34,6 @@
 #endif
 #include <mutex>
 #include <optional>
-#include <iterator>
-#include <string>
-#include <algorithm>
 
 
 KeyboardIO::KeyboardIO()
@@ -190,18 +187,6 @@ void KeyboardIO::get_value(unsigned int *p_keyMask) const
     }
 }
 
-void KeyboardIO::set_startup_command(const std::string &startup_command)
-{
-    if (!startup_command.empty())
-    {
-        std::lock_guard<std::mutex> guard(parallel_mutex);
-        std::copy(startup_command.begin(), startup_command.end(),
-                  std::back_inserter(key_buffer_parallel));
-        key_buffer_parallel.push_back('\r');
-        has_key.store(true, std::memory_order_release);
-    }
-}
-
 void KeyboardIO::set_boot_char(const std::optional<Byte> &p_optional_boot_char)
 {
     optional_boot_char = p_optional_boot_char;
@@ -29,7 +29,6 @@
 #include <mutex>
 #include <atomic>
 #include <optional>
-#include <string>
 #include <deque>
 
 // key mask for shift, control key
@@ -56,7 +55,6 @@ public:
     void put_char_parallel(Byte key, bool &do_notify);
     void put_value(unsigned int keyMask);
     void get_value(unsigned int *keyMask) const;
-    void set_startup_command(const std::string &startup_command);
     void set_boot_char(const std::optional<Byte> &p_optional_boot_char);
 
     KeyboardIO();
@@ -25,7 +25,10 @@
 #include "mc146818.h"
 #include "bitops.h"
 #include "bobshelp.h"
+#include "e2.h"
+#include "schedule.h"
 #include <ctime>
+#include <cmath>
 #include <cstring>
 #include <ios>
 #include <string>
@@ -153,6 +156,19 @@ void Mc146818::resetIo()
 {
     B &= 0x87U;
     C = 0;
+
+    if (scheduler != nullptr)
+    {
+        // Restart the clock update and the periodic interrupt. Pending
+        // device events are cancelled, otherwise each reset would add
+        // another event chain.
+        scheduler->cancel_event(periodicEvent);
+        scheduler->cancel_event(updateEvent);
+        periodicEvent = Scheduler::InvalidDeviceEventId;
+        updateEvent = Scheduler::InvalidDeviceEventId;
+        scheduleUpdateEvent();
+        updatePeriodicIrqRate();
+    }
 }
 
 Byte Mc146818::readIo(Word offset)
@@ -614,16 +630,76 @@ void Mc146818::UpdateFrom(NotifyId id, void *param)
         }
 
         lastTime = now;
-        BSET<Byte>(C, C_PF_BIT); // set periodic interrupt flag
+        periodicInterrupt();
+    }
+}
 
-        if (BTST<Byte>(B, B_PIE_BIT)) // Periodic interrupt enable bit
-        {
-            BSET<Byte>(C, C_IRQF_BIT);
-            Notify(NotifyId::SetFirq);
-        }
+void Mc146818::periodicInterrupt()
+{
+    BSET<Byte>(C, C_PF_BIT); // set periodic interrupt flag
+
+    if (BTST<Byte>(B, B_PIE_BIT)) // Periodic interrupt enable bit
+    {
+        BSET<Byte>(C, C_IRQF_BIT);
+        Notify(NotifyId::SetFirq);
+    }
+}
+
+void Mc146818::set_emulated_time(Scheduler *p_scheduler)
+{
+    if (scheduler == nullptr && p_scheduler != nullptr)
+    {
+        // Stop a host timer which may already be running.
+        Notify(NotifyId::SetHostTimer, nullptr);
+    }
+
+    scheduler = p_scheduler;
+
+    if (scheduler != nullptr)
+    {
+        scheduleUpdateEvent();
+        updatePeriodicIrqRate();
     }
 }
 
+// CPU cycles per emulated microsecond. It is the target frequency of
+// the scheduler, so it follows frequency changes during emulation.
+// If the frequency is not limited the original frequency is used.
+double Mc146818::cyclesPerMicrosecond() const
+{
+    const auto frequency = scheduler->get_target_frequency();
+
+    return (frequency > 0.0F) ? static_cast<double>(frequency) :
+                                static_cast<double>(ORIGINAL_FREQUENCY);
+}
+
+// The next periodic interrupt is scheduled based on a fractional
+// cycle count, so there is no accumulated rounding error.
+void Mc146818::schedulePeriodicEvent()
+{
+    nextPeriodicCycles += periodicTimeNs * cyclesPerMicrosecond() / 1000.0;
+    periodicEvent = scheduler->schedule_event(
+        static_cast<QWord>(std::ceil(nextPeriodicCycles)), [this](){
+            periodicInterrupt();
+            schedulePeriodicEvent();
+        });
+}
+
+// The clock is updated each emulated second.
+void Mc146818::scheduleUpdateEvent()
+{
+    const auto cyclesPerSecond =
+        static_cast<QWord>(cyclesPerMicrosecond() * 1000000.0);
+
+    scheduler->cancel_event(updateEvent);
+    updateEvent = scheduler->schedule_event(
+        scheduler->get_event_cycles() + cyclesPerSecond, [this](){
+            update_1_second();
+            updateEvent = Scheduler::InvalidDeviceEventId;
+            scheduleUpdateEvent();
+        });
+}
+
 void Mc146818::updatePeriodicIrqRate()
 {
     HostTimerUpdate_t params{};
@@ -638,7 +714,23 @@ void Mc146818::updatePeriodicIrqRate()
         pParams = &params;
     }
 
-    Notify(NotifyId::SetHostTimer, pParams);
+    if (scheduler != nullptr)
+    {
+        scheduler->cancel_event(periodicEvent);
+        periodicEvent = Scheduler::InvalidDeviceEventId;
+
+        if (registerSelect != 0U)
+        {
+            periodicTimeNs = static_cast<double>(params.cycleTimeNs);
+            nextPeriodicCycles =
+                static_cast<double>(scheduler->get_event_cycles());
+            schedulePeriodicEvent();
+        }
+    }
+    else
+    {
+        Notify(NotifyId::SetHostTimer, pParams);
+    }
     lastTime = chron::system_clock::now();
 
     if (debugLevel > 0)
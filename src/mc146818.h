@@ -30,6 +30,7 @@
 #include "bobserv.h"
 #include "bobservd.h"
 #include "fcnffile.h"
+#include "schedule.h"
 #include <cstdint>
 #include <atomic>
 #include <string>
@@ -89,6 +90,13 @@ private:
     Byte D{0};
     std::array<Byte, 50> ram{}; // 50 bytes of internal RAM
     std::chrono::time_point<std::chrono::system_clock> lastTime;
+    // Emulated time support. If scheduler is set the periodic interrupt
+    // and the clock update are timed by device events.
+    Scheduler *scheduler{nullptr};
+    Scheduler::DeviceEventId periodicEvent{Scheduler::InvalidDeviceEventId};
+    Scheduler::DeviceEventId updateEvent{Scheduler::InvalidDeviceEventId};
+    double periodicTimeNs{}; // Periodic interrupt cycle time in ns
+    double nextPeriodicCycles{};
     int debugLevel{};
     std::ofstream cdbg;
 
@@ -123,6 +131,14 @@ public:
     };
     virtual void update_1_second();
     void UpdateFrom(NotifyId id, void *param = nullptr) override;
+    // Use emulated time, derived from the CPU cycles, instead of host time
+    // for the periodic interrupt and the clock update. It has to be called
+    // before the CPU thread is started.
+    void set_emulated_time(Scheduler *p_scheduler);
+    bool is_emulated_time() const
+    {
+        return scheduler != nullptr;
+    }
 
     static const int HOST_TIMER_ID{146818};
 
@@ -145,6 +161,10 @@ private:
     bool increment_hour(Byte &p_hour) const;
     bool increment_day(Byte &p_day, Byte p_month, Byte p_year);
     void updatePeriodicIrqRate();
+    void periodicInterrupt();
+    void schedulePeriodicEvent();
+    void scheduleUpdateEvent();
+    double cyclesPerMicrosecond() const;
 
     static std::string getConfigFilePath(Config type);
 
@@ -1499,6 +1499,18 @@ void Mc6809::reset_bp(int which)
     }
 }
 
+void Mc6809::set_trap(Word address, TrapHandler_t handler)
+{
+    traps.emplace_back(address, std::move(handler));
+    events |= Event::Trap;
+}
+
+void Mc6809::reset_traps()
+{
+    traps.clear();
+    events &= ~Event::Trap;
+}
+
 // If logFilePath is empty the current log file is closed.
 bool Mc6809::setLoggerConfig(const Mc6809LoggerConfig &loggerConfig)
 {
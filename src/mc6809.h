@@ -28,8 +28,11 @@
 #include "warnon.h"
 #include <type_traits>
 #include <atomic>
+#include <functional>
 #include <string>
 #include <array>
+#include <utility>
+#include <vector>
 
 using OptionalWord = std::optional<Word>;
 
@@ -156,7 +159,7 @@ struct Mc6809CpuStatus;
 class Mc6809 : public ScheduledCpu, public BObserver
 {
 public:
-    enum class Event : Word
+    enum class Event : DWord
     {
         NONE = 0U,
         Nmi = (1U << 0U),
@@ -171,9 +174,12 @@ public:
         SetStatus = (1U << 9U),
         FrequencyControl = (1U << 10U),
         DoSchedule = (1U << 11U),
+        Idle = (1U << 12U),
         Cwai = (1U << 13U),
         Sync = (1U << 14U),
         IgnoreBP = (1U << 15U),
+        EventDeadline = (1U << 16U),
+        Trap = (1U << 17U),
     };
 
 protected:
@@ -931,6 +937,8 @@ public:
     CpuStatusPtr create_status_object() override;
     void get_interrupt_status(tInterruptStatus &s) override;
     void set_required_cyclecount(cycles_t p_cycles) override;
+    void set_idle() override;
+    void set_event_deadline(QWord p_cycles) override;
 
     // test support
     void set_status(CpuStatus *p_cpu_status);
@@ -949,6 +957,7 @@ private:
     std::atomic<QWord> total_cycles{}; // total cycle count with 64 Bit resolution
     cycles_t cycles{}; // cycle cnt for one timer tick
     std::atomic<cycles_t> required_cyclecount{};//cycle count for freq ctrl
+    QWord event_deadline{}; // total cycle count of next device event
 
     // breakpoint support
     std::array<OptionalWord, 3> bp;
@@ -958,6 +967,27 @@ public:
     OptionalWord get_bp(int which);
     bool is_bp_set(int which);
     void reset_bp(int which);
+
+    // trap support
+    // A trap handler is called instead of executing the instruction at
+    // the trap address. It gets the CPU registers and may modify them.
+    // It returns the number of CPU cycles used or std::nullopt if the
+    // instruction at the trap address has to be executed.
+    // Traps have to be set while the CPU thread is not running.
+    // Like a breakpoint, while a trap is set the PC is compared with the
+    // trap addresses before each instruction, which slows down the
+    // emulation a bit.
+    using TrapHandler_t =
+        std::function<std::optional<cycles_t>(Mc6809CpuStatus &)>;
+    void set_trap(Word address, TrapHandler_t handler);
+    void reset_traps();
+
+private:
+    std::vector<std::pair<Word, TrapHandler_t> > traps;
+    bool exec_trap();
+    void get_registers(Mc6809CpuStatus &stat) const;
+
+public:
     // Implementation may change in future.
     // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
     bool is_alternate() const
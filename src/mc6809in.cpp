@@ -37,6 +37,13 @@ static const Mc6809::Event AnyInterrupt =
                  Mc6809::Event::Firq |
                  Mc6809::Event::Nmi;
 
+// Factor between the internal cycle count and CPU cycles.
+#ifdef ALTERNATE_MC6809
+static constexpr cycles_t CYCLE_SCALE = 10U;
+#else
+static constexpr cycles_t CYCLE_SCALE = 1U;
+#endif
+
 void Mc6809::reset()
 {
     ++interrupt_status.count[INT_RESET];
@@ -44,7 +51,7 @@ void Mc6809::reset()
     total_cycles = 0;
     nmi_armed = 0;
     /* no interrupts yet */
-    events = events & Event::FrequencyControl;
+    events = events & (Event::FrequencyControl | Event::Trap);
     reset_bp(2); // remove next-breakpoint
 
 #ifdef ALTERNATE_MC6809
@@ -112,6 +119,31 @@ QWord Mc6809::get_cycles(bool reset /* = false */)
 #endif
 }
 
+void Mc6809::get_registers(Mc6809CpuStatus &stat) const
+{
+#ifdef ALTERNATE_MC6809
+    stat.a = iareg;
+    stat.b = ibreg;
+    stat.cc = iccreg;
+    stat.dp = idpreg;
+    stat.pc = ipcreg;
+    stat.x = ixreg;
+    stat.y = iyreg;
+    stat.u = iureg;
+    stat.s = isreg;
+#else
+    stat.a = a;
+    stat.b = b;
+    stat.cc = cc.all;
+    stat.dp = dp;
+    stat.pc = pc;
+    stat.x = x;
+    stat.y = y;
+    stat.u = u;
+    stat.s = s;
+#endif
+}
+
 void Mc6809::get_status(CpuStatus *cpu_status)
 {
     InstFlg flags = InstFlg::NONE;
@@ -122,27 +154,7 @@ void Mc6809::get_status(CpuStatus *cpu_status)
     auto *stat = dynamic_cast<Mc6809CpuStatus *>(cpu_status);
     assert(stat != nullptr);
 
-#ifdef ALTERNATE_MC6809
-    stat->a = iareg;
-    stat->b = ibreg;
-    stat->cc = iccreg;
-    stat->dp = idpreg;
-    stat->pc = ipcreg;
-    stat->x = ixreg;
-    stat->y = iyreg;
-    stat->u = iureg;
-    stat->s = isreg;
-#else
-    stat->a = a;
-    stat->b = b;
-    stat->cc = cc.all;
-    stat->dp = dp;
-    stat->pc = pc;
-    stat->x = x;
-    stat->y = y;
-    stat->u = u;
-    stat->s = s;
-#endif
+    get_registers(*stat);
     Word stack_base = ((stat->s / CPU_STACK_BYTES) * CPU_STACK_BYTES) - 16;
 
     for (i = 0U; i < static_cast<Word>(sizeof(stat->instruction)); ++i)
@@ -295,8 +307,9 @@ CpuState Mc6809::runloop()
         {
             if ((events & (Event::BreakPoint | Event::Invalid |
                            Event::SingleStep | Event::SingleStepFinished |
-                           Event::FrequencyControl |
-                           Event::Cwai | Event::Sync)) != Event::NONE)
+                           Event::FrequencyControl | Event::Idle |
+                           Event::Cwai | Event::Sync | Event::Trap)) !=
+                Event::NONE)
             {
                 // All non time critical events
                 if ((events & Event::Invalid) != Event::NONE)
@@ -353,6 +366,14 @@ CpuState Mc6809::runloop()
                     }
                 }
 
+                if (((events & Event::Trap) != Event::NONE) && exec_trap())
+                {
+                    // The trap handler has been executed instead of the
+                    // instruction at the trap address.
+                    first_time = false;
+                    continue;
+                }
+
                 if ((events & Event::Cwai) != Event::NONE)
                 {
                     if ((((events & Event::Irq) != Event::NONE) && !CC_BITI) ||
@@ -387,6 +408,48 @@ CpuState Mc6809::runloop()
                     }
                 }
 
+                if ((events & Event::Idle) != Event::NONE)
+                {
+                    events &= ~Event::Idle;
+
+                    if ((events & AnyInterrupt) == Event::NONE)
+                    {
+                        // The idle loop has no side effects, so the cycles
+                        // it would have executed until the next device
+                        // event or timer tick are added at once.
+                        const bool isFrequencyControl =
+                            (events & Event::FrequencyControl) !=
+                            Event::NONE;
+                        const auto now = get_cycles();
+
+                        // Skip at most until the next device event and
+                        // continue execution afterwards. Without frequency
+                        // control there is no limit.
+                        if ((events & Event::EventDeadline) != Event::NONE &&
+                            event_deadline >= now &&
+                            (!isFrequencyControl ||
+                             (cycles < required_cyclecount &&
+                              (event_deadline - now) * CYCLE_SCALE <
+                              required_cyclecount - cycles)))
+                        {
+                            cycles += (event_deadline - now) * CYCLE_SCALE;
+                            events &= ~Event::EventDeadline;
+                            new_state = CpuState::Schedule;
+                            break;
+                        }
+
+                        if (isFrequencyControl && cycles < required_cyclecount)
+                        {
+                            cycles = required_cyclecount;
+                        }
+
+                        // No device event pending:
+                        // set CPU thread asleep until next timer tick
+                        new_state = CpuState::Suspend;
+                        break;
+                    }
+                }
+
                 if ((events & Event::FrequencyControl) != Event::NONE)
                 {
                     if (cycles >= required_cyclecount)
@@ -414,6 +477,19 @@ CpuState Mc6809::runloop()
                 new_state = CpuState::Schedule;
                 break;
             }
+
+            if (((events & Event::EventDeadline) != Event::NONE) &&
+                !first_time &&
+                !((events & (Event::SingleStep | Event::SingleStepFinished))
+                    != Event::NONE) &&
+                get_cycles() >= event_deadline)
+            {
+                // A device event is due. Return runloop with state
+                // CpuState::Schedule so that the scheduler executes it.
+                events &= ~Event::EventDeadline;
+                new_state = CpuState::Schedule;
+                break;
+            }
         }
 
         if (logger.doLogging(PC) && disassembler != nullptr)
@@ -436,6 +512,32 @@ CpuState Mc6809::runloop()
     return new_state;
 }
 
+// If there is a trap at the current PC execute its handler.
+// Return false if there is no trap or the handler did not execute it.
+bool Mc6809::exec_trap()
+{
+    for (const auto &[address, handler] : traps)
+    {
+        if (PC == address)
+        {
+            Mc6809CpuStatus regs;
+
+            get_registers(regs);
+            const auto trap_cycles = handler(regs);
+            if (!trap_cycles.has_value())
+            {
+                return false;
+            }
+
+            set_status(&regs);
+            cycles += trap_cycles.value() * CYCLE_SCALE;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void Mc6809::do_reset()
 {
     reset();
@@ -474,6 +576,29 @@ void Mc6809::set_required_cyclecount(cycles_t p_cycles)
     }
 }
 
+// Request from an idle loop detector to suspend the CPU thread
+// until the next timer tick.
+void Mc6809::set_idle()
+{
+    events |= Event::Idle;
+}
+
+// Request from the scheduler to return runloop as soon as a device event
+// is due (see Scheduler::schedule_event()).
+void Mc6809::set_event_deadline(QWord p_cycles)
+{
+    event_deadline = p_cycles;
+
+    if (p_cycles == std::numeric_limits<QWord>::max())
+    {
+        events &= ~Event::EventDeadline;
+    }
+    else
+    {
+        events |= Event::EventDeadline;
+    }
+}
+
 cycles_t Mc6809::exec_irqs(bool save_state)
 {
     if ((events & AnyInterrupt) != Event::NONE)
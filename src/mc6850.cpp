@@ -41,7 +41,10 @@ Byte Mc6850::readIo(Word offset)
     {
         case 0:
             sr &= 0x80U; // reset all bits except interrupt request
-            BSET<Byte>(sr, 1U); // Transmit data register empty is always 1
+            if (isTransmitReady())
+            {
+                BSET<Byte>(sr, 1U); // Set transmit data register empty bit
+            }
             requestInput(); // On input data set receive data register bit
             return sr; // return status register
 
@@ -68,6 +71,14 @@ void Mc6850::requestInput()
 {
 }
 
+// check if a character can be written to serial line
+// (should be overwritten by subclass)
+
+bool Mc6850::isTransmitReady()
+{
+    return true;
+}
+
 // that a character from serial line is ready to read
 
 
@@ -86,6 +86,8 @@ protected:
     virtual void set_irq();
     // request if character is ready to be read, update status register
     virtual void requestInput();
+    // check if a character can be written to serial line
+    virtual bool isTransmitReady();
 
     // Public constructor and destructor
 
@@ -43,8 +43,10 @@
 #include <functional>
 #include <array>
 #include <ostream>
+#include <fstream>
 #include <algorithm>
 #include <chrono>
+#include <filesystem>
 
 Memory::Memory(const struct sOptions &options,
                const FlexemuConfigFileSPtr &p_configFile) :
@@ -110,19 +112,16 @@ void Memory::init_memory()
     DWord i;
     Byte j;
 
-    for (i = 0; i < video_ram_size; i++)
+    // With debug option 'presetRAM' all RAM is preset in init_vram_ptr().
+    if (!isPresetRam || !isRamExtension)
     {
-        video_ram[i] = generate_random_byte(ramPattern);
-    }
-
-    for (i = 0; i < memory_size; i++)
-    {
-        memory[i] = generate_random_byte(ramPattern);
+        fill_with_pattern(video_ram.data(), video_ram_size);
+        fill_with_pattern(memory.data(), memory_size);
     }
 
     for (i = 0; i < YBLOCKS; i++)
     {
-        changed[i] = false;
+        changed[i] = 0U;
     }
 
     // initialize default pointer for mmu configuration
@@ -217,10 +216,24 @@ void Memory::init_blocks_to_update()
 
     for (display_block = 0; display_block < YBLOCKS; display_block++)
     {
-        changed[display_block] = true;
+        changed[display_block] = ALL_CONSUMERS;
+    }
+
+    if (!isVideoRamChangeNotified)
+    {
+        notify_video_ram_changed();
     }
 }
 
+// Notify observers that video RAM has changed. Observers are only
+// notified once until the changed blocks are reset. This allows a
+// video display to idle as long as video RAM does not change.
+void Memory::notify_video_ram_changed()
+{
+    isVideoRamChangeNotified = true;
+    Notify(NotifyId::VideoRamChanged);
+}
+
 // Add an I/O device to the address space
 // device       The device to be added
 // base_address The base address of the device
@@ -246,6 +259,8 @@ bool Memory::add_io_device(
         return false;
     }
 
+    auto statistics = std::make_shared<IoDeviceStatistics>(sizeOfIo,
+            device.getHostLatency());
     struct ioDeviceProperties properties{
             device.getName(),
             device.getDescription(),
@@ -255,7 +270,8 @@ bool Memory::add_io_device(
             {
                 base_address,
                 static_cast<Word>(base_address + size.value() - 1U)
-            }};
+            },
+            statistics};
     devicesProperties.emplace_back(properties);
     devicesPropertiesSorted = false;
 
@@ -276,6 +292,7 @@ bool Memory::add_io_device(
         return false; // No more I/O devices allowed.
     }
     ioDevices.push_back(std::ref(device));
+    ioStatistics.push_back(std::move(statistics));
 
     // To access a device store the device index and it's byte offset
     // in a vector. The vector index is the address - genio_base.
@@ -292,11 +309,17 @@ bool Memory::add_io_device(
     return true;
 }
 
+void Memory::set_idle_loop_detector(IdleLoopDetector *p_idleLoopDetector)
+{
+    idleLoopDetector = p_idleLoopDetector;
+}
+
 void Memory::reset_io()
 {
-    for (auto deviceRef : ioDevices)
+    for (std::size_t index = 0U; index < ioDevices.size(); ++index)
     {
-        deviceRef.get().resetIo();
+        ioStatistics[index]->CountReset();
+        ioDevices[index].get().resetIo();
     }
     sort_devices_properties();
 }
@@ -381,6 +404,17 @@ void Memory::UpdateFrom(NotifyId id, void *param)
         ramBank = *static_cast<Byte *>(param);
         init_blocks_to_update();
     }
+    else if (id == NotifyId::WriteIoStatistics && param != nullptr)
+    {
+        auto &request = *static_cast<IoStatisticsRequest_t *>(param);
+        std::ofstream ofs(fs::u8path(request.filePath));
+
+        if (ofs.is_open())
+        {
+            write_io_statistics(ofs);
+        }
+        request.isAccepted = ofs.is_open() && ofs.good();
+    }
 }
 
 void Memory::CopyFrom(const Byte *source, DWord address, DWord size)
@@ -447,6 +481,19 @@ DevicesProperties_t Memory::get_devices_properties() const
     return devicesProperties;
 }
 
+void Memory::write_io_statistics(std::ostream &os) const
+{
+    os << "[\n";
+    for (std::size_t index = 0U; index < devicesProperties.size(); ++index)
+    {
+        const auto &properties = devicesProperties[index];
+
+        os << "  " << properties.statistics->ToJson(properties.name) <<
+              (index + 1U < devicesProperties.size() ? ",\n" : "\n");
+    }
+    os << "]\n";
+}
+
 void Memory::sort_devices_properties()
 {
     if (!devicesPropertiesSorted)
@@ -461,59 +508,40 @@ void Memory::sort_devices_properties()
     }
 }
 
-Byte Memory::generate_random_byte(RamPattern p_ramPattern)
+// Fill memory with the configured RAM pattern.
+// The memory is filled in bulk, for random patterns a table of random bytes
+// with the requested probability of bits set is created once, afterwards
+// each 64-bit random number selects six bytes out of this table.
+void Memory::fill_with_pattern(Byte *data, DWord size)
 {
-    static bool isInitialized = false;
-    static Byte lineValue = 0U;
-    static Byte lineCount = 0U;
-    static std::array<Byte, 1024> values{};
-    static std::random_device rd;
-    static std::minstd_rand0 gen(rd());
-    static constexpr const unsigned a = 1664525;
-    static constexpr const unsigned c = 1013904223;
-
-    if (!isInitialized && p_ramPattern >= RamPattern::Random10 &&
-        p_ramPattern <= RamPattern::Random90)
-    {
-        using T = std::underlying_type_t<RamPattern>;
-
-        const auto propability = 1U + static_cast<T>(p_ramPattern) -
-         static_cast<T>(RamPattern::Random10);
-        double probability_bit_set = propability * 0.1;
-        std::bernoulli_distribution bit_distrib(probability_bit_set);
-
-        // Initialize values array with a given probability of bits set.
-        for (auto &value : values)
-        {
-            std::uint8_t byte = 0U;
+    static constexpr DWord lineSize = 64U;
+    static constexpr unsigned indexBits = 10U;
+    static constexpr unsigned indicesPerRandom = 64U / indexBits;
 
-            for (std::uint8_t mask = 1U; mask != 0U; mask <<= 1U)
-            {
-                if (bit_distrib(gen))
-                {
-                    byte |= mask;
-                }
-            }
-            value = byte;
-        }
-        isInitialized = true;
+    if (size == 0U)
+    {
+        return;
     }
 
-    switch (p_ramPattern)
+    switch (ramPattern)
     {
         case RamPattern::AllZero:
-            return 0x00U;
+            std::memset(data, 0x00, size);
+            return;
 
         case RamPattern::AllOne:
-            return 0xFFU;
+            std::memset(data, 0xFF, size);
+            return;
 
         case RamPattern::Lines64:
-            if (++lineCount == 64U)
+            for (DWord offset = 0U; offset < size; offset += lineSize)
             {
-                lineCount = 0U;
-                lineValue = lineValue ? 0x00U : 0xFFU;
+                const int value = ((offset / lineSize) & 1U) ? 0xFF : 0x00;
+
+                std::memset(data + offset, value,
+                            std::min(lineSize, size - offset));
             }
-            return lineValue;
+            return;
 
         case RamPattern::Random10:
         case RamPattern::Random20:
@@ -524,13 +552,50 @@ Byte Memory::generate_random_byte(RamPattern p_ramPattern)
         case RamPattern::Random70:
         case RamPattern::Random80:
         case RamPattern::Random90:
-            // Linear congruential generator (LCG). Use paramtrization from
-            // Knuth and H. W. Lewis.
-            random_seed = a * random_seed + c;
-            return values[random_seed % (values.size() - 1U)];
+            break;
+    }
+
+    using T = std::underlying_type_t<RamPattern>;
+    std::array<Byte, 1U << indexBits> values{};
+    std::minstd_rand0 gen(random_seed);
+    const auto probability = 1U + static_cast<T>(ramPattern) -
+        static_cast<T>(RamPattern::Random10);
+    std::bernoulli_distribution bit_distrib(probability * 0.1);
+
+    // Initialize values array with a given probability of bits set.
+    for (auto &value : values)
+    {
+        Byte byte = 0U;
+
+        for (Byte mask = 1U; mask != 0U; mask <<= 1U)
+        {
+            if (bit_distrib(gen))
+            {
+                byte |= mask;
+            }
+        }
+        value = byte;
     }
 
-    return 0x00U;
+    // xorshift64* pseudo random number generator, for details see:
+    // https://en.wikipedia.org/wiki/Xorshift#xorshift*
+    QWord state = (static_cast<QWord>(random_seed) << 32U) | 0x9E3779B9U;
+    DWord offset = 0U;
+
+    while (offset < size)
+    {
+        state ^= state >> 12U;
+        state ^= state << 25U;
+        state ^= state >> 27U;
+        auto random = state * 0x2545F4914F6CDD1DULL;
+
+        for (unsigned n = 0U; n < indicesPerRandom && offset < size; ++n)
+        {
+            data[offset++] = values[random & (values.size() - 1U)];
+            random >>= indexBits;
+        }
+    }
+    random_seed = static_cast<unsigned>(state);
 }
 
 std::optional<RamPattern> Memory::Convert(const std::string &ramPattern)
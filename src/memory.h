@@ -32,8 +32,11 @@
 #include "memsrc.h"
 #include "memtgt.h"
 #include "bobserv.h"
+#include "bobservd.h"
 #include "bintervl.h"
 #include "fcnffile.h"
+#include "idleloop.h"
+#include "iostat.h"
 #include <optional>
 #include <functional>
 #include <memory>
@@ -64,6 +67,7 @@ struct ioDeviceProperties
     std::string classDescription;
     std::string vendor;
     BInterval<Word> addressRange;
+    std::shared_ptr<const IoDeviceStatistics> statistics;
 };
 
 enum class RamPattern : uint8_t
@@ -85,7 +89,7 @@ enum class RamPattern : uint8_t
 using DevicesProperties_t = std::vector<struct ioDeviceProperties>;
 
 class Memory : public MemorySource<DWord>, public MemoryTarget<DWord>,
-               public BObserver
+               public BObserver, public BObserved
 {
 public:
     explicit Memory(const struct sOptions &options,
@@ -112,21 +116,35 @@ private:
 
     // I/O device access
     std::vector<std::reference_wrapper<IoDevice> > ioDevices;
+    std::vector<std::shared_ptr<IoDeviceStatistics> > ioStatistics;
     std::vector<ioDeviceAccess> deviceAccess;
     DevicesProperties_t devicesProperties;
     bool devicesPropertiesSorted{false};
     static const Byte NO_DEVICE = 0xFF;
+    static const Byte ALL_CONSUMERS = 0xFF;
+
+    static Byte consumer_bit(VideoRamConsumer consumer)
+    {
+        return static_cast<Byte>(1U << static_cast<unsigned>(consumer));
+    }
 
     // interface to video display
     std::array<Byte *, MAX_VRAM> vram_ptrs{};
     Word video_ram_active_bits{0}; // 16-bit, one for each video memory page
-    std::array<bool, YBLOCKS> changed{};
+    // One changed bit for each VideoRamConsumer.
+    std::array<Byte, YBLOCKS> changed{};
+    // true if observers have been notified about a video RAM change
+    // which has not been reset yet. Only accessed from the CPU thread.
+    bool isVideoRamChangeNotified{false};
+    // Optional idle loop detection, nullptr if not active.
+    IdleLoopDetector *idleLoopDetector{nullptr};
 
 private:
     void init_memory();
     void init_vram_ptr(Byte vram_ptr_index, Byte *ram_ptr);
     void sort_devices_properties();
-    Byte generate_random_byte(RamPattern p_ramPattern);
+    void fill_with_pattern(Byte *data, DWord size);
+    void notify_video_ram_changed();
     static std::optional<RamPattern> Convert(const std::string &ramPattern);
 
 public:
@@ -134,6 +152,9 @@ public:
     bool add_io_device(IoDevice &device, Word base_address,
             std::optional<Word> size = std::nullopt);
 
+    // Activate idle loop detection. If nullptr it is deactivated.
+    void set_idle_loop_detector(IdleLoopDetector *p_idleLoopDetector);
+
     // memory interface
     void reset_io();
     void switch_mmu(Word offset, Byte val);
@@ -145,6 +166,8 @@ public:
     // Return RAM extension size in KByte per board.
     unsigned get_ram_extension_size() const;
     DevicesProperties_t get_devices_properties() const;
+    // Write the access statistics of all I/O devices as JSON array.
+    void write_io_statistics(std::ostream &os) const;
 
     // BObserver interface
     void UpdateFrom(NotifyId id, void *param = nullptr) override;
@@ -174,7 +197,12 @@ public:
                 auto offset = access.addressOffset;
 
                 // Write one Byte to memory mapped I/O device.
+                ioStatistics[access.deviceIndex]->CountWrite(offset);
                 ioDevices[access.deviceIndex].get().writeIo(offset, value);
+                if (idleLoopDetector != nullptr)
+                {
+                    idleLoopDetector->OnStateChange();
+                }
                 return;
             }
         }
@@ -182,8 +210,18 @@ public:
         if (video_ram_active_bits &
                 (1U << (static_cast<unsigned>(address) >> 12U)))
         {
-            changed[(address & 0x3FFFU) / YBLOCK_SIZE] = true;
-            *(ppage[address >> 12U] + (address & 0x3FFFU)) = value;
+            auto &ref = *(ppage[address >> 12U] + (address & 0x3FFFU));
+
+            if (idleLoopDetector != nullptr && ref != value)
+            {
+                idleLoopDetector->OnStateChange();
+            }
+            changed[(address & 0x3FFFU) / YBLOCK_SIZE] = ALL_CONSUMERS;
+            ref = value;
+            if (!isVideoRamChangeNotified)
+            {
+                notify_video_ram_changed();
+            }
         }
         else
         {
@@ -191,11 +229,22 @@ public:
             {
                 // Use paged memory access to be able to mirror
                 // RAM banks (e.g. for Eurocom V5).
-                *(ppage[address >> 12U] + (address & 0x3FFFU)) = value;
+                auto &ref = *(ppage[address >> 12U] + (address & 0x3FFFU));
+
+                if (idleLoopDetector != nullptr && ref != value)
+                {
+                    idleLoopDetector->OnStateChange();
+                }
+                ref = value;
                 if (!isRamExtension && ((ramBank & 0x03U) != 3U) &&
                     ((address / 16384U) == (ramBank & 0x03U)))
                 {
-                    changed[(address & 0x3FFFU) / YBLOCK_SIZE] = true;
+                    changed[(address & 0x3FFFU) / YBLOCK_SIZE] =
+                        ALL_CONSUMERS;
+                    if (!isVideoRamChangeNotified)
+                    {
+                        notify_video_ram_changed();
+                    }
                 }
             }
         }
@@ -212,7 +261,15 @@ public:
                 auto offset = access.addressOffset;
 
                 // Read one Byte from memory mapped I/O device.
-                return ioDevices[access.deviceIndex].get().readIo(offset);
+                ioStatistics[access.deviceIndex]->CountRead(offset);
+                const auto value =
+                    ioDevices[access.deviceIndex].get().readIo(offset);
+
+                if (idleLoopDetector != nullptr)
+                {
+                    idleLoopDetector->OnIoRead(address, value);
+                }
+                return value;
             }
         }
 
@@ -235,14 +292,20 @@ public:
         return value;
     }
 
-    inline bool has_changed(int block_number) const
+    inline bool has_changed(int block_number,
+            VideoRamConsumer consumer = VideoRamConsumer::Display) const
     {
-        return changed[block_number];
+        return (changed[block_number] & consumer_bit(consumer)) != 0U;
     }
 
-    inline void reset_changed(int block_number)
+    // Reset the changed flag of a block. It has to be called on the
+    // CPU thread for all changed blocks, afterwards the next video RAM
+    // change is notified again.
+    inline void reset_changed(int block_number,
+            VideoRamConsumer consumer = VideoRamConsumer::Display)
     {
-        changed[block_number] = false;
+        changed[block_number] &= static_cast<Byte>(~consumer_bit(consumer));
+        isVideoRamChangeNotified = false;
     }
 
     // Get read-only access to video RAM.
@@ -0,0 +1,209 @@
+/*
+    mfilecnt.cpp
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "mfilecnt.h"
+#include "efiletim.h"
+#include "ffilecnt.h"
+#include "filecntb.h"
+#include "flexerr.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+#include <cstring>
+#include <optional>
+#include <ios>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+FlexMappedDisk::FlexMappedDisk(const fs::path &p_path,
+                               std::ios::openmode mode,
+                               const FileTimeAccess &p_fileTimeAccess)
+    : FlexDisk(p_path, mode, p_fileTimeAccess)
+{
+    if (!IsFlexFormat())
+    {
+        // This file container only supports compatible FLEX file formats.
+        throw FlexException(FERR_CONTAINER_UNFORMATTED, GetPath());
+    }
+
+    isWritable = ((mode & std::ios::out) != 0) && !IsWriteProtected();
+
+    if (!Map())
+    {
+        Unmap();
+        throw FlexException(FERR_READING_FROM, GetPath());
+    }
+
+    param.options |= DiskOptions::Mapped;
+}
+
+FlexMappedDisk::~FlexMappedDisk()
+{
+    // Errors when writing back are ignored.
+    Sync();
+    Unmap();
+}
+
+bool FlexMappedDisk::Map()
+{
+    mappingSize = GetFileSize();
+
+    if (mappingSize == 0U)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    fileHandle = CreateFileW(GetPath().wstring().c_str(),
+        GENERIC_READ | (isWritable ? GENERIC_WRITE : 0U),
+        FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    mappingHandle = CreateFileMappingW(fileHandle, nullptr,
+        isWritable ? PAGE_READWRITE : PAGE_READONLY, 0U, 0U, nullptr);
+    if (mappingHandle == nullptr)
+    {
+        return false;
+    }
+
+    mapping = static_cast<Byte *>(MapViewOfFile(mappingHandle,
+        isWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0U, 0U, mappingSize));
+#else
+    fd = open(GetPath().c_str(), isWritable ? O_RDWR : O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    void *address = mmap(nullptr, mappingSize,
+                         PROT_READ | (isWritable ? PROT_WRITE : 0),
+                         MAP_SHARED, fd, 0);
+    mapping = (address == MAP_FAILED) ? nullptr : static_cast<Byte *>(address);
+#endif
+
+    return mapping != nullptr;
+}
+
+void FlexMappedDisk::Unmap()
+{
+#ifdef _WIN32
+    if (mapping != nullptr)
+    {
+        UnmapViewOfFile(mapping);
+    }
+    if (mappingHandle != nullptr)
+    {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mappingSize);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0U;
+}
+
+// Write back all changes of the mapping and wait until finished.
+bool FlexMappedDisk::Sync()
+{
+    if (mapping == nullptr || !isWritable)
+    {
+        return true;
+    }
+
+#ifdef _WIN32
+    return FlushViewOfFile(mapping, 0U) != 0 &&
+           FlushFileBuffers(fileHandle) != 0;
+#else
+    return msync(mapping, mappingSize, MS_SYNC) == 0;
+#endif
+}
+
+std::optional<std::size_t> FlexMappedDisk::GetSectorPosition(int trk, int sec,
+        std::optional<int> side) const
+{
+    if (mapping == nullptr || !IsTrackValid(trk) || !IsSectorValid(trk, sec))
+    {
+        return std::nullopt;
+    }
+
+    const int pos = ByteOffset(trk, sec, side);
+
+    if (pos < 0 ||
+        static_cast<std::size_t>(pos) + param.byte_p_sector > mappingSize)
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<std::size_t>(pos);
+}
+
+bool FlexMappedDisk::ReadSector(Byte *pbuffer, int trk, int sec,
+                                std::optional<int> side) const
+{
+    const auto pos = GetSectorPosition(trk, sec, side);
+
+    if (!pos.has_value())
+    {
+        return false;
+    }
+
+    std::memcpy(pbuffer, mapping + pos.value(), param.byte_p_sector);
+    return true;
+}
+
+bool FlexMappedDisk::WriteSector(const Byte *pbuffer, int trk, int sec,
+                                 std::optional<int> side)
+{
+    const auto pos = GetSectorPosition(trk, sec, side);
+
+    if (!pos.has_value() || !isWritable)
+    {
+        return false;
+    }
+
+    std::memcpy(mapping + pos.value(), pbuffer, param.byte_p_sector);
+    return true;
+}
@@ -0,0 +1,84 @@
+/*
+    mfilecnt.h
+
+
+    FLEXplorer, An explorer for FLEX disk image files and directory disks.
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef MFILECNT_INCLUDED
+#define MFILECNT_INCLUDED
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "typedefs.h"
+#include "efiletim.h"
+#include "ffilecnt.h"
+#include <cstddef>
+#include <optional>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// class FlexMappedDisk is a specialization of FlexDisk where the whole disk
+// image file is mapped into memory. Reading a sector is a copy from the
+// mapping, writing a sector is a copy into the mapping which is written
+// back by the host operating system. Sync() or destruction writes back
+// all changes.
+class FlexMappedDisk : public FlexDisk
+{
+
+private:
+
+#ifdef _WIN32
+    HANDLE fileHandle{INVALID_HANDLE_VALUE};
+    HANDLE mappingHandle{nullptr};
+#else
+    int fd{-1};
+#endif
+    Byte *mapping{};
+    std::size_t mappingSize{};
+    bool isWritable{};
+
+public:
+
+    FlexMappedDisk() = delete;
+    FlexMappedDisk(const FlexMappedDisk &src) = delete;
+    FlexMappedDisk(FlexMappedDisk &&src) = delete;
+    FlexMappedDisk(const fs::path &p_path, std::ios::openmode mode,
+                   const FileTimeAccess &fileTimeAccess);
+    ~FlexMappedDisk() override;
+
+    FlexMappedDisk &operator= (const FlexMappedDisk &src) = delete;
+    FlexMappedDisk &operator= (FlexMappedDisk &&src) = delete;
+
+    bool ReadSector(Byte *buffer, int trk, int sec,
+                    std::optional<int> side = std::nullopt) const override;
+    bool WriteSector(const Byte *buffer, int trk, int sec,
+                     std::optional<int> side = std::nullopt) override;
+    bool Sync() override;
+
+private:
+    bool Map();
+    void Unmap();
+    std::optional<std::size_t> GetSectorPosition(int trk, int sec,
+                                                 std::optional<int> side) const;
+};
+
+#endif // MFILECNT_INCLUDED
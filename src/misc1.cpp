@@ -45,6 +45,9 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
 #ifdef _WIN32
 #include "cvtwchar.h"
 #endif
@@ -466,6 +469,39 @@ std::string flx::getHostName()
     return dnsHostName;
 }
 
+// Write all data of a file which is buffered by the host operating system
+// to the storage device and wait until finished. Data buffered in a stream
+// has to be flushed before.
+bool flx::syncFile(const fs::path &path)
+{
+#ifdef _WIN32
+    auto fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    const bool result = FlushFileBuffers(fileHandle) != 0;
+
+    CloseHandle(fileHandle);
+#else
+    // fsync() writes back the file, not only data written by this descriptor.
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    const bool result = fsync(fd) == 0;
+
+    close(fd);
+#endif
+
+    return result;
+}
+
 fs::path flx::getFlexemuUserConfigPath()
 {
     std::string configPath;
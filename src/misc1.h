@@ -110,6 +110,7 @@ extern fs::path getFlexemuUserConfigPath();
 extern fs::path getFlexemuConfigFile();
 extern fs::path getFlexLabelFile();
 extern std::string getHostName();
+extern bool syncFile(const fs::path &path);
 extern std::string updateFilename(std::string path,
         const std::string &defaultFilestem, const std::string &fileExtension);
 extern bool isFlexFilename(const std::string &filename);
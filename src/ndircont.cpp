@@ -36,6 +36,7 @@
 #include "filecnts.h"
 #include "filecntb.h"
 #include "fdoptman.h"
+#include "dirwatch.h"
 #include <sys/stat.h>
 #ifdef _WIN32
 #include "cvtwchar.h"
@@ -68,6 +69,7 @@
 #include <iostream>
 #include <fstream>
 #include <iterator>
+#include <thread>
 #include <algorithm>
 #include <filesystem>
 #ifdef _WIN32
@@ -105,6 +107,21 @@ namespace fs = std::filesystem;
 // But writing sectors which are part of the free chain or a directory sector
 // can corrupt the emulation.
 
+// Meta data of a host file needed to add it to the FLEX directory.
+struct s_file_metadata
+{
+    std::string filename;
+    std::uintmax_t size;
+    std::time_t mtime;
+    bool is_regular;
+    bool is_write_protected;
+};
+
+// Maximum number of host files kept open.
+static constexpr std::size_t MAX_OPEN_FILES = 16U;
+// File id used for the boot sector file.
+static constexpr SDWord BOOT_FILE_ID = std::numeric_limits<SDWord>::min();
+
 FlexDirectoryDiskBySector::FlexDirectoryDiskBySector(
         const fs::path &path,
         const FileTimeAccess &fileTimeAccess,
@@ -114,6 +131,15 @@ FlexDirectoryDiskBySector::FlexDirectoryDiskBySector(
     : directory(path)
     , randomFileCheck(path)
     , ft_access(fileTimeAccess)
+    , fileHandles(MAX_OPEN_FILES,
+            [this](SDWord file_id, const fs::path &p_path, bool isWritten){
+                if (isWritten)
+                {
+                    // The host file system changes the modification time.
+                    // Set it back to the time of the emulated file system.
+                    update_file_time(p_path, file_id);
+                }
+            })
 {
     static Word number = 0U;
 
@@ -172,6 +198,9 @@ FlexDirectoryDiskBySector::FlexDirectoryDiskBySector(
             }
         }
     }
+
+    // Files changed on the host are applied while the disk is mounted.
+    watcher = std::make_unique<DirectoryWatcher>(directory);
 }
 
 FlexDirectoryDiskBySector::~FlexDirectoryDiskBySector()
@@ -179,6 +208,7 @@ FlexDirectoryDiskBySector::~FlexDirectoryDiskBySector()
     // final cleanup: close if not already done
     try
     {
+        fileHandles.CloseAll();
         close_new_files();
         directory.clear();
     }
@@ -256,6 +286,15 @@ unsigned FlexDirectoryDiskBySector::GetBytesPerSector() const
     return param.byte_p_sector;
 }
 
+// Sectors are written into the files immediately. Closing all files
+// sets back the file times.
+bool FlexDirectoryDiskBySector::Sync()
+{
+    fileHandles.CloseAll();
+
+    return true;
+}
+
 bool FlexDirectoryDiskBySector::IsWriteProtected() const
 {
     return (attributes & WRITE_PROTECT) != 0;
@@ -706,6 +745,8 @@ void FlexDirectoryDiskBySector::close_new_files()
 // Add a file with directory index dir_idx to the link table.
 // If file won't fit return false otherwise return true.
 // On success return its first and last track/sector.
+// The sectors are allocated but the link table entries are only
+// initialized when the file is accessed first, see materialize_file().
 bool FlexDirectoryDiskBySector::add_to_link_table(
     SDWord dir_idx,
     std::uintmax_t size,
@@ -739,30 +780,8 @@ bool FlexDirectoryDiskBySector::add_to_link_table(
     begin = sis.sir.fc_start;
     auto sec_idx_begin = get_sector_index(begin);
 
-    for (Word i = 1; i <= records; ++i)
-    {
-        auto &link = flex_links[i + sec_idx_begin - 1];
-
-        if (i == records)
-        {
-            link.next = st_t{0, 0};
-        }
-
-        if (is_random)
-        {
-            Word record_nr = i > 2 ? static_cast<Word>(i - 2) : 0U;
-            flx::setValueBigEndian<Word>(link.record_nr.data(), record_nr);
-        }
-        else
-        {
-            Word record_nr = i;
-            flx::setValueBigEndian<Word>(link.record_nr.data(), record_nr);
-        }
-
-        link.f_record = static_cast<Word>(i - 1);
-        link.file_id = dir_idx;
-        link.type = SectorType::File;
-    }
+    // Files are added in ascending order of sector indices.
+    lazy_files.push_back({dir_idx, sec_idx_begin, records, size, is_random});
 
     auto sec_idx_end = static_cast<SDWord>(sec_idx_begin + records - 1);
     end.sec = static_cast<Byte>((sec_idx_end % param.max_sector) + 1);
@@ -788,6 +807,76 @@ bool FlexDirectoryDiskBySector::add_to_link_table(
 }
 
 
+// If sector index sec_idx belongs to a file which link table entries have
+// not been initialized yet, initialize them. For a random file also
+// create its sector map.
+void FlexDirectoryDiskBySector::materialize_file(SDWord sec_idx) const
+{
+    if (sec_idx < 0 || lazy_files.empty())
+    {
+        return;
+    }
+
+    auto iter = std::upper_bound(lazy_files.begin(), lazy_files.end(),
+            sec_idx, [](SDWord index, const s_lazy_file &file){
+                return index < file.sec_idx_begin;
+            });
+
+    if (iter == lazy_files.begin())
+    {
+        return;
+    }
+
+    --iter;
+    if (sec_idx >= iter->sec_idx_begin + iter->records)
+    {
+        return;
+    }
+
+    const auto file = *iter;
+    lazy_files.erase(iter);
+
+    for (Word i = 1; i <= file.records; ++i)
+    {
+        auto &link = flex_links[i + file.sec_idx_begin - 1];
+
+        if (i == file.records)
+        {
+            link.next = st_t{0, 0};
+        }
+
+        if (file.is_random)
+        {
+            Word record_nr = i > 2 ? static_cast<Word>(i - 2) : 0U;
+            flx::setValueBigEndian<Word>(link.record_nr.data(), record_nr);
+        }
+        else
+        {
+            Word record_nr = i;
+            flx::setValueBigEndian<Word>(link.record_nr.data(), record_nr);
+        }
+
+        link.f_record = static_cast<Word>(i - 1);
+        link.file_id = file.dir_idx;
+        link.type = SectorType::File;
+    }
+
+    if (file.is_random)
+    {
+        const auto path = get_path_of_file(file.dir_idx);
+        const st_t begin{
+            static_cast<Byte>(file.sec_idx_begin / param.max_sector),
+            static_cast<Byte>((file.sec_idx_begin % param.max_sector) + 1)};
+
+        fileHandles.Close(file.dir_idx);
+        sector_maps.emplace(file.dir_idx,
+                            create_sector_map(path, file.size, begin));
+        // Writing the sector map changes the modification time.
+        update_file_time(path, file.dir_idx);
+    }
+}
+
+
 // Add file properties to directory entry with index 'dir_idx'.
 void FlexDirectoryDiskBySector::add_to_directory(
     std::string name,
@@ -798,7 +887,7 @@ void FlexDirectoryDiskBySector::add_to_directory(
     std::uintmax_t file_size,
     const st_t &begin,
     const st_t &end,
-    bool is_file_wp)
+    bool is_file_wp) const
 {
     const bool setFileTime =
         (ft_access & FileTimeAccess::Set) == FileTimeAccess::Set;
@@ -834,7 +923,8 @@ void FlexDirectoryDiskBySector::add_to_directory(
 }
 
 SectorMap_t FlexDirectoryDiskBySector::create_sector_map(
-        const fs::path &path, std::uintmax_t file_size, const st_t &begin)
+        const fs::path &path, std::uintmax_t file_size,
+        const st_t &begin) const
 {
     SectorMap_t sectorMap{};
 
@@ -874,6 +964,75 @@ SectorMap_t FlexDirectoryDiskBySector::create_sector_map(
 }
 
 
+// Read the meta data of all files. With thousands of files this takes
+// a noticeable time, especially on network file systems, so it is done
+// on several threads in parallel.
+static void read_file_metadata(const fs::path &directory,
+                               std::vector<s_file_metadata> &files)
+{
+    constexpr std::size_t min_files_per_thread = 64U;
+    const auto read_range = [&](std::size_t begin, std::size_t end)
+    {
+        for (auto index = begin; index < end; ++index)
+        {
+            auto &file = files[index];
+            const auto path = directory / file.filename;
+
+#ifdef _WIN32
+            std::error_code error;
+            const auto status = fs::status(path, error);
+
+            file.is_regular = !error && fs::is_regular_file(status);
+            if (file.is_regular)
+            {
+                file.size = fs::file_size(path, error);
+                file.mtime = flx::to_time_t(fs::last_write_time(path, error));
+                file.is_write_protected =
+                    (_waccess(path.wstring().c_str(), W_OK) != 0);
+                file.is_regular = !error;
+            }
+#else
+            struct stat sbuf{};
+
+            file.is_regular = stat(path.u8string().c_str(), &sbuf) == 0 &&
+                              S_ISREG(sbuf.st_mode);
+            if (file.is_regular)
+            {
+                file.size = static_cast<std::uintmax_t>(sbuf.st_size);
+                file.mtime = sbuf.st_mtime;
+                file.is_write_protected =
+                    (access(path.u8string().c_str(), W_OK) != 0);
+            }
+#endif
+        }
+    };
+
+    const auto count = files.size();
+    const auto thread_count = std::min<std::size_t>(
+        std::max(std::thread::hardware_concurrency(), 1U),
+        (count + min_files_per_thread - 1U) / min_files_per_thread);
+
+    if (thread_count <= 1U)
+    {
+        read_range(0U, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    const auto files_per_thread = (count + thread_count - 1U) / thread_count;
+
+    for (std::size_t begin = 0U; begin < count; begin += files_per_thread)
+    {
+        threads.emplace_back(read_range, begin,
+                             std::min(begin + files_per_thread, count));
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
 // Create a directory entry for each file for which the file name
 // is identified as a FLEX file name. See isFlexFilename for details.
 // If IsWriteProtected() returns true the drive is write protected.
@@ -883,12 +1042,13 @@ SectorMap_t FlexDirectoryDiskBySector::create_sector_map(
 // - If files just differ in case sensitivity only the first one is used.
 //   (This can happen for case sensitive file systems only).
 // - There is space left for the file itself and it's directory entry.
+// The link table entries and the sector map of random files are
+// initialized when a file is accessed first, see materialize_file().
 void FlexDirectoryDiskBySector::fill_flex_directory()
 {
-    std::vector<std::string> filenames; // List of to be added files
+    std::vector<s_file_metadata> files; // List of to be added files
     std::unordered_set<std::string> lc_filenames; // Compare lower case filen.
     std::string fname;
-    fs::path path;
 
     auto add_file = [&](const std::string &filename)
     {
@@ -897,7 +1057,7 @@ void FlexDirectoryDiskBySector::fill_flex_directory()
         if (flx::isFlexFilename(filename) &&
             lc_filenames.find(lc_filename) == lc_filenames.end())
         {
-            filenames.emplace_back(filename);
+            files.push_back({filename, 0U, 0, false, false});
             lc_filenames.emplace(lc_filename);
         }
     };
@@ -920,8 +1080,9 @@ void FlexDirectoryDiskBySector::fill_flex_directory()
     {
         fname = flx::tolower(ConvertToUtf8String(pentry.cFileName));
 
-        const auto status = fs::status(directory / fname);
-        if (!exists(status) || !fs::is_regular_file(status))
+        // The file attributes are part of the directory entry.
+        if ((pentry.dwFileAttributes &
+             (FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_DEVICE)) != 0)
         {
             continue;
         }
@@ -946,8 +1107,19 @@ void FlexDirectoryDiskBySector::fill_flex_directory()
     {
         fname = pentry->d_name;
 
-        const auto status = fs::status(directory / fname);
-        if (!fs::exists(status) || !fs::is_regular_file(status))
+        bool is_regular_file = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+        // If supported the file type is part of the directory entry.
+        is_regular_file = (pentry->d_type == DT_REG);
+        if (pentry->d_type == DT_UNKNOWN || pentry->d_type == DT_LNK)
+#endif
+        {
+            // Symbolic links are followed.
+            const auto status = fs::status(directory / fname);
+            is_regular_file =
+                fs::exists(status) && fs::is_regular_file(status);
+        }
+        if (!is_regular_file)
         {
             continue;
         }
@@ -959,52 +1131,38 @@ void FlexDirectoryDiskBySector::fill_flex_directory()
 #endif
 
     // Sort all filenames before adding them to the container.
-    std::sort(filenames.begin(), filenames.end());
+    std::sort(files.begin(), files.end(),
+            [](const s_file_metadata &lhs, const s_file_metadata &rhs){
+                return lhs.filename < rhs.filename;
+            });
 
-    for (const auto &filename : filenames)
+    read_file_metadata(directory, files);
+
+    for (const auto &file : files)
     {
+        if (!file.is_regular)
+        {
+            continue;
+        }
+
         const auto dir_idx = next_free_dir_entry();
-        if (dir_idx >= 0)
+        if (dir_idx < 0)
         {
-            st_t begin;
-            st_t end;
-            path = directory / filename;
-            bool is_random = randomFileCheck.IsRandomFile(filename);
+            break;
+        }
 
-            const auto status = fs::status(path);
-            if (!fs::exists(status) || !fs::is_regular_file(status))
-            {
-                continue;
-            }
-            const auto file_size = fs::file_size(path);
-            if (add_to_link_table(dir_idx, file_size, is_random, begin, end))
-            {
-                const auto pFilename(fs::u8path(flx::toupper(filename)));
-                const auto name(pFilename.stem().u8string());
-                auto extension(pFilename.extension().u8string().substr(1));
-                bool is_file_wp =
-#ifdef _WIN32
-                    (_waccess(path.wstring().c_str(), W_OK) != 0);
-#else
-                    (access(path.u8string().c_str(), W_OK) != 0);
-#endif
-                const auto ftime = fs::last_write_time(path);
-                const auto mtime = flx::to_time_t(ftime);
-                add_to_directory(name, extension,
-                                 dir_idx, is_random, mtime, file_size,
-                                 begin, end, is_file_wp);
+        st_t begin;
+        st_t end;
+        bool is_random = randomFileCheck.IsRandomFile(file.filename);
 
-                if (is_random)
-                {
-                    auto sector_map =
-                        create_sector_map(path.u8string(), file_size, begin);
-                    sector_maps.emplace(dir_idx, sector_map);
-                }
-            }
-        }
-        else
+        if (add_to_link_table(dir_idx, file.size, is_random, begin, end))
         {
-            break;
+            const auto pFilename(fs::u8path(flx::toupper(file.filename)));
+            const auto name(pFilename.stem().u8string());
+            auto extension(pFilename.extension().u8string().substr(1));
+            add_to_directory(name, extension,
+                             dir_idx, is_random, file.mtime, file.size,
+                             begin, end, file.is_write_protected);
         }
     }
 
@@ -1113,12 +1271,15 @@ void FlexDirectoryDiskBySector::check_for_delete(Word ds_idx,
             auto sec_idx = get_sector_index(track_sector);
             std::error_code error;
 
+            materialize_file(sec_idx);
+
             if (old_dir_sector.dir_entries[i].sector_map & IS_RANDOM_FILE)
             {
                 randomFileCheck.RemoveFromRandomList(filename);
                 randomFileCheck.UpdateRandomListToFile();
                 sector_maps.erase(flex_links[sec_idx].file_id);
             }
+            fileHandles.Close(dir_idx);
             fs::remove(directory / filename, error);
             change_file_id_and_type(sec_idx, dir_idx, 0, SectorType::FreeChain);
 #ifdef DEBUG_FILE
@@ -1152,6 +1313,7 @@ void FlexDirectoryDiskBySector::check_for_rename(Word ds_idx,
         {
             std::error_code error;
 
+            fileHandles.Close(dir_idx);
             fs::rename(directory / old_filename, directory / new_filename,
                        error);
             if (dir_sector.dir_entries[i].sector_map & IS_RANDOM_FILE)
@@ -1228,6 +1390,7 @@ void FlexDirectoryDiskBySector::check_for_changed_file_attr(Word ds_idx,
             auto file_attr = dir_sector.dir_entries[i].file_attr;
             const char *set_clear = nullptr;
             const auto path = directory / filename;
+            fileHandles.Close(dir_idx);
             if (fs::exists(path))
             {
                 if (file_attr & WRITE_PROTECT)
@@ -1345,6 +1508,7 @@ void FlexDirectoryDiskBySector::check_for_new_file(Word ds_idx,
                 }
 
                 keys.push_back(iter.first);
+                fileHandles.Close(iter.first);
                 const auto dir_idx = dir_idx0 + i;
                 auto sec_idx = get_sector_index(iter.second.first);
                 change_file_id_and_type(sec_idx, iter.first,
@@ -1400,6 +1564,347 @@ void FlexDirectoryDiskBySector::check_for_new_file(Word ds_idx,
     }
 }
 
+// Apply all files created, deleted, renamed or resized on the host since
+// the last call to the emulated directory and link table.
+// The contents of files is always read from the host files, so only
+// changes of the number of sectors have to be applied.
+// Limitations: Random files are not added or resized, the directory is
+// not extended.
+void FlexDirectoryDiskBySector::apply_host_changes() const
+{
+    auto changes = watcher->TakeChanges();
+
+    if (changes.isOverflow)
+    {
+        // Changes got lost, check all files.
+        std::error_code error;
+
+        for (const auto &entry : fs::directory_iterator(directory, error))
+        {
+            changes.filenames.emplace(entry.path().filename().u8string());
+        }
+
+        for (SDWord dir_idx = 0;
+             dir_idx < static_cast<SDWord>(flex_directory.size() * DIRENTRIES);
+             ++dir_idx)
+        {
+            auto filename = get_unix_filename(dir_idx);
+
+            if (!filename.empty())
+            {
+                changes.filenames.emplace(std::move(filename));
+            }
+        }
+    }
+
+    for (const auto &filename : changes.filenames)
+    {
+        if (flx::isFlexFilename(filename))
+        {
+            update_from_host(filename);
+        }
+    }
+}
+
+// Compare a file on the host with its directory entry and update the
+// directory entry and link table if needed.
+void FlexDirectoryDiskBySector::update_from_host(
+        const std::string &filename) const
+{
+    std::vector<s_file_metadata> files{{filename, 0U, 0, false, false}};
+    read_file_metadata(directory, files);
+    const auto &file = files[0];
+    const auto dir_idx = find_dir_idx(filename);
+
+    if (dir_idx >= 0)
+    {
+        // The file has been changed or replaced on the host, a cached
+        // file handle may still refer to the previous file.
+        fileHandles.Close(dir_idx);
+    }
+
+    if (!file.is_regular)
+    {
+        if (dir_idx >= 0)
+        {
+            delete_host_file(dir_idx);
+        }
+
+        return;
+    }
+
+    const auto records = static_cast<Word>((file.size + (DBPS - 1)) / DBPS);
+
+    if (dir_idx < 0)
+    {
+        add_host_file(file, records);
+        return;
+    }
+
+    const auto &dir_entry =
+      flex_directory[dir_idx / DIRENTRIES].dir_entries[dir_idx % DIRENTRIES];
+    if ((dir_entry.sector_map & IS_RANDOM_FILE) == 0 &&
+        flx::getValueBigEndian<Word>(&dir_entry.records[0]) != records)
+    {
+        resize_host_file(dir_idx, file, records);
+    }
+}
+
+// Return the directory index of a file or -1 if not found.
+SDWord FlexDirectoryDiskBySector::find_dir_idx(
+        const std::string &filename) const
+{
+    const auto lc_filename = flx::tolower(filename);
+
+    for (SDWord dir_idx = 0;
+         dir_idx < static_cast<SDWord>(flex_directory.size() * DIRENTRIES);
+         ++dir_idx)
+    {
+        if (get_unix_filename(dir_idx) == lc_filename)
+        {
+            return dir_idx;
+        }
+    }
+
+    return -1;
+}
+
+// A file has been created on the host. Add it to a free or deleted
+// directory entry.
+void FlexDirectoryDiskBySector::add_host_file(const s_file_metadata &file,
+                                              Word records) const
+{
+    if (randomFileCheck.IsRandomFile(file.filename))
+    {
+        return;
+    }
+
+    SDWord dir_idx = -1;
+
+    for (SDWord idx = 0;
+         idx < static_cast<SDWord>(flex_directory.size() * DIRENTRIES); ++idx)
+    {
+        const auto first = flex_directory[idx / DIRENTRIES]
+                               .dir_entries[idx % DIRENTRIES].filename[0];
+
+        if (first == DE_EMPTY || first == DE_DELETED)
+        {
+            dir_idx = idx;
+            break;
+        }
+    }
+
+    st_t begin{};
+    st_t end{};
+
+    if (dir_idx < 0 || !allocate_sectors(dir_idx, 0U, records, begin, end))
+    {
+        return;
+    }
+
+    const auto pFilename(fs::u8path(flx::toupper(file.filename)));
+    add_to_directory(pFilename.stem().u8string(),
+                     pFilename.extension().u8string().substr(1),
+                     dir_idx, false, file.mtime, file.size, begin, end,
+                     file.is_write_protected);
+#ifdef DEBUG_FILE
+    LOG_X("      host added {}\n", file.filename);
+#endif
+}
+
+// A file has been deleted on the host. Mark its directory entry as deleted
+// and add its sectors to the free chain.
+void FlexDirectoryDiskBySector::delete_host_file(SDWord dir_idx) const
+{
+    auto &dir_entry =
+      flex_directory[dir_idx / DIRENTRIES].dir_entries[dir_idx % DIRENTRIES];
+    const auto sec_idx = get_sector_index(dir_entry.start);
+
+    materialize_file(sec_idx);
+    if (dir_entry.sector_map & IS_RANDOM_FILE)
+    {
+        randomFileCheck.RemoveFromRandomList(get_unix_filename(dir_idx));
+        randomFileCheck.UpdateRandomListToFile();
+        sector_maps.erase(dir_idx);
+    }
+    free_sectors(sec_idx);
+    dir_entry.filename[0] = DE_DELETED;
+#ifdef DEBUG_FILE
+    LOG_X("      host deleted {}\n", get_unix_filename(dir_entry));
+#endif
+}
+
+// The number of sectors of a file has changed on the host. Sectors are
+// added to or removed from the end of the file, so the sectors at the
+// beginning keep their track and sector.
+void FlexDirectoryDiskBySector::resize_host_file(SDWord dir_idx,
+        const s_file_metadata &file, Word records) const
+{
+    const auto &dir_entry =
+      flex_directory[dir_idx / DIRENTRIES].dir_entries[dir_idx % DIRENTRIES];
+    const auto old_records =
+        flx::getValueBigEndian<Word>(&dir_entry.records[0]);
+    auto begin = dir_entry.start;
+    auto end = dir_entry.end;
+
+    materialize_file(get_sector_index(begin));
+
+    if (records == 0U)
+    {
+        free_sectors(get_sector_index(begin));
+        begin = end = st_t{0, 0};
+    }
+    else if (records < old_records)
+    {
+        auto sec_idx = get_sector_index(begin);
+
+        for (Word i = 1; i < records; ++i)
+        {
+            sec_idx = get_sector_index(flex_links[sec_idx].next);
+        }
+
+        auto &link = flex_links[sec_idx];
+        const auto next_idx = get_sector_index(link.next);
+
+        link.next = st_t{0, 0};
+        free_sectors(next_idx);
+        end = get_track_sector(sec_idx);
+    }
+    else
+    {
+        st_t new_begin{};
+        st_t new_end{};
+
+        if (!allocate_sectors(dir_idx, old_records,
+                    static_cast<Word>(records - old_records),
+                    new_begin, new_end))
+        {
+            return;
+        }
+
+        if (old_records == 0U)
+        {
+            begin = new_begin;
+        }
+        else
+        {
+            flex_links[get_sector_index(end)].next = new_begin;
+        }
+        end = new_end;
+    }
+
+    const auto pFilename(fs::u8path(flx::toupper(file.filename)));
+    add_to_directory(pFilename.stem().u8string(),
+                     pFilename.extension().u8string().substr(1),
+                     dir_idx, false, file.mtime, file.size, begin, end,
+                     file.is_write_protected);
+#ifdef DEBUG_FILE
+    LOG_XX("      host resized {} to {} sectors\n", file.filename, records);
+#endif
+}
+
+// Take count sectors from the beginning of the free chain and link them
+// to a file with directory index dir_idx. first_record is the zero based
+// record number of the first sector.
+// Return false if there are not enough free sectors.
+bool FlexDirectoryDiskBySector::allocate_sectors(SDWord dir_idx,
+        Word first_record, Word count, st_t &begin, st_t &end) const
+{
+    auto &sis = flex_sys_info[0];
+    auto free = flx::getValueBigEndian<Word>(&sis.sir.free[0]);
+
+    if (count == 0U)
+    {
+        begin = end = st_t{0, 0};
+        return true;
+    }
+
+    if (count > free)
+    {
+        return false;
+    }
+
+    begin = sis.sir.fc_start;
+    auto sec_idx = get_sector_index(begin);
+
+    for (Word i = 0U; i < count; ++i)
+    {
+        auto &link = flex_links[sec_idx];
+        const auto record = static_cast<Word>(first_record + i);
+
+        flx::setValueBigEndian<Word>(link.record_nr.data(),
+                                     static_cast<Word>(record + 1U));
+        link.f_record = record;
+        link.file_id = dir_idx;
+        link.type = SectorType::File;
+
+        if (i + 1U == count)
+        {
+            end = get_track_sector(sec_idx);
+            sis.sir.fc_start = link.next;
+            link.next = st_t{0, 0};
+        }
+        else
+        {
+            sec_idx = get_sector_index(link.next);
+        }
+    }
+
+    free -= count;
+    flx::setValueBigEndian<Word>(&sis.sir.free[0], free);
+    if (free == 0U)
+    {
+        // No space left => no more free chain sectors available.
+        sis.sir.fc_start = st_t{ };
+        sis.sir.fc_end = st_t{ };
+    }
+
+    return true;
+}
+
+// Add the chain of sectors starting with sector index sec_idx to the end of
+// the free chain.
+void FlexDirectoryDiskBySector::free_sectors(SDWord sec_idx) const
+{
+    auto &sis = flex_sys_info[0];
+    auto free = flx::getValueBigEndian<Word>(&sis.sir.free[0]);
+    const auto first_idx = sec_idx;
+    SDWord last_idx = -1;
+    Word count = 0U;
+
+    // The count protects from endless loops based on wrong sector links.
+    while (sec_idx >= 0 && count < flex_links.size())
+    {
+        auto &link = flex_links[sec_idx];
+
+        flx::setValueBigEndian<Word>(link.record_nr.data(), 0U);
+        link.f_record = 0U;
+        link.file_id = std::numeric_limits<SDWord>::max();
+        link.type = SectorType::FreeChain;
+        last_idx = sec_idx;
+        ++count;
+        sec_idx = get_sector_index(link.next);
+    }
+
+    if (count == 0U)
+    {
+        return;
+    }
+
+    if (free == 0U)
+    {
+        sis.sir.fc_start = get_track_sector(first_idx);
+    }
+    else
+    {
+        flex_links[get_sector_index(sis.sir.fc_end)].next =
+            get_track_sector(first_idx);
+    }
+    sis.sir.fc_end = get_track_sector(last_idx);
+    free += count;
+    flx::setValueBigEndian<Word>(&sis.sir.free[0], free);
+}
+
 // Check if track and sector is the last sector in the free chain.
 bool FlexDirectoryDiskBySector::is_last_of_free_chain(
                              const st_t &track_sector) const
@@ -1435,6 +1940,18 @@ bool FlexDirectoryDiskBySector::ReadSector(Byte *buffer, int trk, int sec,
     }
 
     auto sec_idx = get_sector_index(track_sector);
+
+    // Host changes are applied before the guest reads a directory or
+    // system info sector, but not while a new file is written.
+    const auto type = flex_links[sec_idx].type;
+    if ((type == SectorType::Directory || type == SectorType::SystemInfo) &&
+        watcher &&
+        watcher->HasChanges() && new_files.empty())
+    {
+        apply_host_changes();
+    }
+
+    materialize_file(sec_idx);
     const auto &link = flex_links[sec_idx];
 
 #ifdef DEBUG_FILE
@@ -1477,26 +1994,27 @@ bool FlexDirectoryDiskBySector::ReadSector(Byte *buffer, int trk, int sec,
 
                 const auto path = directory / bootSectorFile;
                 bool set_default_boot_code = true;
-                std::ifstream ifs(path, std::ios::in | std::ios::binary);
 
                 std::memset(buffer, 0, SECTOR_SIZE);
-                if (ifs.is_open())
+                const auto bytes = fileHandles.Read(BOOT_FILE_ID, path,
+                        buffer, SECTOR_SIZE,
+                        static_cast<std::uint64_t>(SECTOR_SIZE * (sec - 1)));
+                if (bytes.has_value())
                 {
+                    const bool is_complete = (bytes.value() == SECTOR_SIZE);
+
                     set_default_boot_code = false;
-                    ifs.seekg(SECTOR_SIZE * (sec - 1));
-                    ifs.read(reinterpret_cast<char *>(buffer), SECTOR_SIZE);
-                    if (!ifs.fail() && sec == 1)
+                    if (is_complete && sec == 1)
                     {
                         st_t boot_link = link_address();
 
                         buffer[linkAddressOffset] = boot_link.trk;
                         buffer[linkAddressOffset + 1U] = boot_link.sec;
                     }
-                    if (ifs.fail() && sec == 1)
+                    if (!is_complete && sec == 1)
                     {
                         set_default_boot_code = true;
                     }
-                    ifs.close();
                 }
                 if (set_default_boot_code)
                 {
@@ -1542,32 +2060,19 @@ bool FlexDirectoryDiskBySector::ReadSector(Byte *buffer, int trk, int sec,
                     }
                 }
 
-                result = false;
-                std::ifstream ifs(path, std::ios::in | std::ios::binary);
-                if (ifs.is_open())
+                const auto bytes = fileHandles.Read(link.file_id, path,
+                        buffer + MDPS, DBPS,
+                        static_cast<std::uint64_t>(link.f_record) * DBPS);
+                result = bytes.has_value();
+                if (result)
                 {
-                    ifs.seekg(link.f_record * DBPS);
-                    if (!ifs.fail())
-                    {
-                        auto *p = reinterpret_cast<char *>(buffer + MDPS);
-                        ifs.read(p, DBPS);
-                        auto bytes = static_cast<int>(ifs.gcount());
-
-                        // Pad remaining bytes of sector of a file with 0.
-                        // A number of bytes read of 0 is also valid.
-                        if (bytes < DBPS)
-                        {
-                            std::memset(buffer + MDPS + bytes, 0, DBPS - bytes);
-                        }
-                        result = true;
-                    }
-                    ifs.close();
+                    // Pad remaining bytes of sector of a file with 0.
+                    // A number of bytes read of 0 is also valid.
+                    const auto count = static_cast<int>(bytes.value());
 
-                    if (link.type == SectorType::File)
+                    if (count < DBPS)
                     {
-                        // The host file system changes the modification time.
-                        // Set it back to the time of the emulated file system.
-                        update_file_time(path, link.file_id);
+                        std::memset(buffer + MDPS + count, 0, DBPS - count);
                     }
                 }
 
@@ -1614,6 +2119,7 @@ bool FlexDirectoryDiskBySector::WriteSector(const Byte *buffer, int trk,
     }
 
     auto sec_idx = get_sector_index(track_sector);
+    materialize_file(sec_idx);
     auto &link = flex_links[sec_idx];
 
 #ifdef DEBUG_FILE
@@ -1645,6 +2151,7 @@ bool FlexDirectoryDiskBySector::WriteSector(const Byte *buffer, int trk,
 
                 const auto path = directory / bootSectorFile;
                 std::fill(bootSectors.begin(), bootSectors.end(), '\0');
+                fileHandles.Close(BOOT_FILE_ID);
 
                 const auto status = fs::status(path);
                 if (fs::exists(status) && fs::is_regular_file(status))
@@ -1748,6 +2255,7 @@ bool FlexDirectoryDiskBySector::WriteSector(const Byte *buffer, int trk,
 #endif
                 link.file_id = new_file_id;
                 auto path = get_path_of_file(link.file_id);
+                fileHandles.Close(link.file_id);
                 // Create an empty new file.
                 std::ofstream ofs(path, std::ios::out | std::ios::binary);
                 if (ofs.is_open())
@@ -1799,36 +2307,10 @@ bool FlexDirectoryDiskBySector::WriteSector(const Byte *buffer, int trk,
                     }
                 }
 
-                result = false;
-                // Even if the file is only written to it has to be opened
-                // for read/write otherwise random files do not work as
-                // expected.
-                std::fstream fs(path, std::ios::in | std::ios::out |
-                                std::ios::binary);
-                if (fs.is_open())
-                {
-                    fs.seekp(link.f_record * DBPS);
-                    if (!fs.fail())
-                    {
-                        auto pos = fs.tellp();
-                        const auto *p =
-                            reinterpret_cast<const char *>(buffer + MDPS);
-                        fs.write(p, DBPS);
-                        if (!fs.fail() && fs.tellp() - pos == DBPS)
-                        {
-                            result = true;
-                        }
-                    }
-
-                    fs.close();
-
-                    if (link.type == SectorType::File)
-                    {
-                        // The host file system changes the modification time.
-                        // Set it back to the time of the emulated file system.
-                        update_file_time(path, link.file_id);
-                    }
-                }
+                // The file time is set back when the file is closed.
+                result = fileHandles.Write(link.file_id, path,
+                        buffer + MDPS, DBPS,
+                        static_cast<std::uint64_t>(link.f_record) * DBPS);
             }
             break;
     }
@@ -1908,3 +2390,10 @@ SDWord FlexDirectoryDiskBySector::get_sector_index(const st_t &track_sector) con
     return track_sector.trk * param.max_sector + track_sector.sec - 1;
 }
 
+// Return the track/sector of the given sector index.
+st_t FlexDirectoryDiskBySector::get_track_sector(SDWord sec_idx) const
+{
+    return st_t{static_cast<Byte>(sec_idx / param.max_sector),
+                static_cast<Byte>((sec_idx % param.max_sector) + 1)};
+}
+
@@ -30,17 +30,21 @@
 #include "filecnts.h"
 #include "rndcheck.h"
 #include "fcnffile.h"
+#include "fhcache.h"
+#include "dirwatch.h"
 #include <cstdint>
 #include <ctime>
 #include <optional>
 #include <string>
 #include <array>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
+struct s_file_metadata;
 
 // class FlexDirectoryDiskBySector implements a sector oriented access
 // to a FLEX disk by mapping a host directory emulating a FLEX disk.
@@ -105,6 +109,17 @@ class FlexDirectoryDiskBySector : public IFlexDiskBySector
         st_t next; /* track and sector of next sector to be written */
     };
 
+    // A file which sectors have been allocated on mount but which link
+    // table entries are not initialized yet.
+    struct s_lazy_file
+    {
+        SDWord dir_idx;
+        SDWord sec_idx_begin; // Index of first sector in flex_links.
+        Word records; // Number of sectors.
+        std::uintmax_t size; // File size in byte.
+        bool is_random;
+    };
+
 public:
     FlexDirectoryDiskBySector() = delete;
     FlexDirectoryDiskBySector(const FlexDirectoryDiskBySector &) = delete;
@@ -120,7 +135,10 @@ public:
 
 private:
     fs::path directory;
-    RandomFileCheck randomFileCheck;
+    // randomFileCheck, flex_sys_info and flex_directory are mutable because
+    // files changed on the host are applied when reading a directory
+    // sector, see apply_host_changes().
+    mutable RandomFileCheck randomFileCheck;
     Byte attributes{};
     const FileTimeAccess &ft_access{};
     s_floppy param{};
@@ -129,17 +147,27 @@ private:
 
     // Some structures needed for a FLEX file system
     // link table: Each sector has an entry in the link table.
-    std::vector<s_link_table> flex_links;
-    std::array<s_sys_info_sector, 2> flex_sys_info{}; // system info sectors
-    std::vector<s_dir_sector> flex_directory; // directory sectors
+    // It is mutable because entries of a file are initialized when the
+    // file is accessed first, see materialize_file().
+    mutable std::vector<s_link_table> flex_links;
+    // system info sectors
+    mutable std::array<s_sys_info_sector, 2> flex_sys_info{};
+    mutable std::vector<s_dir_sector> flex_directory; // directory sectors
     std::unordered_map<SDWord, s_new_file> new_files; // new file table
-    std::unordered_map<SDWord, SectorMap_t> sector_maps; // random file
-                                                         // sector maps
+    mutable std::unordered_map<SDWord, SectorMap_t> sector_maps; // random
+                                                       // file sector maps
+    // Files not accessed yet, ordered by sec_idx_begin.
+    mutable std::vector<s_lazy_file> lazy_files;
     st_t dir_extend{0U, 0U}; // track and sector of directory extend sector
     Word init_dir_sectors{}; // initial number of directory sectors
                              // without directory extension.
     SDWord next_dir_idx{-1}; // Next directory index used when filling up
                              // directory with file entries.
+    // Watches the host directory for changed files.
+    std::unique_ptr<DirectoryWatcher> watcher;
+    // Host files kept open between sector accesses. It is declared last
+    // so it is destructed first, closing a file accesses flex_directory.
+    mutable FileHandleCache fileHandles;
 
 public:
     static FlexDirectoryDiskBySector *Create(const fs::path &path,
@@ -165,6 +193,7 @@ public:
     bool IsTrackValid(int track) const override;
     bool IsSectorValid(int track, int sector) const override;
     unsigned GetBytesPerSector() const override;
+    bool Sync() override;
 
 private:
     void fill_flex_directory();
@@ -192,11 +221,12 @@ private:
         std::uintmax_t file_size,
         const st_t &begin,
         const st_t &end,
-        bool is_file_wp);
+        bool is_file_wp) const;
+    void materialize_file(SDWord sec_idx) const;
     SectorMap_t create_sector_map(
                            const fs::path &path,
                            std::uintmax_t size,
-                           const st_t &begin);
+                           const st_t &begin) const;
     void check_for_delete(Word ds_idx, const s_dir_sector &d);
     void check_for_extend(Word ds_idx, const s_dir_sector &d);
     void check_for_rename(Word ds_idx, const s_dir_sector &d);
@@ -228,6 +258,17 @@ private:
     static std::string to_string(SectorType type);
     std::string get_unique_filename(const char *extension) const;
     SDWord get_sector_index(const st_t &track_sector) const;
+    st_t get_track_sector(SDWord sec_idx) const;
+    void apply_host_changes() const;
+    void update_from_host(const std::string &filename) const;
+    SDWord find_dir_idx(const std::string &filename) const;
+    void add_host_file(const s_file_metadata &file, Word records) const;
+    void delete_host_file(SDWord dir_idx) const;
+    void resize_host_file(SDWord dir_idx, const s_file_metadata &file,
+                          Word records) const;
+    bool allocate_sectors(SDWord dir_idx, Word first_record, Word count,
+                          st_t &begin, st_t &end) const;
+    void free_sectors(SDWord sec_idx) const;
 };
 
 #endif // NDIRCONT_INCLUDED
@@ -28,6 +28,7 @@
 #include "bcommand.h"
 #include "schedule.h"
 #include "keyboard.h"
+#include "injector.h"
 #include "cacttrns.h"
 #include "soptions.h"
 #include <utility>
@@ -43,8 +44,18 @@ Pia1::Pia1(Scheduler &p_scheduler, KeyboardIO &p_keyboardIO,
 void Pia1::resetIo()
 {
     request_a_updated = false;
+    is_injected_char_signaled = false;
     Mc6821::resetIo();
     keyboardIO.reset_parallel();
+    if (inputInjector != nullptr)
+    {
+        inputInjector->ResetDelay();
+    }
+}
+
+void Pia1::set_input_injector(InputInjector *p_inputInjector)
+{
+    inputInjector = p_inputInjector;
 }
 
 void Pia1::requestInputA()
@@ -57,7 +68,27 @@ void Pia1::requestInputA()
         Notify(NotifyId::FirstKeyboardRequest);
     }
 
-    keyboardIO.has_key_parallel(do_notify);
+    // Injected text has priority over the keyboard input. The boot
+    // character has to be read first, it is passed through the
+    // keyboard input.
+    bool isCharAvailable = keyboardIO.has_key_parallel(do_notify);
+    if (!do_notify && inputInjector != nullptr &&
+        inputInjector->IsCharAvailable())
+    {
+        // Signal each injected character only once.
+        do_notify = !is_injected_char_signaled;
+        is_injected_char_signaled = true;
+        isCharAvailable = true;
+    }
+
+    // The status is also read to check for Ctrl-X on each output
+    // character, so only a guest blocked waiting for input is notified.
+    if (inputPollDetector.OnPoll(scheduler.get_event_cycles(),
+                                 isCharAvailable))
+    {
+        Notify(NotifyId::InputRequested);
+    }
+
     if (do_notify)
     {
         auto command = BCommandSPtr(
@@ -71,6 +102,19 @@ Byte Pia1::readInputA()
 {
     bool do_notify1 = false;
 
+    inputPollDetector.OnTransfer();
+    if (is_injected_char_signaled)
+    {
+        const auto optional_char = inputInjector->ReadChar();
+
+        is_injected_char_signaled = false;
+        if (optional_char.has_value())
+        {
+            ora = optional_char.value();
+            return ora | (options.isEurocom2V5 ? 0x80U : 0U);
+        }
+    }
+
     if (keyboardIO.has_key_parallel(do_notify1))
     {
         bool do_notify2 = false;
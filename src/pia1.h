@@ -27,11 +27,13 @@
 #include "mc6821.h"
 #include "bobservd.h"
 #include "soptions.h"
+#include "turboctl.h"
 
 
 class KeyboardIO;
 class Scheduler;
 class BObserver;
+class InputInjector;
 
 class Pia1 : public Mc6821, public BObserved
 {
@@ -43,7 +45,10 @@ private:
     Scheduler &scheduler;
     KeyboardIO &keyboardIO;
     const struct sOptions &options;
+    InputInjector *inputInjector{};
     bool request_a_updated{false};
+    bool is_injected_char_signaled{false};
+    InputPollDetector inputPollDetector;
 
 protected:
 
@@ -63,6 +68,9 @@ public:
     Pia1 &operator=(Pia1 &&src) = delete;
 
     void resetIo() override;
+
+    // Inject text into the keyboard input. If nullptr no text is injected.
+    void set_input_injector(InputInjector *p_inputInjector);
     const char *getName() override
     {
         return "pia1";
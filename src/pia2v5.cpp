@@ -27,6 +27,7 @@
 #include "mc6821.h"
 #include "mc6809.h"
 #include "mdcrtape.h"
+#include "schedule.h"
 #include "flexerr.h"
 #include "warnoff.h"
 #include <fmt/format.h>
@@ -45,8 +46,9 @@ namespace fs = std::filesystem;
 #define GET_DELTA_TIME static_cast<float>((cpu.get_cycles() - cycles_cdbg) * \
                                           ORIGINAL_PERIOD)
 
-Pia2V5::Pia2V5(Mc6809 &p_cpu) : cpu(p_cpu)
-
+Pia2V5::Pia2V5(Mc6809 &p_cpu, Scheduler &p_scheduler)
+    : cpu(p_cpu)
+    , scheduler(p_scheduler)
 {
     write_buffer.reserve(256);
     read_buffer.reserve(256);
@@ -60,6 +62,11 @@ Pia2V5::~Pia2V5()
 void Pia2V5::resetIo()
 {
     Mc6821::resetIo();
+    // Pending device events are discarded on reset.
+    event_RDC = Scheduler::InvalidDeviceEventId;
+    event_BET = Scheduler::InvalidDeviceEventId;
+    is_RDC_present = true;
+    is_BET_delay_elapsed = true;
 }
 
 void Pia2V5::writeOutputA(Byte value)
@@ -110,9 +117,8 @@ void Pia2V5::writeOutputA(Byte value)
                     cdbg << "Rewind Tape\n";
                 }
                 direction = TapeDirection::Rewind;
-                cycles_BET = cpu.get_cycles();
-                cycles_RDC = cpu.get_cycles();
-                delay_RDC = static_cast<QWord>(166.F / ORIGINAL_PERIOD);
+                RestartBETDelay();
+                RestartReadClock(static_cast<QWord>(166.F / ORIGINAL_PERIOD));
                 // Prepare for write
                 write_buffer.clear();
                 write_bit_mask = 0x80;
@@ -179,7 +185,7 @@ void Pia2V5::writeOutputA(Byte value)
 
         case 0xc8: // Start read data
             if (direction == TapeDirection::Forward &&
-                cpu.get_cycles() - cycles_BET > delay_BET &&
+                is_BET_delay_elapsed &&
                 drive[drive_idx]->GetRecordType() != RecordType::NONE &&
                 read_mode != ReadMode::Init)
             {
@@ -225,27 +231,25 @@ Byte Pia2V5::readInputA()
         result |= 0x04U; // No write protection (WPRT)
     }
 
-    if (cpu.get_cycles() - cycles_RDC > delay_RDC &&
+    if (is_RDC_present &&
         (read_mode == ReadMode::Init && BTST<Byte>(cra, 7U)))
     {
         result &= ~0x01U;
         read_mode = ReadMode::Read;
-        cycles_RDC = cpu.get_cycles();
 
         if (drive[drive_idx]->GetRecordIndex() > 0)
         {
-            delay_RDC = static_cast<QWord>(600000.F / ORIGINAL_PERIOD);
+            RestartReadClock(static_cast<QWord>(600000.F / ORIGINAL_PERIOD));
         }
         else
         {
-            delay_RDC = static_cast<QWord>(166.F / ORIGINAL_PERIOD);
+            RestartReadClock(static_cast<QWord>(166.F / ORIGINAL_PERIOD));
         }
     }
-    else if (cpu.get_cycles() - cycles_RDC > delay_RDC &&
+    else if (is_RDC_present &&
              (read_mode == ReadMode::Read && BTST<Byte>(cra, 7U)))
     {
-        cycles_RDC = cpu.get_cycles();
-        delay_RDC = static_cast<QWord>(166.F / ORIGINAL_PERIOD);
+        RestartReadClock(static_cast<QWord>(166.F / ORIGINAL_PERIOD));
 
         // Only read a bit if Read Clock (RDC) has been signaled.
         if (read_buffer.empty())
@@ -356,7 +360,7 @@ Byte Pia2V5::readInputB()
 
 void Pia2V5::requestInputA()
 {
-    if (cpu.get_cycles() - cycles_BET > delay_BET)
+    if (is_BET_delay_elapsed)
     {
         if (direction == TapeDirection::Rewind && drive_idx >= 0)
         {
@@ -378,7 +382,7 @@ void Pia2V5::requestInputA()
             }
             else
             {
-                cycles_BET = cpu.get_cycles();
+                RestartBETDelay();
             }
 
         }
@@ -386,7 +390,7 @@ void Pia2V5::requestInputA()
 
     if (read_mode != ReadMode::Off || direction == TapeDirection::Rewind)
     {
-        if (cpu.get_cycles() - cycles_RDC > delay_RDC)
+        if (is_RDC_present)
         {
             activeTransition(ControlLine::CA1); // Set Read clock (RDC)
         }
@@ -404,21 +408,44 @@ void Pia2V5::SetReadModeToInit()
     read_buffer.clear();
     read_index = 0;
     read_bit_mask = 0x80;
-    cycles_RDC = cpu.get_cycles();
 
     if ((drive[drive_idx]->GetRecordType() == RecordType::Header) &&
         (drive[drive_idx]->GetRecordIndex() > 0))
     {
         // When reading the header of the next file
         // there is an extra long delay
-        delay_RDC = static_cast<QWord>(900000.F / ORIGINAL_PERIOD);
+        RestartReadClock(static_cast<QWord>(900000.F / ORIGINAL_PERIOD));
     }
     else
     {
-        delay_RDC = static_cast<QWord>(120000.F / ORIGINAL_PERIOD);
+        RestartReadClock(static_cast<QWord>(120000.F / ORIGINAL_PERIOD));
     }
 }
 
+// The read clock (RDC) is present when delay CPU cycles have elapsed.
+void Pia2V5::RestartReadClock(QWord delay)
+{
+    is_RDC_present = false;
+    scheduler.cancel_event(event_RDC);
+    event_RDC = scheduler.schedule_event(cpu.get_cycles() + delay + 1U,
+        [this](){
+            is_RDC_present = true;
+            event_RDC = Scheduler::InvalidDeviceEventId;
+        });
+}
+
+// Begin/end of tape can be detected when delay_BET CPU cycles have elapsed.
+void Pia2V5::RestartBETDelay()
+{
+    is_BET_delay_elapsed = false;
+    scheduler.cancel_event(event_BET);
+    event_BET = scheduler.schedule_event(cpu.get_cycles() + delay_BET + 1U,
+        [this](){
+            is_BET_delay_elapsed = true;
+            event_BET = Scheduler::InvalidDeviceEventId;
+        });
+}
+
 void Pia2V5::mount_all_drives(const std::array<fs::path, 2> &paths)
 {
     Word drive_nr = 0U;
@@ -29,6 +29,7 @@
 #include "mc6821.h"
 #include "e2.h"
 #include "mdcrtape.h"
+#include "schedule.h"
 #include <array>
 #include <vector>
 #include <fstream>
@@ -60,6 +61,7 @@ private:
     };
 
     Mc6809 &cpu;
+    Scheduler &scheduler;
 
     Byte write_bit_mask{0x80};
     Byte write_byte{0};
@@ -76,12 +78,14 @@ private:
     fs::path disk_dir;
     std::fstream cdbg;
     // following delay/cycle variables/constants are multiples of cpu cycles
-    QWord delay_RDC{0}; // Delay until a read clock is present
     // Delay until a begin/end of tape is detected
     static const QWord delay_BET = static_cast<QWord>(2000.F / ORIGINAL_PERIOD);
-    QWord cycles_RDC{0};
-    QWord cycles_BET{0};
     QWord cycles_cdbg{0};
+    // The delays are timed by device events of the scheduler.
+    Scheduler::DeviceEventId event_RDC{Scheduler::InvalidDeviceEventId};
+    Scheduler::DeviceEventId event_BET{Scheduler::InvalidDeviceEventId};
+    bool is_RDC_present{true}; // A read clock is present
+    bool is_BET_delay_elapsed{true}; // Ready to detect begin/end of tape
 
 protected:
     void writeOutputA(Byte value) override;
@@ -103,7 +107,7 @@ public:
         return "pia2";
     };
 
-    explicit Pia2V5(Mc6809 &p_cpu);
+    Pia2V5(Mc6809 &p_cpu, Scheduler &p_scheduler);
     Pia2V5() = delete;
     Pia2V5(const Pia2V5 &src) = delete;
     Pia2V5 &operator=(const Pia2V5 &src) = delete;
@@ -114,6 +118,8 @@ public:
 private:
     void log_buffer(const std::vector<Byte> &buffer);
     void SetReadModeToInit();
+    void RestartReadClock(QWord delay);
+    void RestartBETDelay();
 };
 
 #endif // PIA2V5_INCLUDED
@@ -38,8 +38,6 @@
 #include "e2floppy.h"
 #include "soptions.h"
 #include "schedcpu.h"
-#include "vico1.h"
-#include "vico2.h"
 #include "schedule.h"
 #include "csetfreq.h"
 #include "ccopymem.h"
@@ -51,7 +49,6 @@
 #include "terminal.h"
 #include "pia1.h"
 #include "e2screen.h"
-#include "bmp.h"
 #include "brkptui.h"
 #include "logfilui.h"
 #include "propsui.h"
@@ -70,6 +67,7 @@
 #include <QString>
 #include <QStringList>
 #include <QPixmap>
+#include <QImage>
 #include <QPainter>
 #include <QIODevice>
 #include <QTextStream>
@@ -89,6 +87,7 @@
 #include <QMenuBar>
 #include <QStatusBar>
 #include <QApplication>
+#include <QGuiApplication>
 #include <QDesktopServices>
 #include <QLayout>
 #include <QHBoxLayout>
@@ -109,7 +108,6 @@
 #include <QKeySequence>
 #include <QThread>
 #include <QTimer>
-#include <QHash>
 #include <QFont>
 #include <QFontInfo>
 #include <QFontMetrics>
@@ -163,12 +161,11 @@ QtGui::QtGui(
         , cpuDialog(new QDialog(this))
         , isRunning(true)
         , isConfirmClose(true)
-        , isForceScreenUpdate(true)
         , memoryWindowMgr(this, p_scheduler, p_memory)
+        , videoRenderer(p_scheduler, p_memory, p_vico1, p_vico2,
+                        [&](){ emit VideoFrameReady(); })
         , cpuState(CpuState::NONE)
         , scheduler(p_scheduler)
-        , vico1(p_vico1)
-        , vico2(p_vico2)
         , joystickIO(p_joystickIO)
         , keyboardIO(p_keyboardIO)
         , options(p_options)
@@ -181,6 +178,8 @@ QtGui::QtGui(
     setObjectName("flexemuMainWindow");
 
     colorTable = CreateColorTable();
+    videoRenderer.SetColorTable(colorTable, options.nColors,
+                                options.isInverse);
 
     mainLayout->setObjectName(QString::fromUtf8("mainLayout"));
     mainLayout->setContentsMargins(0, 0, 0, 0);
@@ -210,6 +209,9 @@ QtGui::QtGui(
     setWindowIcon(flexemuIcon);
 
     connect(&timer, &QTimer::timeout, this, &QtGui::OnTimer);
+    // Frames are signaled from the video renderer thread.
+    connect(this, &QtGui::VideoFrameReady, this, &QtGui::UpdateScreen,
+            Qt::QueuedConnection);
     timer.start(TIME_BASE / 1000);
 
     setLayout(mainLayout);
@@ -416,8 +418,9 @@ void QtGui::OnPreferences()
                 case FlexemuOptionId::NColors:
                 case FlexemuOptionId::IsInverse:
                     colorTable = CreateColorTable();
+                    videoRenderer.SetColorTable(colorTable, options.nColors,
+                                                options.isInverse);
                     e2screen->SetBackgroundColor(colorTable.first());
-                    isForceScreenUpdate = true;
                     isWriteOptions = true;
                     break;
 
@@ -788,7 +791,10 @@ QString QtGui::GetConfigurationHtmlText() const
 
 void QtGui::OnTimer()
 {
-    scheduler.timer_elapsed();
+    if (isSchedulerTick)
+    {
+        scheduler.timer_elapsed();
+    }
 
     // check every 1 second for
     // - Parse name of Boot ROM
@@ -932,7 +938,6 @@ void QtGui::OnTimer()
 
     // check every 20 ms for
     // - Update CPU status
-    // - Repaint screen
     // - Mouse update
     // - Check for shutdown
     if ((timerTicks % 2) == 1)
@@ -965,33 +970,6 @@ void QtGui::OnTimer()
 
         memoryWindowMgr.UpdateData();
 
-        auto firstRasterLine = vico2.get_value();
-        bool isRepaintScreen = false;
-
-        if (firstRasterLine != oldFirstRasterLine)
-        {
-            isRepaintScreen = true;
-            oldFirstRasterLine = firstRasterLine;
-        }
-
-        short display_block;
-
-        // update graphic display (only if display memory has changed)
-        for (display_block = 0; display_block < YBLOCKS; display_block++)
-        {
-            if (isForceScreenUpdate || memory.has_changed(display_block))
-            {
-                update_block(display_block);
-                isRepaintScreen = true;
-            }
-        }
-
-        if (isRepaintScreen)
-        {
-            e2screen->RepaintScreen();
-        }
-        isForceScreenUpdate = false;
-
         e2screen->UpdateMouse();
 
         // If scheduler is finished this window can be unconditionally closed.
@@ -1642,22 +1620,49 @@ void QtGui::SetBell(int /*percent*/)
     QApplication::beep();
 }
 
-void QtGui::update_block(int blockNumber)
+// Set the maximum display refresh rate in Hz. If isSyncToHost is true
+// it is limited by the refresh rate of the host display.
+void QtGui::SetDisplayRefreshRate(int maxRate, bool isSyncToHost)
 {
-    assert(blockNumber >= 0 && blockNumber < YBLOCKS);
+    auto rate = maxRate;
 
-    memory.reset_changed(blockNumber);
-
-    Byte const *src = nullptr;
-    auto video_bank = vico1.get_value();
-    if (memory.is_video_bank_valid(video_bank))
+    if (isSyncToHost && QGuiApplication::primaryScreen() != nullptr)
     {
-        // copy block from video ram into device independant bitmap
-        src = memory.get_video_ram(video_bank, blockNumber);
+        const auto hostRate = static_cast<int>(
+                std::lround(QGuiApplication::primaryScreen()->refreshRate()));
+
+        if (hostRate > 0)
+        {
+            rate = std::min(rate, hostRate);
+        }
     }
 
-    CopyToBMPArray(BLOCKHEIGHT, dataBuffer, src, colorTable);
-    e2screen->UpdateBlock(vico2.get_value(), blockNumber, dataBuffer);
+    videoRenderer.SetMaxRefreshRate(rate);
+}
+
+void QtGui::SetSchedulerTick(bool isEnabled)
+{
+    isSchedulerTick = isEnabled;
+}
+
+// Called if the video renderer has a new frame available.
+// The screen is only repainted if something has changed.
+void QtGui::UpdateScreen()
+{
+    QImage image;
+    VideoRenderer::BlockSet blocks;
+    Byte firstRasterLine{};
+
+    if (videoRenderer.TakeFrame(image, blocks, firstRasterLine))
+    {
+        e2screen->UpdateBlocks(firstRasterLine, image, blocks);
+
+        if (blocks.any() || firstRasterLine != oldFirstRasterLine)
+        {
+            oldFirstRasterLine = firstRasterLine;
+            e2screen->RepaintScreen();
+        }
+    }
 }
 
 void QtGui::UpdateDiskStatus(Word floppyIndex, DiskStatus oldStatus,
@@ -2094,253 +2099,17 @@ void QtGui::SetCpuDialogMonospaceFont(int pointSize)
 
 ColorTable QtGui::CreateColorTable()
 {
-    using fn = std::function<QRgb(Byte)>;
-
-    const auto optionsColor = flx::tolower(options.color);
-    bool isWithColorScale = !optionsColor.compare("default");
-    Word redBase = 255;
-    Word greenBase = 255;
-    Word blueBase = 255;
-    colorTable.resize(MAX_COLORS);
-
-    if (!isWithColorScale)
-    {
-        flx::getRGBForName(options.color, redBase, greenBase, blueBase);
-    }
+    const auto colors = flx::createColorTable(options.color, options.isInverse);
 
-    fn GetColor = [&](Byte index) -> QRgb
+    colorTable.clear();
+    for (const auto color : colors)
     {
-        // Use same color values as Enhanced Graphics Adapter (EGA)
-        // or Tandy Color Computer 3 RGB.
-        // For details see:
-        // https://en.wikipedia.org/wiki/Enhanced_Graphics_Adapter
-        // https://exstructus.com/tags/coco/australia-colour-palette/
-        constexpr static std::array<Byte, 4> colorValues{
-            0x00, 0x55, 0xAA, 0xFF
-        };
-        unsigned scale;
-
-        // Create a color scale in the range of 0 - 3 based two color bits
-        // <color>_HIGH and <color>_LOW. Convert the color scale into a
-        // color value in the range of 0 - 255.
-        scale = index & RED_HIGH ? 2U : 0U;
-        scale |= index & RED_LOW ? 1U : 0U;
-        auto red = colorValues[scale];
-        scale = index & GREEN_HIGH ? 2U : 0U;
-        scale |= index & GREEN_LOW ? 1U : 0U;
-        auto green = colorValues[scale];
-        scale = index & BLUE_HIGH ? 2U : 0U;
-        scale |= index & BLUE_LOW ? 1U : 0U;
-        auto blue = colorValues[scale];
-
-        return qRgb(red, green, blue);
-    };
-
-    fn GetColorShade = [&](Byte index) -> QRgb
-    {
-        auto dIndex = static_cast<double>(index);
-        auto red = static_cast<Byte>(redBase * sqrt(dIndex / (MAX_COLORS - 1)));
-        auto green = static_cast<Byte>(greenBase * sqrt(dIndex /
-                (MAX_COLORS - 1)));
-        auto blue = static_cast<Byte>(blueBase * sqrt(dIndex /
-                (MAX_COLORS - 1)));
-
-        return qRgb(red, green, blue);
-    };
-
-    fn GetTheColor = (isWithColorScale ? GetColor : GetColorShade);
-
-    for (Byte i = 0; i < static_cast<Byte>(colorTable.size()); ++i)
-    {
-        int idx = options.isInverse ?
-                  cast_from_qsizetype(colorTable.size()) - i - 1 : i;
-        colorTable[idx] = GetTheColor(i);
+        colorTable.push_back(color);
     }
 
     return colorTable;
 }
 
-void QtGui::CopyToBMPArray(Word height, QByteArray& dest,
-                           Byte const *videoRam,
-                           const ColorTable& p_colorTable)
-{
-    sBITMAPFILEHEADER fileHeader{};
-    sBITMAPINFOHEADER infoHeader{};
-
-    assert(height >= 1);
-    assert(!p_colorTable.empty());
-
-    // Size of BMP stream:
-    // BITMAPFILEHEADER + BITMAPINFOHEADER + color table size + pixel data
-    DWord dataOffset = sizeof(fileHeader) + sizeof(infoHeader) +
-                     (static_cast<DWord>(p_colorTable.size()) *
-                      sizeof(sRGBQUAD));
-    auto destSize = static_cast<SDWord>(dataOffset + (height * WINDOWWIDTH));
-
-    dest.clear();
-    dest.resize(destSize);
-
-    auto *pData = dest.data();
-
-    fileHeader.type[0] = 'B';
-    fileHeader.type[1] = 'M';
-    fileHeader.fileSize = flx::toLittleEndian<DWord>(destSize);
-    fileHeader.reserved[0] = 0U;
-    fileHeader.reserved[1] = 0U;
-    fileHeader.dataOffset = flx::toLittleEndian<DWord>(dataOffset);
-    memcpy(pData, &fileHeader, sizeof(fileHeader));
-    pData += sizeof(fileHeader);
-
-    infoHeader.size = flx::toLittleEndian<DWord>(sizeof(infoHeader));
-    infoHeader.width = flx::toLittleEndian<SDWord>(WINDOWWIDTH);
-    infoHeader.height = flx::toLittleEndian<SDWord>(height);
-    infoHeader.planes = flx::toLittleEndian<Word>(1U);
-    infoHeader.bitCount = flx::toLittleEndian<Word>(8U);
-    infoHeader.compression = flx::toLittleEndian<DWord>(BI_RGB);
-    infoHeader.imageSize = flx::toLittleEndian<DWord>(height * WINDOWWIDTH);
-    infoHeader.xPixelsPerMeter = 0;
-    infoHeader.yPixelsPerMeter = 0;
-    infoHeader.colorsUsed =
-        flx::toLittleEndian<DWord>(static_cast<DWord>(p_colorTable.size()));
-    infoHeader.colorsImportant =
-        flx::toLittleEndian<DWord>(static_cast<DWord>(p_colorTable.size()));
-    memcpy(pData, &infoHeader, sizeof(infoHeader));
-    pData += sizeof(infoHeader);
-
-    assert(p_colorTable.size() <=
-           static_cast<ColorTable::size_type>(MAX_COLORS));
-
-    const auto size = static_cast<int>(sizeof(sRGBQUAD)) *
-                      p_colorTable.size();
-    const auto hash = qHashRange(p_colorTable.begin(), p_colorTable.end());
-    if (colorTablesCache.contains(hash))
-    {
-        memcpy(pData, colorTablesCache.value(hash).data(), size);
-        pData += size;
-    }
-    else
-    {
-        QByteArray colorTableCache(size, '\0');
-        sRGBQUAD colorEntry{};
-        const auto *pDataOrigin = pData;
-
-        for (const auto rgbColor : p_colorTable)
-        {
-            colorEntry.red = static_cast<Byte>(qRed(rgbColor));
-            colorEntry.green = static_cast<Byte>(qGreen(rgbColor));
-            colorEntry.blue = static_cast<Byte>(qBlue(rgbColor));
-            colorEntry.reserved = '\0';
-            memcpy(pData, &colorEntry, sizeof(colorEntry));
-            pData += sizeof(colorEntry);
-        }
-        memcpy(colorTableCache.data(), pDataOrigin, size);
-        colorTablesCache.insert(hash, colorTableCache);
-    }
-    assert(pData == dest.data() + dataOffset);
-
-    std::array<Byte, 6> pixels{}; /* One byte of video RAM for each plane */
-    // Default color index: If no video source is available use highest
-    // available color
-    Byte colorIndex = options.isInverse ? 0x00U : 0x3FU;
-    Byte colorIndexOffset = 0U;
-    if (options.isInverse)
-    {
-        colorIndexOffset = static_cast<Byte>((64U / options.nColors) - 1U);
-    }
-
-    // The raster lines have to be filled from bottom to top.
-    pData += WINDOWWIDTH * (height - 1);
-    for (auto count = 0; count < (RASTERLINE_SIZE * height); ++count)
-    {
-        Byte pixelBitMask;
-
-        if (videoRam != nullptr)
-        {
-            pixels[0] = videoRam[0];
-
-            if (options.nColors > 2)
-            {
-                pixels[2] = videoRam[VIDEORAM_SIZE];
-                pixels[4] = videoRam[VIDEORAM_SIZE * 2];
-
-                if (options.nColors > 8)
-                {
-                    pixels[1] = videoRam[VIDEORAM_SIZE * 3];
-                    pixels[3] = videoRam[VIDEORAM_SIZE * 4];
-                    pixels[5] = videoRam[VIDEORAM_SIZE * 5];
-                }
-            }
-
-            videoRam++;
-
-            /* Loop from MSBit to LSBit */
-            for (pixelBitMask = 0x80U; pixelBitMask; pixelBitMask >>= 1U)
-            {
-                colorIndex = colorIndexOffset; /* calculated color index */
-
-                if (pixels[0] & pixelBitMask)
-                {
-                    colorIndex += GREEN_HIGH; // 0x0C, green high
-                }
-
-                if (options.nColors > 8)
-                {
-                    if (pixels[2] & pixelBitMask)
-                    {
-                        colorIndex += RED_HIGH; // 0x0D, red high
-                    }
-
-                    if (pixels[4] & pixelBitMask)
-                    {
-                        colorIndex += BLUE_HIGH; // 0x0E, blue high
-                    }
-
-                    if (pixels[1] & pixelBitMask)
-                    {
-                        colorIndex += GREEN_LOW; // 0x04, green low
-                    }
-
-                    if (pixels[3] & pixelBitMask)
-                    {
-                        colorIndex += RED_LOW; // 0x05, red low
-                    }
-
-                    if (pixels[5] & pixelBitMask)
-                    {
-                        colorIndex += BLUE_LOW; // 0x06, blue low
-                    }
-                }
-                else
-                {
-                    if (pixels[2] & pixelBitMask)
-                    {
-                        colorIndex += RED_HIGH; // 0x0D, red high
-                    }
-
-                    if (pixels[4] & pixelBitMask)
-                    {
-                        colorIndex += BLUE_HIGH; // 0x0E, blue high
-                    }
-                }
-                *(pData)++ = static_cast<char>(colorIndex);
-            }
-        }
-        else
-        {
-            for (pixelBitMask = 0x80U; pixelBitMask; pixelBitMask >>= 1U)
-            {
-                *(pData)++ = static_cast<char>(colorIndex);
-            }
-        }
-        if (count % RASTERLINE_SIZE == (RASTERLINE_SIZE - 1))
-        {
-            pData -= 2 * WINDOWWIDTH;
-        }
-    }
-
-    assert(pData == dest.data() + dataOffset - WINDOWWIDTH);
-}
-
 bool QtGui::event(QEvent *event)
 {
     if (event->type() == QEvent::StatusTip)
@@ -2631,6 +2400,13 @@ std::string QtGui::GetKeyString(Byte key)
 
 void QtGui::UpdateFrom(NotifyId id, void *param)
 {
+    if (id == NotifyId::VideoRamChanged)
+    {
+        // Called on CPU thread.
+        videoRenderer.NotifyVideoRamChanged();
+        return;
+    }
+
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wswitch-enum"
@@ -2788,6 +2564,15 @@ ItemPairList_t QtGui::GetConfiguration() const
             " " << device_props.className <<
             ", " << (device_props.description.empty() ?
                     device_props.classDescription : device_props.description);
+        if (device_props.statistics)
+        {
+            const auto &statistics = *device_props.statistics;
+
+            strdevice << std::dec <<
+                ", reads " << statistics.GetTotalReadCount() <<
+                ", writes " << statistics.GetTotalWriteCount() <<
+                ", resets " << statistics.GetResetCount();
+        }
         values.emplace_back(strdevice.str());
     }
     result.emplace_back("Devices", values);
@@ -2888,6 +2673,15 @@ void QtGui::UpdateFrequencyStatus() const
     stream << std::fixed << std::setprecision(2) << std::setw(6) <<
         scheduler.get_frequency() << " MHz";
     frequencyLabel->setText(QString::fromStdString(stream.str()));
+
+    if (scheduler.is_pacing())
+    {
+        // Show the achieved accuracy of the CPU frequency pacing.
+        const auto drift = static_cast<int>(scheduler.get_pacing_drift());
+
+        frequencyLabel->setToolTip(
+            tr("CPU frequency, pacing drift: %1 us").arg(drift));
+    }
 }
 
 void QtGui::RestoreMemoryWindows()
@@ -35,13 +35,13 @@
 #include "ccopymem.h"
 #include "qtfree.h"
 #include "memwinmg.h"
+#include "vidrendr.h"
 #include "warnoff.h"
 #include "ui_cpustat.h"
 #include <QWidget>
 #include <QIcon>
 #include <QTimer>
 #include <QString>
-#include <QByteArray>
 #include <QMap>
 #include <optional>
 #include "warnon.h"
@@ -88,16 +88,6 @@ class QComboBox;
 class QTextBrowser;
 struct sOptions;
 
-using ColorTable = QVector<QRgb>;
-
-// Cache containing color tables identified by a hash value.
-// The hash value is the key which depends on the Qt version.
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-using ColorTablesCache = QHash<std::size_t, QByteArray>;
-#else
-using ColorTablesCache = QHash<uint, QByteArray>;
-#endif
-
 class QtGui : public QWidget, public AbstractGui, public BObserver,
               public BObserved
 {
@@ -124,6 +114,9 @@ public:
     QtGui &operator=(QtGui &&src) = delete;
 
     void SetFloppy(E2floppy *fdc);
+    void SetDisplayRefreshRate(int maxRate, bool isSyncToHost);
+    // If enabled the GUI timer also drives the scheduler tick.
+    void SetSchedulerTick(bool isEnabled);
     bool HasFloppy() const;
     bool output_to_graphic() override;
     void write_char_serial(Byte value) override;
@@ -132,6 +125,7 @@ public:
 
 signals:
     void CloseApplication();
+    void VideoFrameReady();
 
 protected:
     void redraw_cpuview_impl(const Mc6809CpuStatus &status) override;
@@ -196,7 +190,7 @@ private:
     bool IsClosingConfirmed();
     void PopupMessage(const QString &message);
     static void SetBell(int percent);
-    void update_block(int blockNumber);
+    void UpdateScreen();
     void UpdateDiskStatus(Word floppyIndex, DiskStatus oldStatus,
                           DiskStatus newStatus);
     void UpdateInterruptStatus(tIrqType irqType, bool status);
@@ -231,8 +225,6 @@ private:
     static QUrl CreateDocumentationUrl(const QString &docDir,
                                        const QString &htmlFile);
     ColorTable CreateColorTable();
-    void CopyToBMPArray(Word height, QByteArray& dest,
-                        Byte const *videoRam, const ColorTable& colorTable);
     int TranslateToAscii(QKeyEvent *event);
     void SetCpuDialogMonospaceFont(int pointSize);
     void ConnectScreenSizeComboBoxSignalSlots() const;
@@ -318,17 +310,15 @@ private:
     QIcon iconNmi;
     QIcon iconReset;
     ColorTable colorTable;
-    ColorTablesCache colorTablesCache;
-    QByteArray dataBuffer;
 
     bool isOriginalFrequency{};
     bool isRunning{};
     bool isConfirmClose{};
-    bool isForceScreenUpdate{};
     bool isRestartNeeded{};
     bool isTimerFirstTime{true};
     bool isStatusBarVisible{};
     bool isMagneticMainWindowEnabled{};
+    bool isSchedulerTick{true};
 
     int timerTicks{0};
     Byte oldFirstRasterLine{0U};
@@ -344,11 +334,10 @@ private:
     CReadMemorySPtr readRomCommand;
     CReadMemorySPtr readOsCommand;
     MemoryWindowManager memoryWindowMgr;
+    VideoRenderer videoRenderer;
     CpuState cpuState;
 
     Scheduler &scheduler;
-    VideoControl1 &vico1;
-    VideoControl2 &vico2;
     JoystickIO &joystickIO;
     KeyboardIO &keyboardIO;
     E2floppy *fdc{};
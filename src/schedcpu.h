@@ -71,6 +71,13 @@ public:
     virtual CpuStatusPtr create_status_object() = 0;
     virtual void get_interrupt_status(tInterruptStatus &s) = 0;
     virtual void set_required_cyclecount(cycles_t required_cyclecount) = 0;
+    // Request to suspend until the next timer event because the CPU
+    // executes an idle loop.
+    virtual void set_idle() = 0;
+    // Request to return from run() with CpuState::Schedule as soon as
+    // the total cycle count reaches the given absolute cycle count.
+    // The maximum value of QWord disables the deadline.
+    virtual void set_event_deadline(QWord p_cycles) = 0;
     virtual std::string get_name() = 0;
 };
 
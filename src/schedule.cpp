@@ -36,6 +36,8 @@
 #include "bcommand.h"
 #include "inout.h"
 #include "breltime.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <limits>
 #include <mutex>
@@ -56,6 +58,20 @@ Scheduler::Scheduler(ScheduledCpu &p_cpu, Inout &p_inout)
     std::memset(&interrupt_status, 0, sizeof(tInterruptStatus));
 }
 
+Scheduler::~Scheduler()
+{
+    // Release commands which have not been executed.
+    auto *command = queued_commands.exchange(nullptr);
+
+    while (command != nullptr)
+    {
+        auto *next = command->nextQueued;
+
+        command->queuedSelf.reset();
+        command = next;
+    }
+}
+
 void Scheduler::request_new_state(CpuState p_user_state)
 {
     if (p_user_state != CpuState::NONE)
@@ -83,7 +99,11 @@ void Scheduler::process_events()
             auto time1sec = BRelativeTime::GetTimeUsll();
             total_cycles = cpu.get_cycles(true);
 
-            if (target_frequency > 0.0)
+            if (is_pacing())
+            {
+                update_required_cyclecount();
+            }
+            else if (target_frequency > 0.0 && !is_turbo)
             {
                 frequency_control(time1sec);
             }
@@ -102,6 +122,11 @@ void Scheduler::process_events()
                 time0sec += 1000000;
             }
 
+            for (const auto &timer_hook : timer_hooks)
+            {
+                timer_hook(total_cycles);
+            }
+
             events &= ~Event::Timer;
         }
 
@@ -124,12 +149,11 @@ void Scheduler::process_events()
             events &= ~Event::SetStatus;
         }
 
-        if ((events & Event::SyncExec) != Event::NONE)
-        {
-            execute_commands();
+    }
 
-            events &= ~Event::SyncExec;
-        }
+    if (queued_commands.load(std::memory_order_acquire) != nullptr)
+    {
+        execute_commands();
     }
 }
 
@@ -155,10 +179,19 @@ CpuState Scheduler::runloop(RunMode mode)
     {
         new_state = cpu.run(mode);
 
+        execute_device_events();
+
         if (new_state == CpuState::Suspend)
         {
-            // suspend thread until next timer tick
-            suspend();
+            if (is_pacing())
+            {
+                pace();
+            }
+            else
+            {
+                // suspend thread until next timer tick
+                suspend();
+            }
             new_state = CpuState::Schedule;
         }
 
@@ -252,11 +285,94 @@ void Scheduler::timer_elapsed()
     cpu.exit_run();
 }
 
+void Scheduler::UpdateFrom(NotifyId id, void *param)
+{
+    if (id == NotifyId::HostTimerEvent &&
+        *static_cast<int *>(param) == HOST_TIMER_ID)
+    {
+        timer_elapsed();
+    }
+}
+
+void Scheduler::add_timer_hook(TimerHook hook)
+{
+    timer_hooks.push_back(std::move(hook));
+}
+
 void Scheduler::do_reset()
 {
+    // The cycle count starts from zero, pending device events are
+    // discarded. The devices schedule new events after reset.
+    device_events.clear();
+    cpu.set_event_deadline(std::numeric_limits<QWord>::max());
     cpu.do_reset();
     total_cycles = 0;
     cycles0 = 0;
+    is_pacing_anchored = false;
+    if (is_pacing())
+    {
+        start_slice(pacing_slice_us);
+    }
+}
+
+bool Scheduler::is_later(const DeviceEvent &lhs, const DeviceEvent &rhs)
+{
+    return (lhs.cycles > rhs.cycles) ||
+        (lhs.cycles == rhs.cycles && lhs.id > rhs.id);
+}
+
+Scheduler::DeviceEventId Scheduler::schedule_event(QWord p_cycles,
+        DeviceEventCallback callback)
+{
+    const auto id = next_event_id++;
+
+    device_events.push_back({ p_cycles, id, std::move(callback) });
+    std::push_heap(device_events.begin(), device_events.end(), is_later);
+    update_event_deadline();
+
+    return id;
+}
+
+void Scheduler::cancel_event(DeviceEventId id)
+{
+    const auto iter = std::find_if(device_events.begin(), device_events.end(),
+        [id](const DeviceEvent &event){ return event.id == id; });
+
+    if (iter != device_events.end())
+    {
+        device_events.erase(iter);
+        std::make_heap(device_events.begin(), device_events.end(), is_later);
+        update_event_deadline();
+    }
+}
+
+// Execute all device events which are due. A device event may schedule
+// new events, they are executed in the same call if already due.
+void Scheduler::execute_device_events()
+{
+    if (device_events.empty())
+    {
+        return;
+    }
+
+    const auto current_cycles = cpu.get_cycles();
+
+    while (!device_events.empty() &&
+           device_events.front().cycles <= current_cycles)
+    {
+        std::pop_heap(device_events.begin(), device_events.end(), is_later);
+        auto callback = std::move(device_events.back().callback);
+        device_events.pop_back();
+        callback();
+    }
+
+    update_event_deadline();
+}
+
+void Scheduler::update_event_deadline()
+{
+    cpu.set_event_deadline(device_events.empty() ?
+        std::numeric_limits<QWord>::max() : device_events.front().cycles);
 }
 
 // thread support: Start Running CPU Thread
@@ -276,22 +392,52 @@ void Scheduler::run()
 
 void Scheduler::sync_exec(BCommandSPtr new_command)
 {
-    std::lock_guard<std::mutex> guard(command_mutex);
+    auto *command = new_command.get();
+
+    if (command->isQueued.exchange(true, std::memory_order_acquire))
+    {
+        // The command is still pending.
+        return;
+    }
+
+    // The command keeps itself alive until it has been executed.
+    command->queuedSelf = std::move(new_command);
+    command->nextQueued = queued_commands.load(std::memory_order_relaxed);
+    while (!queued_commands.compare_exchange_weak(command->nextQueued,
+                command, std::memory_order_release,
+                std::memory_order_relaxed))
+    {
+    }
 
-    commands.push_back(std::move(new_command));
-    events |= Event::SyncExec;
     cpu.exit_run();
 }
 
 void Scheduler::execute_commands()
 {
-    std::lock_guard<std::mutex> guard(command_mutex);
+    auto *command = queued_commands.exchange(nullptr,
+                                             std::memory_order_acquire);
+    BCommand *first = nullptr;
 
-    for (auto &command : commands)
+    // Reverse the list to execute the commands in the order of sync_exec().
+    while (command != nullptr)
     {
-        command->Execute();
+        auto *next = command->nextQueued;
+
+        command->nextQueued = first;
+        first = command;
+        command = next;
+    }
+
+    while (first != nullptr)
+    {
+        auto self = std::move(first->queuedSelf);
+
+        first = first->nextQueued;
+        // From now on the command can be queued again. It is executed
+        // afterwards, so a new request is not lost.
+        self->isQueued.store(false, std::memory_order_release);
+        self->Execute();
     }
-    commands.clear();
 }
 
 CpuStatus *Scheduler::get_status()
@@ -359,6 +505,9 @@ void Scheduler::update_frequency()
     cyclecount = cycles1 - cycles0;
     frequency = static_cast<float>(static_cast<double>(cyclecount) / 1000000.0);
     cycles0 = cycles1;
+    pacing_drift.store(static_cast<float>(max_drift),
+                       std::memory_order_relaxed);
+    max_drift = 0.0;
 }
 
 
@@ -382,7 +531,123 @@ void Scheduler::set_frequency(float p_target_frequency)
         time0 = 0;
     }
 
+    if (is_turbo)
+    {
+        cycles = std::numeric_limits<decltype(cycles)>::max();
+    }
+
     cpu.set_required_cyclecount(cycles);
+    is_pacing_anchored = false;
+    if (is_pacing())
+    {
+        start_slice(pacing_slice_us);
+    }
+}
+
+void Scheduler::set_turbo(bool p_is_turbo)
+{
+    if (p_is_turbo != is_turbo)
+    {
+        is_turbo = p_is_turbo;
+        set_frequency(target_frequency);
+    }
+}
+
+void Scheduler::set_pacing_slice(DWord p_slice_us)
+{
+    pacing_slice_us = p_slice_us;
+    is_pacing_anchored = false;
+    if (is_pacing())
+    {
+        start_slice(pacing_slice_us);
+    }
+    else
+    {
+        set_frequency(target_frequency);
+    }
+}
+
+// The host time and CPU cycles from which the pacing is calculated.
+void Scheduler::anchor_pacing()
+{
+    pace_time0 = std::chrono::steady_clock::now();
+    pace_cycles0 = cpu.get_cycles();
+    is_pacing_anchored = true;
+}
+
+// Start a new slice with the cycles executed in slice_us microseconds.
+void Scheduler::start_slice(double slice_us)
+{
+    slice_end_cycles = cpu.get_cycles() +
+        static_cast<QWord>(slice_us * static_cast<double>(target_frequency));
+    update_required_cyclecount();
+}
+
+// The required cycle count of the CPU is relative to the last timer event.
+void Scheduler::update_required_cyclecount()
+{
+    cpu.set_required_cyclecount(slice_end_cycles > total_cycles ?
+            slice_end_cycles - total_cycles : 0U);
+}
+
+// Called on the CPU thread if the CPU is suspended while pacing.
+void Scheduler::pace()
+{
+    // With a larger drift, e.g. after the host was busy, pacing starts
+    // again without catching up.
+    constexpr double MAX_DRIFT_US = 50000.0;
+    using usec = std::chrono::duration<double, std::micro>;
+    const auto slice_us = static_cast<double>(pacing_slice_us);
+
+    if (cpu.get_cycles() < slice_end_cycles)
+    {
+        // The CPU waits for an interrupt (CWAI, SYNC). Suspend until the
+        // next timer tick like without pacing.
+        suspend();
+        anchor_pacing();
+        start_slice(slice_us);
+        return;
+    }
+
+    if (!is_pacing_anchored)
+    {
+        anchor_pacing();
+        start_slice(slice_us);
+        return;
+    }
+
+    const auto executed_cycles = cpu.get_cycles() - pace_cycles0;
+    const auto ideal_time = pace_time0 +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            usec(static_cast<double>(executed_cycles) /
+                 static_cast<double>(target_frequency)));
+
+    {
+        // Sleep until the host time corresponds to the executed cycles.
+        // An earlier resume() wakes up the thread to process events.
+        std::unique_lock<std::mutex> lock(condition_mutex);
+        is_resume = false;
+        if (condition.wait_until(lock, ideal_time, [&](){ return is_resume; }))
+        {
+            return;
+        }
+    }
+
+    // The drift is the time the CPU thread woke up too late. The next
+    // ideal time is again calculated from the anchor, so it is not
+    // accumulated.
+    const auto drift =
+        usec(std::chrono::steady_clock::now() - ideal_time).count();
+
+    if (drift > MAX_DRIFT_US)
+    {
+        anchor_pacing();
+        start_slice(slice_us);
+        return;
+    }
+
+    max_drift = std::max(max_drift, drift);
+    start_slice(slice_us);
 }
 
 void Scheduler::suspend()
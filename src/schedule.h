@@ -30,30 +30,37 @@
 #include "cpustate.h"
 #include "schedcpu.h"
 #include "bcommand.h"
+#include "bobserv.h"
 #include <type_traits>
+#include <functional>
 #include <mutex>
 #include <vector>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 
 
 
 class Inout;
 
-class Scheduler
+class Scheduler : public BObserver
 {
 public:
 
     enum class Event : uint8_t
     {
         NONE = 0U,
-        SyncExec = (1U << 0U),  // synchronous execute commands
-        Timer = (1U << 1U),     // execute timer events
-        SetStatus = (1U << 2U), // set cpu status
+        Timer = (1U << 0U),     // execute timer events
+        SetStatus = (1U << 1U), // set cpu status
     };
 
     Scheduler() = delete;
     Scheduler(ScheduledCpu &p_cpu, Inout &p_inout);
+    ~Scheduler() override;
+    Scheduler(const Scheduler &src) = delete;
+    Scheduler(Scheduler &&src) = delete;
+    Scheduler &operator=(const Scheduler &src) = delete;
+    Scheduler &operator=(Scheduler &&src) = delete;
 
     CpuState statemachine(CpuState initial_state);
     bool is_finished();
@@ -64,6 +71,10 @@ public:
 
     // Thread support
 public:
+    // Execute a command on the CPU thread. It can be called from any
+    // thread without locking. If the same command object is still
+    // pending it is not queued again, so repeated requests, e.g. to
+    // read memory, are coalesced.
     void sync_exec(BCommandSPtr new_command);
     void run();
 
@@ -75,19 +86,67 @@ protected:
 
     // Timer interface:
 public:
+    // A timer hook is called on the CPU thread on each timer event.
+    // The parameter is the total number of CPU cycles.
+    // Timer hooks have to be added before the CPU thread is started.
+    using TimerHook = std::function<void(QWord)>;
+
     QWord get_total_cycles() const
     {
         return total_cycles;
     }
     void timer_elapsed();
+    void add_timer_hook(TimerHook hook);
+    // The scheduler tick can be driven by a host timer with this id.
+    void UpdateFrom(NotifyId id, void *param = nullptr) override;
+
+    static const int HOST_TIMER_ID{6809};
+
+    // Device event interface:
+public:
+    // A device event is a callback executed on the CPU thread as soon as
+    // the total number of CPU cycles reaches an absolute cycle count.
+    // Events with the same cycle count are executed in the order they
+    // have been scheduled. Devices use it for timing instead of comparing
+    // cycle counts on each register access.
+    // These functions have to be called on the CPU thread, e.g. from
+    // within a device register access or a device event.
+    using DeviceEventCallback = std::function<void()>;
+    using DeviceEventId = QWord;
+    static constexpr DeviceEventId InvalidDeviceEventId = 0U;
+
+    DeviceEventId schedule_event(QWord p_cycles,
+                                 DeviceEventCallback callback);
+    void cancel_event(DeviceEventId id);
+    // Return the current total number of CPU cycles.
+    QWord get_event_cycles()
+    {
+        return cpu.get_cycles();
+    }
+
+private:
+    struct DeviceEvent
+    {
+        QWord cycles;
+        DeviceEventId id;
+        DeviceEventCallback callback;
+    };
+
+    static bool is_later(const DeviceEvent &lhs, const DeviceEvent &rhs);
+    void execute_device_events();
+    void update_event_deadline();
+
+    std::vector<DeviceEvent> device_events; // heap, next event on front
+    DeviceEventId next_event_id{InvalidDeviceEventId + 1U};
 
 private:
     std::mutex condition_mutex;
     std::condition_variable condition;
-    std::mutex command_mutex;
     std::mutex status_mutex;
     std::mutex irq_status_mutex;
-    std::vector<BCommandSPtr> commands;
+    // Pending commands in reverse order (lock-free LIFO list).
+    std::atomic<BCommand *> queued_commands{};
+    std::vector<TimerHook> timer_hooks;
     ScheduledCpu &cpu;
     Inout &inout;
     CpuState state{CpuState::Run};
@@ -111,6 +170,13 @@ protected:
     // CPU frequency
 public:
     void set_frequency(float p_target_frequency);
+    // In turbo mode the CPU frequency is not limited, the target
+    // frequency is kept. It has to be called on the CPU thread.
+    void set_turbo(bool p_is_turbo);
+    bool get_turbo() const
+    {
+        return is_turbo;
+    }
     float get_frequency() const
     {
         return frequency;
@@ -122,10 +188,46 @@ public:
 private:
     void update_frequency();
     void frequency_control(QWord time1);
-    float target_frequency{ORIGINAL_FREQUENCY};
+    // Target frequency and turbo flag are also read by other threads.
+    std::atomic<float> target_frequency{ORIGINAL_FREQUENCY};
     float frequency{}; // current frequency
+    std::atomic<bool> is_turbo{};
     QWord time0{}; // time for freq control
     QWord cycles0{}; // cycle count for freq calc
+
+    // CPU frequency pacing:
+    // Without pacing the CPU executes the cycles of a whole timer tick
+    // at full speed and then is suspended until the next timer tick.
+    // With pacing the cycles are executed in slices of the given time.
+    // After each slice the CPU thread sleeps until the host time
+    // corresponds to the executed cycles. The sleep time is calculated
+    // from an anchor time and cycle count, so a late wake-up does not
+    // change the emulated frequency.
+public:
+    // Set the slice time in microseconds, 0 switches off pacing.
+    void set_pacing_slice(DWord p_slice_us);
+    bool is_pacing() const
+    {
+        return pacing_slice_us != 0U && target_frequency > 0.0F && !is_turbo;
+    }
+    // Return the maximum absolute drift of the last second in
+    // microseconds.
+    float get_pacing_drift() const
+    {
+        return pacing_drift.load(std::memory_order_relaxed);
+    }
+private:
+    void pace();
+    void anchor_pacing();
+    void start_slice(double slice_us);
+    void update_required_cyclecount();
+    DWord pacing_slice_us{};
+    bool is_pacing_anchored{};
+    std::chrono::steady_clock::time_point pace_time0;
+    QWord pace_cycles0{};
+    QWord slice_end_cycles{};
+    double max_drift{}; // maximum absolute drift of the current second
+    std::atomic<float> pacing_drift{};
 };
 
 inline Scheduler::Event operator| (Scheduler::Event lhs, Scheduler::Event rhs)
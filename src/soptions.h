@@ -117,6 +117,8 @@ struct sOptions
     bool isTerminalIgnoreESC{}; // Terminal mode: Ignore ESC (0x1B) characters
     bool isTerminalIgnoreNUL{}; // Terminal mode: Ignore NUL (0x00) characters
     int terminalType{}; // type of terminal: 1 = scrolling, 2 = ncurses
+                        // 3 = pseudo terminal or socket
+    std::string terminalEndpoint; // Endpoint if terminalType is 3
     FileTimeAccess fileTimeAccess{};
     short int reset_key{};
     int iconSize{}; // Size of icons {16, 24, 32 }.
@@ -155,6 +157,10 @@ struct sOptions
     bool isFloatingToolBar{}; // true if floatng toolbar is active. Only used
                               // if fullscreen is active.
     fs::path cpuLogPath; // Path used for CPU instruction logging
+    fs::path capturePath; // Path used for video capture
+    std::uint64_t captureCycleInterval{}; // If not 0 capture a sequence of
+                                          // frames with this cycle interval.
+    fs::path inputScriptPath; // Text file injected as keyboard input
 
     FlexemuOptionIds_t readOnlyOptionIds;// List of option ids which are
                                          // read-only.
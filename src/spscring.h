@@ -0,0 +1,114 @@
+/*
+    spscring.h  Lock-free single producer single consumer ring buffer.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef SPSCRING_INCLUDED
+#define SPSCRING_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+
+// class SpscRing is a lock-free ring buffer with a fixed capacity of N
+// elements, N has to be a power of two.
+// Exactly one thread may call push() (producer) and exactly one thread
+// may call empty(), front(), pop() or clear() (consumer).
+// size() may be called from any thread, the result is a snapshot.
+template <typename T, std::size_t N>
+class SpscRing
+{
+    static_assert(N != 0U && (N & (N - 1U)) == 0U,
+                  "N has to be a power of two");
+
+public:
+    SpscRing() = default;
+    ~SpscRing() = default;
+    SpscRing(const SpscRing &src) = delete;
+    SpscRing(SpscRing &&src) = delete;
+    SpscRing &operator=(const SpscRing &src) = delete;
+    SpscRing &operator=(SpscRing &&src) = delete;
+
+    static constexpr std::size_t capacity()
+    {
+        return N;
+    }
+
+    // Producer: Append an element. Return false if the ring is full.
+    bool push(const T &value)
+    {
+        const auto head_pos = head.load(std::memory_order_relaxed);
+
+        if (head_pos - tail.load(std::memory_order_acquire) >= N)
+        {
+            return false;
+        }
+
+        buffer[head_pos & (N - 1U)] = value;
+        head.store(head_pos + 1U, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer: Return true if there is no element to be read.
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) ==
+               tail.load(std::memory_order_relaxed);
+    }
+
+    // Consumer: Return the oldest element. The ring must not be empty.
+    const T &front() const
+    {
+        return buffer[tail.load(std::memory_order_relaxed) & (N - 1U)];
+    }
+
+    // Consumer: Remove the oldest element. The ring must not be empty.
+    void pop()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1U,
+                   std::memory_order_release);
+    }
+
+    // Consumer: Remove all elements.
+    void clear()
+    {
+        tail.store(head.load(std::memory_order_acquire),
+                   std::memory_order_release);
+    }
+
+    std::size_t size() const
+    {
+        const auto tail_pos = tail.load(std::memory_order_acquire);
+
+        return head.load(std::memory_order_acquire) - tail_pos;
+    }
+
+private:
+    // Indices are incremented without wrapping around, the element index
+    // is the lower bits. Producer and consumer index are located in
+    // separate cache lines.
+    alignas(64) std::atomic<std::size_t> head{};
+    alignas(64) std::atomic<std::size_t> tail{};
+    std::array<T, N> buffer{};
+};
+
+#endif
@@ -40,7 +40,6 @@
 #include <string>
 #include <array>
 #include <unordered_map>
-#include <iterator>
 #include <algorithm>
 
 #ifdef UNIX
@@ -100,6 +99,7 @@ void NCursesTerminalImpl::reset_terminal_io()
 #ifdef UNIX
     if (win != nullptr)
     {
+        flush_serial();
         delwin(win);
         win = nullptr;
         endwin();
@@ -154,7 +154,12 @@ bool NCursesTerminalImpl::has_char_serial()
     {
         count = 0;
 
-        chtype buffer = wgetch(win);
+        flush_serial();
+        chtype buffer;
+        {
+            LatencyScope latencyScope(hostLatency);
+            buffer = wgetch(win);
+        }
         if (buffer != static_cast<chtype>(ERR))
         {
             Byte key{};
@@ -231,6 +236,25 @@ void NCursesTerminalImpl::write_char_serial(Byte value)
     if (value != '\0' || !options.isTerminalIgnoreNUL)
     {
         write_char_serial_safe(value);
+        // The window is refreshed on each new line, before polling
+        // the terminal for input and on each timer event.
+        is_refresh_pending = true;
+        if (value == LF)
+        {
+            flush_serial();
+        }
+    }
+#endif
+}
+
+void NCursesTerminalImpl::flush_serial()
+{
+#ifdef UNIX
+    if (is_refresh_pending && win != nullptr)
+    {
+        LatencyScope latencyScope(hostLatency);
+        wrefresh(win);
+        is_refresh_pending = false;
     }
 #endif
 }
@@ -247,17 +271,6 @@ bool NCursesTerminalImpl::is_terminal_supported()
 #endif
 }
 
-void NCursesTerminalImpl::set_startup_command(const std::string &startup_command)
-{
-    if (!startup_command.empty())
-    {
-        std::lock_guard<std::mutex> guard(serial_mutex);
-        std::copy(startup_command.begin(), startup_command.end(),
-                  std::back_inserter(key_buffer_serial));
-        key_buffer_serial.push_back('\r');
-    }
-}
-
 #ifdef UNIX
 void NCursesTerminalImpl::put_char_serial(Byte key)
 {
@@ -344,7 +357,6 @@ void NCursesTerminalImpl::write_char_serial_safe(Byte value)
             wmove(win, y + 1, 0);
         }
     }
-    wrefresh(win);
 }
 
 void NCursesTerminalImpl::limit_column_and_line(int &column, int &line)
@@ -383,7 +395,6 @@ void NCursesTerminalImpl::process_ctrl_character(Byte value)
                 wmove(win, y, x - 1);
                 waddch(win, ' ');
                 wmove(win, y, x - 1);
-                wrefresh(win);
             }
             break;
 
@@ -392,7 +403,6 @@ void NCursesTerminalImpl::process_ctrl_character(Byte value)
             [[fallthrough]];
         case '\x1C': // CTRL-\ cursor home
             wmove(win, 0, 0);
-            wrefresh(win);
             break;
 
         case '\x0E': // CTRL-N: scroll up one line
@@ -400,7 +410,6 @@ void NCursesTerminalImpl::process_ctrl_character(Byte value)
             wmove(win, 0, x);
             wdeleteln(win);
             wmove(win, y, x);
-            wrefresh(win);
             break;
 
         case '\x0F': // CTRL-O: scroll down one line
@@ -408,7 +417,6 @@ void NCursesTerminalImpl::process_ctrl_character(Byte value)
             wmove(win, 0, x);
             winsertln(win);
             wmove(win, y, x);
-            wrefresh(win);
             break;
 
         case '\x11': // CTRL-Q: cursor up one line
@@ -452,7 +460,6 @@ void NCursesTerminalImpl::process_ctrl_character(Byte value)
                 wmove(win, 0, x);
                 wdeleteln(win);
                 wmove(win, y, 0);
-                wrefresh(win);
             }
             else
             {
@@ -530,7 +537,6 @@ void NCursesTerminalImpl::process_esc_sequence(Byte value)
         }
         esc_sequence.clear();
         curs_set(is_cursor_visible);
-        wrefresh(win);
         return;
     }
 
@@ -566,7 +572,6 @@ void NCursesTerminalImpl::process_esc_sequence(Byte value)
 
     esc_sequence.clear();
     curs_set(is_cursor_visible);
-    wrefresh(win);
 }
 
 // Implementation may change in future.
@@ -27,6 +27,7 @@
 #include "typedefs.h"
 #include "termimpi.h"
 #include "bobservd.h"
+#include "iostat.h"
 #ifdef UNIX
 #include "config.h"
 #ifdef HAVE_NCURSESW_NCURSES_H
@@ -56,10 +57,13 @@ class NCursesTerminalImpl : public ITerminalImpl, public BObserved
     const sOptions &options;
     bool is_cursor_visible{true};
     bool is_german{false};
+    bool is_refresh_pending{false};
     Word init_delay{500};
     Word input_delay{0};
     std::mutex serial_mutex;
     std::deque<Byte> key_buffer_serial;
+    // Host time of reading input and refreshing the window.
+    LatencyHistogram hostLatency;
 #ifdef UNIX
     std::vector<Byte> esc_sequence;
 
@@ -77,8 +81,12 @@ public:
     Byte read_char_serial() override;
     Byte peek_char_serial() override;
     void write_char_serial(Byte val) override;
+    void flush_serial() override;
     bool is_terminal_supported() override;
-    void set_startup_command(const std::string &startup_command) override;
+    const LatencyHistogram *get_host_latency() override
+    {
+        return &hostLatency;
+    }
 
 private:
     void reset_terminal_io() override;
@@ -66,14 +66,13 @@ void DummyTerminalImpl::write_char_serial(Byte /*value*/)
 {
 }
 
-bool DummyTerminalImpl::is_terminal_supported()
+void DummyTerminalImpl::flush_serial()
 {
-    return false;
 }
 
-void DummyTerminalImpl::set_startup_command(
-        const std::string & /*startup_command*/)
+bool DummyTerminalImpl::is_terminal_supported()
 {
+    return false;
 }
 
 void DummyTerminalImpl::reset_terminal_io()
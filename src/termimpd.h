@@ -44,8 +44,8 @@ public:
     Byte read_char_serial() override;
     Byte peek_char_serial() override;
     void write_char_serial(Byte val) override;
+    void flush_serial() override;
     bool is_terminal_supported() override;
-    void set_startup_command(const std::string &startup_command) override;
 
 private:
     void reset_terminal_io() override;
@@ -27,6 +27,7 @@
 #include "termimpc.h"
 #include "termimpd.h"
 #include "termimps.h"
+#include "termimpr.h"
 #include <memory>
 #include <type_traits>
 
@@ -44,6 +45,9 @@ ITerminalImplPtr TerminalImplFactory::Create(TerminalType type,
 
         case TerminalType::NCurses:
             return std::make_unique<NCursesTerminalImpl>(options);
+
+        case TerminalType::Remote:
+            return std::make_unique<RemoteTerminalImpl>(options);
     }
 
     throw FlexException(FERR_INVALID_TERMINAL_TYPE, static_cast<int>(type));
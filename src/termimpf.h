@@ -31,6 +31,7 @@ enum class TerminalType : uint8_t
     Dummy,
     Scrolling,
     NCurses,
+    Remote,
 };
 
 struct sOptions;
@@ -27,10 +27,10 @@
 #include "typedefs.h"
 #include <csignal>
 #include <memory>
-#include <string>
 
 
 class TerminalIO;
+class LatencyHistogram;
 
 #ifdef _WIN32
 using fct_sigaction = void (*)(int);
@@ -55,8 +55,22 @@ public:
     virtual Byte read_char_serial() = 0;
     virtual Byte peek_char_serial() = 0;
     virtual void write_char_serial(Byte val) = 0;
+    // Return false if output written by write_char_serial() can not be
+    // buffered, the guest has to wait until the terminal has sent it.
+    virtual bool can_write_char_serial()
+    {
+        return true;
+    }
+    // Output written by write_char_serial() may be buffered.
+    // Write all buffered output to the terminal.
+    virtual void flush_serial() = 0;
     virtual bool is_terminal_supported() = 0;
-    virtual void set_startup_command(const std::string &startup_command) = 0;
+    // Return the histogram of the host time needed for terminal I/O
+    // system calls or nullptr if not available.
+    virtual const LatencyHistogram *get_host_latency()
+    {
+        return nullptr;
+    }
 
 private:
     virtual void reset_terminal_io() = 0;
@@ -0,0 +1,600 @@
+/*
+    termimpr.cpp  Terminal on a pseudo terminal or a socket.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "config.h"
+#include "typedefs.h"
+#include "termimpi.h"
+#include "termimpr.h"
+#include "soptions.h"
+#include "asciictl.h"
+#include "misc1.h"
+#ifdef UNIX
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <termios.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <array>
+#include <memory>
+#include <string>
+#include <thread>
+#include <iostream>
+#include <algorithm>
+
+
+static const std::string tcpPrefix{"tcp:"};
+static const std::string unixPrefix{"unix:"};
+
+RemoteTerminalImpl::RemoteTerminalImpl(const sOptions &p_options)
+    : options(p_options)
+{
+}
+
+RemoteTerminalImpl::~RemoteTerminalImpl()
+{
+    RemoteTerminalImpl::reset_terminal_io();
+}
+
+bool RemoteTerminalImpl::IsValidEndpoint(const std::string &endpoint)
+{
+    if (endpoint == "pty")
+    {
+        return true;
+    }
+
+    if (endpoint.compare(0U, tcpPrefix.size(), tcpPrefix) == 0)
+    {
+        const auto port = endpoint.substr(tcpPrefix.size());
+
+        if (port.empty() || port.size() > 5U ||
+            !std::all_of(port.cbegin(), port.cend(), [](char ch){
+                return ch >= '0' && ch <= '9';
+            }))
+        {
+            return false;
+        }
+
+        const auto value = std::stoi(port);
+
+        return value >= 1 && value <= 65535;
+    }
+
+#ifdef UNIX
+    if (endpoint.compare(0U, unixPrefix.size(), unixPrefix) == 0)
+    {
+        const auto path = endpoint.substr(unixPrefix.size());
+
+        return !path.empty() && path.size() < sizeof(sockaddr_un::sun_path);
+    }
+#endif
+
+    return false;
+}
+
+// Return false on fatal errors forcing to abort the application.
+bool RemoteTerminalImpl::init(Word /*reset_key*/, fct_sigaction fct)
+{
+    (void)fct;
+#ifdef UNIX
+    if (io_thread)
+    {
+        return true;
+    }
+
+    struct sigaction sig_action{};
+
+    sig_action.sa_sigaction = fct;
+    sig_action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&sig_action.sa_mask);
+    sigaction(SIGUSR1, &sig_action, nullptr);
+    sigaction(SIGUSR2, &sig_action, nullptr);
+    sigaction(SIGINT, &sig_action, nullptr);
+    sigaction(SIGQUIT, &sig_action, nullptr);
+    sigaction(SIGTERM, &sig_action, nullptr);
+
+    if (!open_endpoint() || pipe(wakeup_fds.data()) != 0)
+    {
+        std::cerr << "*** Error: Unable to open terminal endpoint '" <<
+            options.terminalEndpoint << "': " << std::strerror(errno) << '\n';
+        close_fds();
+        return false;
+    }
+
+    is_exit.store(false);
+    io_thread = std::make_unique<std::thread>(
+            &RemoteTerminalImpl::run_io_thread, this);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool RemoteTerminalImpl::open_endpoint()
+{
+    const auto &endpoint = options.terminalEndpoint;
+
+    if (!IsValidEndpoint(endpoint))
+    {
+        errno = EINVAL;
+        return false;
+    }
+
+    if (endpoint == "pty")
+    {
+        kind = Kind::Pty;
+        return open_pty();
+    }
+
+    kind = (endpoint.compare(0U, tcpPrefix.size(), tcpPrefix) == 0) ?
+        Kind::Tcp : Kind::UnixSocket;
+
+    return open_socket();
+}
+
+bool RemoteTerminalImpl::open_pty()
+{
+#ifdef UNIX
+    data_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (data_fd < 0 || grantpt(data_fd) != 0 || unlockpt(data_fd) != 0)
+    {
+        return false;
+    }
+
+    const auto *name = ptsname(data_fd);
+    if (name == nullptr)
+    {
+        return false;
+    }
+    const std::string slave_path(name);
+
+    // The slave device is kept open. Otherwise the master gets a hang up
+    // each time the last client closes it.
+    pty_slave_fd = open(slave_path.c_str(), O_RDWR | O_NOCTTY);
+    if (pty_slave_fd < 0)
+    {
+        return false;
+    }
+
+    struct termios buf{};
+
+    if (tcgetattr(pty_slave_fd, &buf) == 0)
+    {
+        cfmakeraw(&buf);
+        tcsetattr(pty_slave_fd, TCSANOW, &buf);
+    }
+
+    if (fcntl(data_fd, F_SETFL, fcntl(data_fd, F_GETFL) | O_NONBLOCK) != 0)
+    {
+        return false;
+    }
+
+    is_connected.store(true);
+    std::cerr << "Serial port connected to " << slave_path << '\n';
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool RemoteTerminalImpl::open_socket()
+{
+#ifdef UNIX
+    const auto &endpoint = options.terminalEndpoint;
+
+    if (kind == Kind::Tcp)
+    {
+        const auto port = std::stoi(endpoint.substr(tcpPrefix.size()));
+        struct sockaddr_in address{};
+        int reuse = 1;
+
+        listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd < 0)
+        {
+            return false;
+        }
+        setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse,
+                   sizeof(reuse));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listen_fd, reinterpret_cast<struct sockaddr *>(&address),
+                 sizeof(address)) != 0)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        const auto path = endpoint.substr(unixPrefix.size());
+        struct sockaddr_un address{};
+        struct stat sbuf{};
+
+        listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0)
+        {
+            return false;
+        }
+        // Remove a socket left over from a previous session but
+        // never any other file.
+        if (lstat(path.c_str(), &sbuf) == 0 && S_ISSOCK(sbuf.st_mode))
+        {
+            unlink(path.c_str());
+        }
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(),
+                     sizeof(address.sun_path) - 1U);
+        if (bind(listen_fd, reinterpret_cast<struct sockaddr *>(&address),
+                 sizeof(address)) != 0)
+        {
+            return false;
+        }
+        socket_path = path;
+    }
+
+    if (listen(listen_fd, 1) != 0 ||
+        fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK) != 0)
+    {
+        return false;
+    }
+
+    std::cerr << "Serial port listening on " << endpoint << '\n';
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RemoteTerminalImpl::close_fds()
+{
+#ifdef UNIX
+    for (auto *fd : { &data_fd, &listen_fd, &pty_slave_fd, &wakeup_fds[0],
+                      &wakeup_fds[1] })
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+
+    if (!socket_path.empty())
+    {
+        unlink(socket_path.c_str());
+        socket_path.clear();
+    }
+#endif
+    is_connected.store(false);
+}
+
+void RemoteTerminalImpl::reset_terminal_io()
+{
+#ifdef UNIX
+    if (io_thread)
+    {
+        const Byte wakeup_byte{};
+
+        is_exit.store(true);
+        if (write(wakeup_fds[1], &wakeup_byte, 1) == 1)
+        {
+            io_thread->join();
+        }
+        else
+        {
+            io_thread->detach();
+        }
+        io_thread.reset();
+    }
+
+    close_fds();
+#endif
+}
+
+// Wake up the I/O thread to send the output. Multiple wake ups are
+// coalesced until the I/O thread has been woken up.
+void RemoteTerminalImpl::wakeup()
+{
+#ifdef UNIX
+    if (!is_wakeup_pending.exchange(true))
+    {
+        const Byte wakeup_byte{};
+
+        if (write(wakeup_fds[1], &wakeup_byte, 1) != 1)
+        {
+            is_wakeup_pending.store(false);
+        }
+    }
+#endif
+}
+
+void RemoteTerminalImpl::run_io_thread()
+{
+#ifdef UNIX
+    flx::setCurrentThreadName("TerminalIoThread");
+
+    while (!is_exit.load())
+    {
+        std::array<struct pollfd, 3> fds{};
+        nfds_t count = 1U;
+        nfds_t listen_index = 0U;
+        nfds_t data_index = 0U;
+        int timeout = -1;
+
+        fds[0].fd = wakeup_fds[0];
+        fds[0].events = POLLIN;
+        if (listen_fd >= 0 && data_fd < 0)
+        {
+            listen_index = count++;
+            fds[listen_index].fd = listen_fd;
+            fds[listen_index].events = POLLIN;
+        }
+        if (data_fd >= 0)
+        {
+            data_index = count++;
+            fds[data_index].fd = data_fd;
+            if (rx_buffer.size() < rx_buffer.capacity())
+            {
+                fds[data_index].events |= POLLIN;
+            }
+            else
+            {
+                // Wait until the CPU has read some characters.
+                timeout = 10;
+            }
+            if (!tx_pending.empty() || !tx_buffer.empty())
+            {
+                fds[data_index].events |= POLLOUT;
+            }
+        }
+
+        if (poll(fds.data(), count, timeout) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+
+        if (fds[0].revents != 0)
+        {
+            std::array<Byte, 16> buffer{};
+
+            is_wakeup_pending.store(false);
+            if (read(wakeup_fds[0], buffer.data(), buffer.size()) <= 0)
+            {
+                return;
+            }
+        }
+
+        if (listen_index != 0U && (fds[listen_index].revents & POLLIN) != 0)
+        {
+            data_fd = accept(listen_fd, nullptr, nullptr);
+            if (data_fd >= 0)
+            {
+                fcntl(data_fd, F_SETFL, fcntl(data_fd, F_GETFL) | O_NONBLOCK);
+                is_connected.store(true);
+            }
+        }
+
+        if (data_index != 0U && fds[data_index].revents != 0)
+        {
+            const auto revents = fds[data_index].revents;
+            bool is_success = true;
+
+            if ((revents & POLLIN) != 0)
+            {
+                is_success = receive();
+            }
+            else if ((revents & (POLLHUP | POLLERR | POLLNVAL)) != 0)
+            {
+                // Hang up or error without data to be received. This
+                // is also reported if POLLIN is not polled while
+                // rx_buffer is full.
+                is_success = false;
+            }
+            if (is_success && (revents & POLLOUT) != 0)
+            {
+                is_success = transmit();
+            }
+            if (!is_success)
+            {
+                // The client has disconnected.
+                close(data_fd);
+                data_fd = -1;
+                is_connected.store(false);
+                tx_pending.clear();
+            }
+        }
+
+        if (data_fd < 0)
+        {
+            // Output is discarded while no client is connected.
+            tx_buffer.clear();
+        }
+    }
+#endif
+}
+
+// Called on the I/O thread. Return false if the connection is closed.
+bool RemoteTerminalImpl::receive()
+{
+#ifdef UNIX
+    std::array<Byte, 256> buffer{};
+    const auto size = std::min(buffer.size(),
+                               rx_buffer.capacity() - rx_buffer.size());
+    ssize_t result;
+
+    {
+        LatencyScope latencyScope(hostLatency);
+        result = read(data_fd, buffer.data(), size);
+    }
+
+    if (result < 0)
+    {
+        return errno == EINTR || errno == EAGAIN;
+    }
+
+    for (ssize_t i = 0; i < result; ++i)
+    {
+        rx_buffer.push(buffer[static_cast<std::size_t>(i)]);
+    }
+
+    return result > 0 || size == 0U;
+#else
+    return false;
+#endif
+}
+
+// Called on the I/O thread. Return false if the connection is closed.
+bool RemoteTerminalImpl::transmit()
+{
+#ifdef UNIX
+    while (tx_pending.size() < 1024U && !tx_buffer.empty())
+    {
+        tx_pending.push_back(tx_buffer.front());
+        tx_buffer.pop();
+    }
+
+    if (tx_pending.empty())
+    {
+        return true;
+    }
+
+    ssize_t result;
+
+    {
+        // For sockets avoid SIGPIPE if the client has disconnected.
+        LatencyScope latencyScope(hostLatency);
+        result = (kind == Kind::Pty) ?
+            write(data_fd, tx_pending.data(), tx_pending.size()) :
+            send(data_fd, tx_pending.data(), tx_pending.size(), MSG_NOSIGNAL);
+    }
+
+    if (result < 0)
+    {
+        return errno == EINTR || errno == EAGAIN;
+    }
+
+    tx_pending.erase(tx_pending.begin(), tx_pending.begin() + result);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RemoteTerminalImpl::reset_serial()
+{
+    input_delay = 0U;
+    rx_buffer.clear();
+}
+
+bool RemoteTerminalImpl::has_char_serial()
+{
+    // After successfully receiving a character delay signaling the
+    // next characters being receivable.
+    if (input_delay != 0U)
+    {
+        --input_delay;
+        return false;
+    }
+
+    return !rx_buffer.empty();
+}
+
+// Read a serial character from cpu.
+// ATTENTION: Input should always be polled before read_char_serial.
+Byte RemoteTerminalImpl::read_char_serial()
+{
+    Byte result = 0x00;
+
+    if (!rx_buffer.empty())
+    {
+        result = rx_buffer.front();
+        rx_buffer.pop();
+        input_delay = 2U;
+    }
+
+    return result;
+}
+
+// Read character, but leave it in the queue.
+// ATTENTION: Input should always be polled before peek_char_serial.
+Byte RemoteTerminalImpl::peek_char_serial()
+{
+    return rx_buffer.empty() ? Byte(0x00U) : rx_buffer.front();
+}
+
+// Characters are passed unchanged. If the output buffer is full the
+// character is dropped, so the CPU thread never waits for a slow or
+// stalled client.
+void RemoteTerminalImpl::write_char_serial(Byte value)
+{
+    if (!is_connected.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    if (!tx_buffer.push(value) || value == LF ||
+        tx_buffer.size() >= tx_buffer.capacity() / 2U)
+    {
+        wakeup();
+    }
+}
+
+// The transmit buffer is drained by the I/O thread. While it is full
+// the guest waits for the transmit data register being empty, so no
+// output is lost and the CPU thread is not blocked.
+// Without a client output is discarded, so it is always accepted.
+bool RemoteTerminalImpl::can_write_char_serial()
+{
+    return !is_connected.load(std::memory_order_relaxed) ||
+        tx_buffer.size() < tx_buffer.capacity();
+}
+
+// Called on each timer event.
+void RemoteTerminalImpl::flush_serial()
+{
+    if (!tx_buffer.empty())
+    {
+        wakeup();
+    }
+}
+
+bool RemoteTerminalImpl::is_terminal_supported()
+{
+    return io_thread != nullptr;
+}
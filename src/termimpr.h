@@ -0,0 +1,126 @@
+/*
+    termimpr.h  Terminal on a pseudo terminal or a socket.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef REMOTETERMINALIMPL_INCLUDED
+#define REMOTETERMINALIMPL_INCLUDED
+
+#include "typedefs.h"
+#include "termimpi.h"
+#include "spscring.h"
+#include "iostat.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct sOptions;
+
+// class RemoteTerminalImpl connects the serial port to a pseudo terminal
+// or to a listening socket instead of the controlling terminal.
+// The endpoint is specified by sOptions::terminalEndpoint:
+//   "pty":          A pseudo terminal is created, the path of the slave
+//                   device (e.g. /dev/pts/3) is printed on stderr.
+//   "tcp:<port>":   A TCP socket listens on the loopback interface.
+//   "unix:<path>":  A Unix domain socket listens on the given path.
+// A socket accepts one client at a time. While no client is connected
+// any output is discarded. If the client does not read output fast enough
+// the transmit buffer gets full. Then can_write_char_serial() returns
+// false, the ACIA reports its transmit data register not being empty
+// until the I/O thread has sent some output.
+// All I/O is done non-blocking on a separate I/O thread. Input and output
+// are passed through lock-free ring buffers, so on the CPU thread there
+// are no system calls for each character.
+class RemoteTerminalImpl : public ITerminalImpl
+{
+public:
+    enum class Kind : uint8_t
+    {
+        Pty,
+        Tcp,
+        UnixSocket,
+    };
+
+    RemoteTerminalImpl() = delete;
+    explicit RemoteTerminalImpl(const sOptions &p_options);
+    ~RemoteTerminalImpl() override;
+    RemoteTerminalImpl(const RemoteTerminalImpl &src) = delete;
+    RemoteTerminalImpl(RemoteTerminalImpl &&src) = delete;
+    RemoteTerminalImpl &operator=(const RemoteTerminalImpl &src) = delete;
+    RemoteTerminalImpl &operator=(RemoteTerminalImpl &&src) = delete;
+
+    // Interface ITerminalImpl
+    bool init(Word reset_key, fct_sigaction fct) override;
+    void reset_serial() override;
+    bool has_char_serial() override;
+    Byte read_char_serial() override;
+    Byte peek_char_serial() override;
+    void write_char_serial(Byte val) override;
+    bool can_write_char_serial() override;
+    void flush_serial() override;
+    bool is_terminal_supported() override;
+    const LatencyHistogram *get_host_latency() override
+    {
+        return &hostLatency;
+    }
+
+    // Return true if endpoint is a valid terminal endpoint.
+    static bool IsValidEndpoint(const std::string &endpoint);
+
+private:
+    void reset_terminal_io() override;
+
+    bool open_endpoint();
+    bool open_pty();
+    bool open_socket();
+    void close_fds();
+    void wakeup();
+    void run_io_thread();
+    bool receive();
+    bool transmit();
+
+    const sOptions &options;
+    Kind kind{Kind::Pty};
+    Word input_delay{};
+    // Characters received from the endpoint, read on the CPU thread.
+    SpscRing<Byte, 4096U> rx_buffer;
+    // Characters written on the CPU thread, sent by the I/O thread.
+    SpscRing<Byte, 4096U> tx_buffer;
+    // Output taken from tx_buffer but not yet sent, only accessed on the
+    // I/O thread.
+    std::vector<Byte> tx_pending;
+    std::unique_ptr<std::thread> io_thread;
+    std::atomic<bool> is_exit{};
+    std::atomic<bool> is_wakeup_pending{};
+    std::atomic<bool> is_connected{};
+    std::string socket_path;
+    // File descriptors. data_fd is the pty master or the connected client.
+    int listen_fd{-1};
+    int data_fd{-1};
+    int pty_slave_fd{-1};
+    std::array<int, 2> wakeup_fds{-1, -1};
+    // Host time of the read and write system calls, added on the I/O
+    // thread.
+    LatencyHistogram hostLatency;
+};
+#endif
@@ -28,26 +28,40 @@
 #include "termimps.h"
 #include "soptions.h"
 #include "asciictl.h"
+#include "misc1.h"
 #ifdef HAVE_TERMIOS_H
 #include <termios.h>
+#include <poll.h>
 #endif
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#include <cerrno>
 #include <csignal>
 #include <cstring>
 #include <cstdio>
-#include <mutex>
+#include <array>
+#include <memory>
 #include <string>
+#include <thread>
 #include <iostream>
-#include <iterator>
-#include <algorithm>
 
 
+// Maximum number of buffered output characters. The output buffer is
+// written to stdout on each new line, if it is full and on each
+// timer event.
+static constexpr std::size_t OUTPUT_BUFFER_SIZE = 1024U;
+
 ScrollingTerminalImpl::ScrollingTerminalImpl(const sOptions &p_options)
     : options(p_options)
     , init_delay(500)
 {
+    output_buffer.reserve(OUTPUT_BUFFER_SIZE);
+}
+
+ScrollingTerminalImpl::~ScrollingTerminalImpl()
+{
+    stop_input_thread();
 }
 
 // Return false on fatal errors forcing to abort the application.
@@ -164,6 +178,8 @@ bool ScrollingTerminalImpl::init(Word reset_key, fct_sigaction fct)
         is_termios_saved = true;
     }
 
+    start_input_thread();
+
     return true;
 #endif // #ifdef HAVE_TERMIOS_H
 
@@ -174,11 +190,12 @@ void ScrollingTerminalImpl::reset_serial()
 {
     init_delay = 500;
     was_escape = false;
-    std::lock_guard<std::mutex> guard(serial_mutex);
     key_buffer_serial.clear();
 }
 
 // poll serial port for input character.
+// The terminal is read by the input thread, so on the CPU thread
+// this only checks the input buffers.
 bool ScrollingTerminalImpl::has_char_serial()
 {
     // After a reset and booting FLEX delay the serial key input request.
@@ -192,20 +209,6 @@ bool ScrollingTerminalImpl::has_char_serial()
     }
 
 #ifdef HAVE_TERMIOS_H
-    static Word count = 0;
-
-    if (++count >= 100)
-    {
-        Byte buffer{};
-        count = 0;
-        fflush(stdout);
-
-        if (read(fileno(stdin), &buffer, 1) > 0)
-        {
-            put_char_serial(buffer);
-        }
-    }
-
     // After successfully receiving a character from terminal delay
     // signaling the next characters being receivable.
     if (input_delay != 0)
@@ -215,7 +218,6 @@ bool ScrollingTerminalImpl::has_char_serial()
     }
 #endif // #ifdef HAVE_TERMIOS_H
 
-    std::lock_guard<std::mutex> guard(serial_mutex);
     return !key_buffer_serial.empty();
 }
 
@@ -225,16 +227,13 @@ Byte ScrollingTerminalImpl::read_char_serial()
 {
     Byte result = 0x00;
 
-    std::lock_guard<std::mutex> guard(serial_mutex);
     if (!key_buffer_serial.empty())
     {
         result = key_buffer_serial.front();
-        key_buffer_serial.pop_front();
+        key_buffer_serial.pop();
+        Notify(NotifyId::KeyPressedOnCPU, &result);
         // After successfully receiving a character from terminal delay
         // signalling the next character being receivable.
-        // Reason: Immediately receiving a second character may get lost,
-        // resulting in receiving only every second character of the
-        // startup command (-C).
         input_delay = 2;
     }
 
@@ -245,34 +244,61 @@ Byte ScrollingTerminalImpl::read_char_serial()
 // ATTENTION: Input should always be polled before peek_char_serial.
 Byte ScrollingTerminalImpl::peek_char_serial()
 {
-    Byte result = 0x00;
-
-    std::lock_guard<std::mutex> guard(serial_mutex);
     if (!key_buffer_serial.empty())
     {
-        result = key_buffer_serial.front();
+        return key_buffer_serial.front();
     }
 
-    return result;
+    return 0x00;
 }
 
-// Implementation may change in future.
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 void ScrollingTerminalImpl::write_char_serial_safe(Byte value)
 {
-    (void)value;
+    output_buffer.push_back(value);
+
+    if (value == LF || output_buffer.size() >= OUTPUT_BUFFER_SIZE)
+    {
+        write_output_buffer();
+    }
+}
+
+void ScrollingTerminalImpl::write_output_buffer()
+{
 #ifdef HAVE_TERMIOS_H
-    // the write syscall may be aborted by EINTR or no byte is written.
-    // This is defined bahaviour.
-    // Solution: Retry up to 4 times.
-    for (int i = 0; i < 4; ++i)
+    const auto *data = output_buffer.data();
+    auto size = output_buffer.size();
+    int retries = 0;
+
+    // The write syscall may be aborted by EINTR, may write only part of
+    // the buffer or no byte at all. This is defined bahaviour.
+    // Solution: Continue with the remaining bytes, retry up to 4 times
+    // if nothing has been written.
+    while (size != 0U && retries < 4)
     {
-        if (write(fileno(stdout), &value, 1) == 1)
+        ssize_t result;
+
+        {
+            LatencyScope latencyScope(hostLatency);
+            result = write(fileno(stdout), data, size);
+        }
+
+        if (result > 0)
+        {
+            data += result;
+            size -= static_cast<std::size_t>(result);
+            retries = 0;
+        }
+        else if (result == 0 || errno == EINTR || errno == EAGAIN)
+        {
+            ++retries;
+        }
+        else
         {
             break;
         }
     }
 #endif
+    output_buffer.clear();
 }
 
 void ScrollingTerminalImpl::write_char_serial(Byte value)
@@ -311,6 +337,15 @@ void ScrollingTerminalImpl::write_char_serial(Byte value)
 #endif // #ifdef HAVE_TERMIOS_H
 }
 
+void ScrollingTerminalImpl::flush_serial()
+{
+    fflush(stdout);
+    if (!output_buffer.empty())
+    {
+        write_output_buffer();
+    }
+}
+
 // Implementation may change in future.
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 bool ScrollingTerminalImpl::is_terminal_supported()
@@ -322,20 +357,10 @@ bool ScrollingTerminalImpl::is_terminal_supported()
 #endif
 }
 
-void ScrollingTerminalImpl::set_startup_command(
-        const std::string &startup_command)
-{
-    if (!startup_command.empty())
-    {
-        std::lock_guard<std::mutex> guard(serial_mutex);
-        std::copy(startup_command.begin(), startup_command.end(),
-                  std::back_inserter(key_buffer_serial));
-        key_buffer_serial.push_back('\r');
-    }
-}
-
 void ScrollingTerminalImpl::reset_terminal_io()
 {
+    stop_input_thread();
+    flush_serial();
 #ifdef HAVE_TERMIOS_H
     if (is_termios_saved && isatty(fileno(stdin)))
     {
@@ -349,26 +374,130 @@ void ScrollingTerminalImpl::reset_terminal_io()
 #endif // #ifdef HAVE_TERMIOS_H
 }
 
-void ScrollingTerminalImpl::put_char_serial(Byte key)
+void ScrollingTerminalImpl::start_input_thread()
 {
-    (void)key;
+#ifdef HAVE_TERMIOS_H
+    if (input_thread || pipe(wakeup_fds.data()) != 0)
+    {
+        return;
+    }
+
+    input_thread = std::make_unique<std::thread>(
+            &ScrollingTerminalImpl::run_input_thread, this);
+#endif
+}
+
+void ScrollingTerminalImpl::stop_input_thread()
+{
+#ifdef HAVE_TERMIOS_H
+    if (!input_thread)
+    {
+        return;
+    }
 
+    const Byte wakeup{};
+    if (write(wakeup_fds[1], &wakeup, 1) == 1)
+    {
+        input_thread->join();
+    }
+    else
     {
-        std::lock_guard<std::mutex> guard(serial_mutex);
-        // convert back space character
+        input_thread->detach();
+    }
+    input_thread.reset();
+    close(wakeup_fds[0]);
+    close(wakeup_fds[1]);
+    wakeup_fds = { -1, -1 };
+#endif
+}
+
+// Wait for terminal input and put it into the input buffer.
+// The thread exits on end of file or if woken up by stop_input_thread().
+void ScrollingTerminalImpl::run_input_thread()
+{
 #ifdef HAVE_TERMIOS_H
-#ifdef VERASE
+    flx::setCurrentThreadName("TerminalInputThread");
+    std::array<struct pollfd, 2> fds{};
+    std::array<Byte, 64> buffer{};
+
+    fds[0].fd = fileno(stdin);
+    fds[0].events = POLLIN;
+    fds[1].fd = wakeup_fds[0];
+    fds[1].events = POLLIN;
+
+    while (true)
+    {
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
 
-        if (key == save_termios.c_cc[VERASE] || key == 0x7f)
+        if (fds[1].revents != 0)
         {
-            key = BS;
+            return;
         }
 
+        if (fds[0].revents != 0)
+        {
+            ssize_t count;
+
+            {
+                LatencyScope latencyScope(hostLatency);
+                count = read(fds[0].fd, buffer.data(), buffer.size());
+            }
+
+            if (count == 0 || (count < 0 && errno != EINTR && errno != EAGAIN))
+            {
+                // End of file or terminal hang up.
+                return;
+            }
+
+            for (ssize_t i = 0; i < count; ++i)
+            {
+                if (!put_char_serial(buffer[static_cast<std::size_t>(i)]))
+                {
+                    return;
+                }
+            }
+        }
+    }
 #endif
-#endif // #ifdef HAVE_TERMIOS_H
+}
 
-        key_buffer_serial.push_back(key);
+// Called on the input thread. If the input buffer is full wait until
+// the CPU has read some characters.
+// Return false if the input thread has to exit.
+bool ScrollingTerminalImpl::put_char_serial(Byte key)
+{
+#ifdef HAVE_TERMIOS_H
+#ifdef VERASE
+    // convert back space character
+    if (key == save_termios.c_cc[VERASE] || key == 0x7f)
+    {
+        key = BS;
     }
+#endif
+
+    while (!key_buffer_serial.push(key))
+    {
+        struct pollfd wakeup_fd{};
 
-    Notify(NotifyId::KeyPressedOnCPU, &key);
+        wakeup_fd.fd = wakeup_fds[0];
+        wakeup_fd.events = POLLIN;
+        if (poll(&wakeup_fd, 1, 10) > 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+#else
+    (void)key;
+
+    return false;
+#endif // #ifdef HAVE_TERMIOS_H
 }
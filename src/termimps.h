@@ -28,12 +28,16 @@
 #include "termimpi.h"
 #include "bobservd.h"
 #include "soptions.h"
+#include "spscring.h"
+#include "iostat.h"
 #ifdef HAVE_TERMIOS_H
 #include <termios.h>
 #endif
-#include <mutex>
+#include <array>
+#include <memory>
 #include <string>
-#include <deque>
+#include <thread>
+#include <vector>
 
 struct sOptions;
 class TerminalIO;
@@ -49,12 +53,24 @@ class ScrollingTerminalImpl : public ITerminalImpl, public BObserved
     bool was_escape{};
     Word init_delay{};
     Word input_delay{};
-    std::mutex serial_mutex;
-    std::deque<Byte> key_buffer_serial;
+    // Characters received by the input thread.
+    SpscRing<Byte, 1024U> key_buffer_serial;
+    // Output buffer, only accessed on the CPU thread.
+    std::vector<Byte> output_buffer;
+    std::unique_ptr<std::thread> input_thread;
+    // Pipe to wake up the input thread for exit.
+    std::array<int, 2> wakeup_fds{-1, -1};
+    // Host time of the read and write system calls.
+    LatencyHistogram hostLatency;
 
 public:
     ScrollingTerminalImpl() = delete;
     explicit ScrollingTerminalImpl(const sOptions &p_options);
+    ~ScrollingTerminalImpl() override;
+    ScrollingTerminalImpl(const ScrollingTerminalImpl &src) = delete;
+    ScrollingTerminalImpl(ScrollingTerminalImpl &&src) = delete;
+    ScrollingTerminalImpl &operator=(const ScrollingTerminalImpl &src) = delete;
+    ScrollingTerminalImpl &operator=(ScrollingTerminalImpl &&src) = delete;
 
     // Interface ITerminalImpl
     bool init(Word reset_key, fct_sigaction fct) override;
@@ -63,13 +79,21 @@ public:
     Byte read_char_serial() override;
     Byte peek_char_serial() override;
     void write_char_serial(Byte val) override;
+    void flush_serial() override;
     bool is_terminal_supported() override;
-    void set_startup_command(const std::string &startup_command) override;
+    const LatencyHistogram *get_host_latency() override
+    {
+        return &hostLatency;
+    }
 
 private:
     void reset_terminal_io() override;
 
-    void put_char_serial(Byte key);
+    void start_input_thread();
+    void stop_input_thread();
+    void run_input_thread();
+    bool put_char_serial(Byte key);
     void write_char_serial_safe(Byte val);
+    void write_output_buffer();
 };
 #endif
@@ -44,6 +44,10 @@ TerminalIO::TerminalIO(Scheduler &p_scheduler, ITerminalImplPtr &&p_impl)
     , scheduler(p_scheduler)
 {
     instance = this;
+    // Buffered output is written at least once per timer event.
+    scheduler.add_timer_hook([this](QWord /*totalCycles*/){
+        flush_serial();
+    });
 #ifdef UNIX
     if (!is_atexit_initialized)
     {
@@ -135,6 +139,18 @@ void TerminalIO::write_char_serial(Byte value)
     impl->write_char_serial(value);
 }
 
+bool TerminalIO::can_write_char_serial()
+{
+    assert(impl != nullptr);
+    return impl->can_write_char_serial();
+}
+
+void TerminalIO::flush_serial()
+{
+    assert(impl != nullptr);
+    impl->flush_serial();
+}
+
 bool TerminalIO::is_terminal_supported()
 {
     assert(impl != nullptr);
@@ -142,10 +158,10 @@ bool TerminalIO::is_terminal_supported()
     return impl->is_terminal_supported();
 }
 
-void TerminalIO::set_startup_command(const std::string &startup_command)
+const LatencyHistogram *TerminalIO::get_host_latency()
 {
     assert(impl != nullptr);
-    impl->set_startup_command(startup_command);
+    return impl->get_host_latency();
 }
 
 void TerminalIO::reset_terminal_io()
@@ -30,6 +30,7 @@
 #include <csignal>
 
 class Scheduler;
+class LatencyHistogram;
 
 class TerminalIO : public BObserved
 {
@@ -59,8 +60,10 @@ public:
     Byte read_char_serial();
     Byte peek_char_serial();
     void write_char_serial(Byte val);
+    bool can_write_char_serial();
+    void flush_serial();
     bool is_terminal_supported();
-    void set_startup_command(const std::string &startup_command);
+    const LatencyHistogram *get_host_latency();
 
     static void on_exit();
 #ifdef _WIN32
@@ -0,0 +1,101 @@
+/*
+    turboctl.cpp  Automatic turbo mode during disk and compute bursts.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "turboctl.h"
+#include "bobshelp.h"
+#include <utility>
+
+
+TurboControl::TurboControl(SetTurboFunction p_setTurbo)
+    : setTurbo(std::move(p_setTurbo))
+{
+}
+
+void TurboControl::SetQuietTime(QWord p_quietTimeMs)
+{
+    quietTimeUs = p_quietTimeMs * 1000U;
+}
+
+void TurboControl::UpdateFrom(NotifyId id, void * /*param*/)
+{
+    switch (id)
+    {
+        case NotifyId::InputRequested:
+            // The time of the input request is taken on the next timer
+            // event, there is no need to read the host time on each poll.
+            isInputRequested = true;
+            SetTurbo(false);
+            break;
+
+        case NotifyId::DiskActive:
+            SetTurbo(true);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void TurboControl::OnTimer(QWord timeUs)
+{
+    if (isInputRequested)
+    {
+        isInputRequested = false;
+        lastInputTimeUs = timeUs;
+    }
+    else if (!isTurbo && timeUs - lastInputTimeUs >= quietTimeUs)
+    {
+        SetTurbo(true);
+    }
+}
+
+void TurboControl::SetTurbo(bool p_isTurbo)
+{
+    if (p_isTurbo != isTurbo)
+    {
+        isTurbo = p_isTurbo;
+        setTurbo(isTurbo);
+    }
+}
+
+bool InputPollDetector::OnPoll(QWord cycles, bool isCharAvailable)
+{
+    const auto delta = cycles - lastCycles;
+
+    if (isCharAvailable || isTransfer || delta != lastDelta ||
+        delta == 0U || delta > MAX_POLL_CYCLES)
+    {
+        pollCount = 0U;
+    }
+    else if (pollCount < MIN_POLLS)
+    {
+        ++pollCount;
+    }
+
+    lastCycles = cycles;
+    lastDelta = delta;
+    isTransfer = false;
+
+    return pollCount >= MIN_POLLS;
+}
@@ -0,0 +1,101 @@
+/*
+    turboctl.h  Automatic turbo mode during disk and compute bursts.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef TURBOCTL_INCLUDED
+#define TURBOCTL_INCLUDED
+
+#include "typedefs.h"
+#include "bobserv.h"
+#include <functional>
+
+
+// class TurboControl decides when the CPU frequency limit is dropped.
+// Turbo mode is switched on if a floppy disk command is executed
+// (NotifyId::DiskActive) or if the guest has not waited for keyboard
+// or serial input (NotifyId::InputRequested) for the quiet time.
+// It is switched off as soon as the guest waits for input again.
+// The quiet time is measured in host time and checked on each timer event.
+// All functions are called on the CPU thread.
+class TurboControl : public BObserver
+{
+public:
+    using SetTurboFunction = std::function<void(bool)>;
+
+    TurboControl() = delete;
+    explicit TurboControl(SetTurboFunction p_setTurbo);
+    ~TurboControl() override = default;
+    TurboControl(const TurboControl &src) = delete;
+    TurboControl(TurboControl &&src) = delete;
+    TurboControl &operator=(const TurboControl &src) = delete;
+    TurboControl &operator=(TurboControl &&src) = delete;
+
+    void SetQuietTime(QWord p_quietTimeMs);
+    void UpdateFrom(NotifyId id, void *param = nullptr) override;
+    // Called on each timer event with the host time in microseconds.
+    void OnTimer(QWord timeUs);
+    bool IsTurbo() const
+    {
+        return isTurbo;
+    }
+
+private:
+    void SetTurbo(bool p_isTurbo);
+
+    SetTurboFunction setTurbo;
+    QWord quietTimeUs{};
+    QWord lastInputTimeUs{};
+    bool isInputRequested{true};
+    bool isTurbo{};
+};
+
+// class InputPollDetector detects a guest which is blocked waiting for
+// input. An input device calls OnPoll() on each status register read
+// and OnTransfer() on each data register access. The guest is blocked
+// if the status is polled MIN_POLLS times without a character available,
+// with the same number of CPU cycles of at most MAX_POLL_CYCLES between
+// two polls and without a data transfer in between.
+// Status reads within an output routine, e.g. a check for Ctrl-X on each
+// output character, are no input requests.
+// All functions are called on the CPU thread.
+class InputPollDetector
+{
+public:
+    // Maximum number of CPU cycles of one polling loop iteration.
+    static constexpr QWord MAX_POLL_CYCLES = 256U;
+    // Number of matching polls until the guest is blocked waiting for input.
+    static constexpr DWord MIN_POLLS = 16U;
+
+    // Return true if the guest is blocked waiting for input.
+    bool OnPoll(QWord cycles, bool isCharAvailable);
+    inline void OnTransfer()
+    {
+        isTransfer = true;
+    }
+
+private:
+    QWord lastCycles{};
+    QWord lastDelta{};
+    DWord pollCount{};
+    bool isTransfer{true};
+};
+
+#endif
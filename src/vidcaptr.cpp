@@ -0,0 +1,289 @@
+/*
+    vidcaptr.cpp  Capture video RAM into image files.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "e2.h"
+#include "misc1.h"
+#include "vidcaptr.h"
+#include "cvidram.h"
+#include "schedule.h"
+#include "soptions.h"
+#include "bobshelp.h"
+#include "colors.h"
+#include "vramconv.h"
+#include "imgfile.h"
+#include "warnoff.h"
+#include <fmt/format.h>
+#include "warnon.h"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <filesystem>
+
+
+// Maximum number of frames waiting to be written. If all of them are in use
+// capturing a frame blocks until the worker thread has written one.
+static constexpr std::size_t MAX_PENDING_FRAMES = 8U;
+
+VideoCapture::VideoCapture(Scheduler &p_scheduler, Memory &p_memory,
+        VideoControl1 &p_vico1, VideoControl2 &p_vico2,
+        const struct sOptions &p_options)
+    : scheduler(p_scheduler)
+    , memory(p_memory)
+    , vico1(p_vico1)
+    , vico2(p_vico2)
+    , options(p_options)
+    , pixels(static_cast<size_t>(WINDOWWIDTH) * WINDOWHEIGHT)
+    , image(static_cast<size_t>(WINDOWWIDTH) * WINDOWHEIGHT)
+{
+    scheduler.add_timer_hook([this](QWord totalCycles){
+        OnTimer(totalCycles);
+    });
+    workerThread = std::make_unique<std::thread>(&VideoCapture::Run, this);
+}
+
+VideoCapture::~VideoCapture()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        isExit.store(true);
+    }
+    condition.notify_all();
+
+    if (workerThread)
+    {
+        workerThread->join();
+        workerThread.reset();
+    }
+}
+
+bool VideoCapture::IsSupportedFile(const fs::path &path)
+{
+    const auto ext = flx::tolower(path.extension().u8string());
+
+    return ext == ".png" || ext == ".raw";
+}
+
+bool VideoCapture::CaptureFrame(const fs::path &path)
+{
+    if (!IsSupportedFile(path))
+    {
+        return false;
+    }
+
+    Frame frame;
+
+    frame.path = path;
+    frame.color = options.color;
+    frame.nColors = options.nColors;
+    frame.isInverse = options.isInverse;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if (freeSnapshots.empty() && frames.size() < MAX_PENDING_FRAMES)
+        {
+            freeSnapshots.push_back(std::make_shared<CReadVideoRam>(
+                memory, vico1, vico2, VideoRamConsumer::Capture));
+        }
+        condition.wait(lock, [&](){ return !freeSnapshots.empty(); });
+        frame.snapshot = std::move(freeSnapshots.back());
+        freeSnapshots.pop_back();
+    }
+
+    // All blocks are copied on the first capture or if the color
+    // conversion has changed. Afterwards only the changed blocks.
+    const bool isForceUpdate = frame.nColors != lastNColors ||
+        frame.isInverse != lastIsInverse || frame.color != lastColor;
+    lastColor = frame.color;
+    lastNColors = frame.nColors;
+    lastIsInverse = frame.isInverse;
+
+    // Executed directly, the caller is on the CPU thread or the
+    // CPU thread is not running.
+    frame.snapshot->Prepare(flx::getColorPlanes(frame.nColors),
+                            isForceUpdate);
+    frame.snapshot->Execute();
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        frames.push_back(std::move(frame));
+    }
+    condition.notify_all();
+
+    return true;
+}
+
+bool VideoCapture::StartSequence(const fs::path &path, QWord p_cycleInterval)
+{
+    if (!IsSupportedFile(path) || p_cycleInterval == 0U)
+    {
+        return false;
+    }
+
+    sequencePath = path;
+    cycleInterval = p_cycleInterval;
+    nextCycles = scheduler.get_total_cycles() + cycleInterval;
+    sequenceNumber = 0U;
+
+    return true;
+}
+
+void VideoCapture::StopSequence()
+{
+    cycleInterval = 0U;
+}
+
+void VideoCapture::OnTimer(QWord totalCycles)
+{
+    if (cycleInterval == 0U || totalCycles < nextCycles)
+    {
+        return;
+    }
+
+    auto path = sequencePath;
+    const auto ext = path.extension();
+    const auto stem = path.stem().u8string();
+
+    path.replace_filename(
+        fs::u8path(fmt::format("{}_{:06}", stem, sequenceNumber++)));
+    path.replace_extension(ext);
+    CaptureFrame(path);
+
+    while (nextCycles <= totalCycles)
+    {
+        nextCycles += cycleInterval;
+    }
+}
+
+void VideoCapture::UpdateFrom(NotifyId id, void *param)
+{
+    if (id == NotifyId::CaptureVideo && param != nullptr)
+    {
+        auto &request = *static_cast<VideoCaptureRequest_t *>(param);
+        const auto path = fs::u8path(request.filePath);
+
+        if (request.filePath.empty())
+        {
+            StopSequence();
+            request.isAccepted = true;
+        }
+        else if (request.cycleInterval == 0U)
+        {
+            request.isAccepted = CaptureFrame(path);
+        }
+        else
+        {
+            request.isAccepted = StartSequence(path, request.cycleInterval);
+        }
+    }
+}
+
+void VideoCapture::Run()
+{
+    flx::setCurrentThreadName("VideoCaptureThread");
+
+    while (true)
+    {
+        Frame frame;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&](){
+                return !frames.empty() || isExit.load();
+            });
+
+            // All pending frames are written before exit.
+            if (frames.empty())
+            {
+                return;
+            }
+
+            frame = std::move(frames.front());
+            frames.pop_front();
+        }
+
+        WriteFrame(frame);
+
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            freeSnapshots.push_back(std::move(frame.snapshot));
+        }
+        condition.notify_all();
+    }
+}
+
+// Convert the changed blocks of a frame into the pixel buffer and write it
+// into a file. The screen is rotated by the first raster line so that the
+// file contains the screen as displayed.
+void VideoCapture::WriteFrame(const Frame &frame)
+{
+    const auto &snapshot = *frame.snapshot;
+    const auto &blocks = snapshot.GetChangedBlocks();
+    const bool isVideoBankValid = snapshot.IsVideoBankValid();
+
+    // A forced update contains all blocks.
+    if (blocks.all() || colorTable.empty())
+    {
+        colorTable = flx::createColorTable(frame.color, frame.isInverse);
+    }
+
+    for (int blockNumber = 0; blockNumber < YBLOCKS; ++blockNumber)
+    {
+        if (blocks.test(static_cast<size_t>(blockNumber)))
+        {
+            auto offset = static_cast<size_t>(blockNumber) * BLOCKHEIGHT *
+                          WINDOWWIDTH;
+            flx::convertVideoRamBlock(&pixels[offset], WINDOWWIDTH,
+                isVideoBankValid ? snapshot.GetBlockData(blockNumber) :
+                                   nullptr,
+                frame.nColors, frame.isInverse);
+        }
+    }
+
+    const auto firstRasterLine =
+        static_cast<size_t>(snapshot.GetFirstRasterLine());
+    for (size_t row = 0U; row < WINDOWHEIGHT; ++row)
+    {
+        const auto srcRow = (row + firstRasterLine) % WINDOWHEIGHT;
+
+        std::memcpy(&image[row * WINDOWWIDTH], &pixels[srcRow * WINDOWWIDTH],
+                    WINDOWWIDTH);
+    }
+
+    const auto ext = flx::tolower(frame.path.extension().u8string());
+    const bool isSuccess = (ext == ".png") ?
+        flx::writePngFile(frame.path, WINDOWWIDTH, WINDOWHEIGHT,
+                          image.data(), colorTable) :
+        flx::writeRawFile(frame.path, image.data(), image.size());
+
+    if (!isSuccess)
+    {
+        std::cerr << "*** Error: Unable to write capture file " <<
+                     frame.path << '\n';
+    }
+}
@@ -0,0 +1,127 @@
+/*
+    vidcaptr.h  Capture video RAM into image files.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef VIDCAPTR_INCLUDED
+#define VIDCAPTR_INCLUDED
+
+#include "typedefs.h"
+#include "e2.h"
+#include "bobserv.h"
+#include "cvidram.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+class Memory;
+class Scheduler;
+class VideoControl1;
+class VideoControl2;
+struct sOptions;
+
+// class VideoCapture captures the video RAM into image files without
+// any GUI. Supported file formats are PNG (*.png) and raw 8-bit color
+// indices (*.raw).
+// The video RAM snapshot is taken on the CPU thread (see CReadVideoRam),
+// only blocks changed since the last capture are copied. Converting
+// and writing the file is done on a separate worker thread.
+// A sequence of frames can be captured with a fixed interval of CPU cycles.
+// The interval is checked on each scheduler timer event, so a frame is
+// captured on the first timer event after the interval has elapsed.
+class VideoCapture : public BObserver
+{
+    struct Frame
+    {
+        CReadVideoRamSPtr snapshot;
+        fs::path path;
+        std::string color;
+        int nColors{2};
+        bool isInverse{};
+    };
+
+public:
+    VideoCapture() = delete;
+    VideoCapture(Scheduler &p_scheduler, Memory &p_memory,
+                 VideoControl1 &p_vico1, VideoControl2 &p_vico2,
+                 const struct sOptions &p_options);
+    ~VideoCapture() override;
+    VideoCapture(const VideoCapture &src) = delete;
+    VideoCapture(VideoCapture &&src) = delete;
+    VideoCapture &operator=(const VideoCapture &src) = delete;
+    VideoCapture &operator=(VideoCapture &&src) = delete;
+
+    // The following functions have to be called on the CPU thread or
+    // while the CPU thread is not running.
+
+    // Capture one frame into a file. Return false if the file extension
+    // is not supported.
+    bool CaptureFrame(const fs::path &path);
+    // Capture a frame each cycleInterval CPU cycles. A six digit sequence
+    // number is appended to the file name. Return false if the file
+    // extension is not supported.
+    bool StartSequence(const fs::path &path, QWord cycleInterval);
+    void StopSequence();
+
+    void UpdateFrom(NotifyId id, void *param = nullptr) override;
+
+    static bool IsSupportedFile(const fs::path &path);
+
+private:
+    void OnTimer(QWord totalCycles);
+    void Run();
+    void WriteFrame(const Frame &frame);
+
+    Scheduler &scheduler;
+    Memory &memory;
+    VideoControl1 &vico1;
+    VideoControl2 &vico2;
+    const struct sOptions &options;
+    // Sequence state, only accessed on the CPU thread.
+    fs::path sequencePath;
+    QWord cycleInterval{};
+    QWord nextCycles{};
+    DWord sequenceNumber{};
+    std::string lastColor;
+    int lastNColors{};
+    bool lastIsInverse{};
+    // Frames to be written and unused snapshots, protected by mutex.
+    std::deque<Frame> frames;
+    std::vector<CReadVideoRamSPtr> freeSnapshots;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<bool> isExit{};
+    std::unique_ptr<std::thread> workerThread;
+    // Worker thread state.
+    std::vector<Byte> pixels;
+    std::vector<Byte> image;
+    std::vector<DWord> colorTable;
+};
+
+#endif
@@ -0,0 +1,280 @@
+/*
+    vidrendr.cpp  Convert video RAM into an image on a worker thread.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "e2.h"
+#include "misc1.h"
+#include "vidrendr.h"
+#include "cvidram.h"
+#include "schedule.h"
+#include "vramconv.h"
+#include "warnoff.h"
+#include <QImage>
+#include "warnon.h"
+#include <cassert>
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <algorithm>
+
+
+VideoRenderer::VideoRenderer(Scheduler &p_scheduler, Memory &p_memory,
+        VideoControl1 &p_vico1, VideoControl2 &p_vico2,
+        FrameReadyCallback p_frameReadyCallback)
+    : scheduler(p_scheduler)
+    , frameReadyCallback(std::move(p_frameReadyCallback))
+    , readVideoRamCommand(
+            std::make_shared<CReadVideoRam>(p_memory, p_vico1, p_vico2))
+    , buffers{
+        QImage(WINDOWWIDTH, WINDOWHEIGHT, QImage::Format_Indexed8),
+        QImage(WINDOWWIDTH, WINDOWHEIGHT, QImage::Format_Indexed8)
+      }
+    , frontBuffer(&buffers[0])
+    , backBuffer(&buffers[1])
+{
+    frontBuffer->fill(0U);
+    backBuffer->fill(0U);
+    workerThread = std::make_unique<std::thread>(&VideoRenderer::Run, this);
+}
+
+VideoRenderer::~VideoRenderer()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        isExit.store(true);
+    }
+    condition.notify_one();
+
+    if (workerThread)
+    {
+        workerThread->join();
+        workerThread.reset();
+    }
+}
+
+void VideoRenderer::SetColorTable(const ColorTable &p_colorTable,
+        int p_nColors, bool p_isInverse)
+{
+    assert(!p_colorTable.empty());
+
+    std::lock_guard<std::mutex> guard(mutex);
+    newColorTable = p_colorTable;
+    newNColors = p_nColors;
+    newIsInverse = p_isInverse;
+    isNewColorTable = true;
+    isFrameRequested = true;
+    condition.notify_one();
+}
+
+void VideoRenderer::RequestFrame(bool isForceUpdate)
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        isFrameRequested = true;
+        isForceUpdateRequested |= isForceUpdate;
+    }
+    condition.notify_one();
+}
+
+void VideoRenderer::SetMaxRefreshRate(int rate)
+{
+    assert(rate > 0);
+
+    std::lock_guard<std::mutex> guard(mutex);
+    minFrameInterval = std::chrono::microseconds(1000000 / std::max(rate, 1));
+}
+
+void VideoRenderer::NotifyVideoRamChanged()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        isVideoRamChanged = true;
+    }
+    condition.notify_one();
+}
+
+bool VideoRenderer::TakeFrame(QImage &image, BlockSet &blocks,
+        Byte &firstRasterLine)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    if (!hasFrame)
+    {
+        return false;
+    }
+
+    // Implicitly shared copy. If the worker thread writes into this buffer
+    // later on it gets detached.
+    image = *frontBuffer;
+    blocks = frontBlocks;
+    firstRasterLine = frontFirstRasterLine;
+    frontBlocks.reset();
+    hasFrame = false;
+
+    return true;
+}
+
+void VideoRenderer::Run()
+{
+    flx::setCurrentThreadName("VideoRendererThread");
+    auto nextFrameTime = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        bool isForceUpdate;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&](){
+                return isFrameRequested || isVideoRamChanged || isExit.load();
+            });
+
+            // Limit the refresh rate. Video RAM changes until then are
+            // collected into the next frame.
+            if (!isExit.load() && !isForceUpdateRequested &&
+                !isNewColorTable)
+            {
+                condition.wait_until(lock, nextFrameTime, [&](){
+                    return isExit.load();
+                });
+            }
+
+            if (isExit.load())
+            {
+                return;
+            }
+
+            isFrameRequested = false;
+            isVideoRamChanged = false;
+            nextFrameTime = std::chrono::steady_clock::now() +
+                            minFrameInterval;
+            isForceUpdate = isForceUpdateRequested;
+            isForceUpdateRequested = false;
+            if (isNewColorTable)
+            {
+                colorTable = newColorTable;
+                nColors = newNColors;
+                isInverse = newIsInverse;
+                isNewColorTable = false;
+                isForceUpdate = true;
+            }
+        }
+
+        if (colorTable.empty())
+        {
+            // No color table has been set yet.
+            continue;
+        }
+
+        // The video RAM snapshot is taken on the CPU thread.
+        readVideoRamCommand->Prepare(flx::getColorPlanes(nColors),
+                                     isForceUpdate);
+        scheduler.sync_exec(readVideoRamCommand);
+        while (!readVideoRamCommand->WaitForExecution(
+                    std::chrono::milliseconds(100)))
+        {
+            if (isExit.load())
+            {
+                return;
+            }
+        }
+
+        if (backBuffer->colorTable() != colorTable)
+        {
+            backBuffer->setColorTable(colorTable);
+        }
+
+        const auto &blocks = readVideoRamCommand->GetChangedBlocks();
+        const bool isVideoBankValid = readVideoRamCommand->IsVideoBankValid();
+        for (int blockNumber = 0; blockNumber < YBLOCKS; ++blockNumber)
+        {
+            if (blocks.test(static_cast<size_t>(blockNumber)))
+            {
+                ConvertBlock(blockNumber, isVideoBankValid ?
+                    readVideoRamCommand->GetBlockData(blockNumber) : nullptr);
+            }
+        }
+
+        if (PublishFrame(blocks, readVideoRamCommand->GetFirstRasterLine()) &&
+            frameReadyCallback)
+        {
+            frameReadyCallback();
+        }
+    }
+}
+
+// Convert one block of video RAM into indexed pixels of the back buffer.
+// videoRam contains all color planes of the block consecutively.
+// If videoRam is nullptr no video source is available.
+void VideoRenderer::ConvertBlock(int blockNumber, Byte const *videoRam)
+{
+    flx::convertVideoRamBlock(backBuffer->scanLine(blockNumber * BLOCKHEIGHT),
+            static_cast<size_t>(backBuffer->bytesPerLine()), videoRam,
+            nColors, isInverse);
+}
+
+// Publish the back buffer as new front buffer.
+// Return false if nothing has changed.
+bool VideoRenderer::PublishFrame(const BlockSet &blocks, Byte firstRasterLine)
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        if (blocks.none() && firstRasterLine == frontFirstRasterLine)
+        {
+            // Nothing has changed.
+            return false;
+        }
+
+        std::swap(frontBuffer, backBuffer);
+        frontBlocks |= blocks;
+        frontFirstRasterLine = firstRasterLine;
+        hasFrame = true;
+    }
+
+    // Bring the new back buffer up to date. The front buffer is only
+    // read by any thread, so this can be done without lock.
+    if (backBuffer->colorTable() != colorTable)
+    {
+        backBuffer->setColorTable(colorTable);
+    }
+
+    for (int blockNumber = 0; blockNumber < YBLOCKS; ++blockNumber)
+    {
+        if (blocks.test(static_cast<size_t>(blockNumber)))
+        {
+            for (int row = 0; row < BLOCKHEIGHT; ++row)
+            {
+                const auto y = (blockNumber * BLOCKHEIGHT) + row;
+
+                std::memcpy(backBuffer->scanLine(y),
+                            frontBuffer->constScanLine(y), WINDOWWIDTH);
+            }
+        }
+    }
+
+    return true;
+}
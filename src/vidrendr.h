@@ -0,0 +1,131 @@
+/*
+    vidrendr.h  Convert video RAM into an image on a worker thread.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef VIDRENDR_INCLUDED
+#define VIDRENDR_INCLUDED
+
+#include "typedefs.h"
+#include "e2.h"
+#include "cvidram.h"
+#include "warnoff.h"
+#include <QtGlobal>
+#include <QVector>
+#include <QRgb>
+#include <QImage>
+#include "warnon.h"
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+class Memory;
+class Scheduler;
+class VideoControl1;
+class VideoControl2;
+
+using ColorTable = QVector<QRgb>;
+
+// class VideoRenderer converts the video RAM into an indexed 8-bit image
+// on a separate worker thread.
+// The video RAM is copied on the CPU thread (see CReadVideoRam) and
+// converted on the worker thread into a back buffer. A finished frame
+// is published by swapping back and front buffer. The GUI thread only has
+// to blit the changed blocks of the front buffer.
+// A new frame is only converted if video RAM has changed or a frame
+// has been requested, the frame rate is limited by a maximum refresh rate.
+// If nothing changes the worker thread is idle. When a frame is ready
+// to be taken frameReadyCallback is called on the worker thread.
+class VideoRenderer
+{
+public:
+    using BlockSet = CReadVideoRam::BlockSet;
+    using FrameReadyCallback = std::function<void()>;
+
+    VideoRenderer() = delete;
+    VideoRenderer(Scheduler &p_scheduler, Memory &p_memory,
+                  VideoControl1 &p_vico1, VideoControl2 &p_vico2,
+                  FrameReadyCallback p_frameReadyCallback);
+    ~VideoRenderer();
+    VideoRenderer(const VideoRenderer &src) = delete;
+    VideoRenderer(VideoRenderer &&src) = delete;
+    VideoRenderer &operator=(const VideoRenderer &src) = delete;
+    VideoRenderer &operator=(VideoRenderer &&src) = delete;
+
+    // The following functions are called on the GUI thread.
+
+    // Set the color table and the color conversion parameters.
+    // All blocks are converted again.
+    void SetColorTable(const ColorTable &p_colorTable, int p_nColors,
+                       bool p_isInverse);
+    // Request the conversion of a new frame. Requests are coalesced
+    // while the worker thread is busy.
+    void RequestFrame(bool isForceUpdate = false);
+    // Set the maximum number of frames per second.
+    void SetMaxRefreshRate(int rate);
+    // If a new frame is available return true and the front buffer,
+    // the blocks changed since the last call and the first raster line.
+    bool TakeFrame(QImage &image, BlockSet &blocks, Byte &firstRasterLine);
+
+    // Called on the CPU thread if video RAM has changed.
+    void NotifyVideoRamChanged();
+
+private:
+    void Run();
+    void ConvertBlock(int blockNumber, Byte const *videoRam);
+    bool PublishFrame(const BlockSet &blocks, Byte firstRasterLine);
+
+    Scheduler &scheduler;
+    FrameReadyCallback frameReadyCallback;
+    CReadVideoRamSPtr readVideoRamCommand;
+    std::array<QImage, 2> buffers;
+    QImage *frontBuffer{};
+    QImage *backBuffer{};
+    // Parameters owned by the worker thread.
+    ColorTable colorTable;
+    int nColors{2};
+    bool isInverse{};
+    // Parameters passed from the GUI thread, protected by mutex.
+    ColorTable newColorTable;
+    int newNColors{2};
+    bool newIsInverse{};
+    bool isNewColorTable{};
+    bool isFrameRequested{};
+    bool isForceUpdateRequested{true};
+    bool isVideoRamChanged{};
+    std::chrono::microseconds minFrameInterval{20000};
+    // Front buffer state, protected by mutex.
+    BlockSet frontBlocks;
+    Byte frontFirstRasterLine{0U};
+    bool hasFrame{};
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<bool> isExit{};
+    std::unique_ptr<std::thread> workerThread;
+};
+
+#endif
@@ -0,0 +1,144 @@
+/*
+    vramconv.cpp  Convert Eurocom II video RAM into indexed pixels.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "typedefs.h"
+#include "e2.h"
+#include "vramconv.h"
+#include <cassert>
+#include <cstring>
+#include <cstddef>
+#include <array>
+
+
+Byte flx::getColorPlanes(int nColors)
+{
+    if (nColors > 8)
+    {
+        return static_cast<Byte>(COLOR_PLANES);
+    }
+
+    return (nColors > 2) ? 3U : 1U;
+}
+
+void flx::convertVideoRamBlock(Byte *pixels, std::size_t bytesPerLine,
+                               Byte const *videoRam, int nColors,
+                               bool isInverse)
+{
+    assert(pixels != nullptr);
+    assert(nColors > 0);
+
+    std::array<Byte, 6> planes{}; /* One byte of video RAM for each plane */
+    // Default color index: If no video source is available use highest
+    // available color
+    const Byte defaultColorIndex = isInverse ? 0x00U : 0x3FU;
+    Byte colorIndexOffset = 0U;
+    if (isInverse)
+    {
+        colorIndexOffset = static_cast<Byte>(
+                (64U / static_cast<unsigned>(nColors)) - 1U);
+    }
+
+    for (int row = 0; row < BLOCKHEIGHT; ++row)
+    {
+        auto *pData = pixels + (static_cast<std::size_t>(row) * bytesPerLine);
+
+        if (videoRam == nullptr)
+        {
+            std::memset(pData, defaultColorIndex, WINDOWWIDTH);
+            continue;
+        }
+
+        for (int column = 0; column < RASTERLINE_SIZE; ++column)
+        {
+            const auto offset = (row * RASTERLINE_SIZE) + column;
+
+            planes[0] = videoRam[offset];
+
+            if (nColors > 2)
+            {
+                planes[2] = videoRam[YBLOCK_SIZE + offset];
+                planes[4] = videoRam[(YBLOCK_SIZE * 2) + offset];
+
+                if (nColors > 8)
+                {
+                    planes[1] = videoRam[(YBLOCK_SIZE * 3) + offset];
+                    planes[3] = videoRam[(YBLOCK_SIZE * 4) + offset];
+                    planes[5] = videoRam[(YBLOCK_SIZE * 5) + offset];
+                }
+            }
+
+            /* Loop from MSBit to LSBit */
+            for (Byte pixelBitMask = 0x80U; pixelBitMask;
+                 pixelBitMask >>= 1U)
+            {
+                Byte colorIndex = colorIndexOffset; /* calculated color index */
+
+                if (planes[0] & pixelBitMask)
+                {
+                    colorIndex += GREEN_HIGH; // 0x0C, green high
+                }
+
+                if (nColors > 8)
+                {
+                    if (planes[2] & pixelBitMask)
+                    {
+                        colorIndex += RED_HIGH; // 0x0D, red high
+                    }
+
+                    if (planes[4] & pixelBitMask)
+                    {
+                        colorIndex += BLUE_HIGH; // 0x0E, blue high
+                    }
+
+                    if (planes[1] & pixelBitMask)
+                    {
+                        colorIndex += GREEN_LOW; // 0x04, green low
+                    }
+
+                    if (planes[3] & pixelBitMask)
+                    {
+                        colorIndex += RED_LOW; // 0x05, red low
+                    }
+
+                    if (planes[5] & pixelBitMask)
+                    {
+                        colorIndex += BLUE_LOW; // 0x06, blue low
+                    }
+                }
+                else
+                {
+                    if (planes[2] & pixelBitMask)
+                    {
+                        colorIndex += RED_HIGH; // 0x0D, red high
+                    }
+
+                    if (planes[4] & pixelBitMask)
+                    {
+                        colorIndex += BLUE_HIGH; // 0x0E, blue high
+                    }
+                }
+                *(pData++) = colorIndex;
+            }
+        }
+    }
+}
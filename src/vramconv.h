@@ -0,0 +1,49 @@
+/*
+    vramconv.h  Convert Eurocom II video RAM into indexed pixels.
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef VRAMCONV_INCLUDED
+#define VRAMCONV_INCLUDED
+
+#include "typedefs.h"
+#include <cstddef>
+
+
+namespace flx
+{
+    // Return the number of color planes (1, 3 or 6) needed to display
+    // nColors colors or gray scale values.
+    extern Byte getColorPlanes(int nColors);
+    // Convert one block of video RAM into indexed 8-bit pixels.
+    // Each pixel is an index into the color table created by
+    // flx::createColorTable().
+    // pixels:       Pixel buffer of the first raster line of the block.
+    // bytesPerLine: Offset in bytes between two raster lines in pixels.
+    // videoRam:     All color planes of the block stored consecutively,
+    //               each of size YBLOCK_SIZE. If nullptr no video source
+    //               is available and the block is filled with a default
+    //               color.
+    extern void convertVideoRamBlock(Byte *pixels, std::size_t bytesPerLine,
+                                     Byte const *videoRam, int nColors,
+                                     bool isInverse);
+}
+
+#endif
@@ -102,6 +102,7 @@ Byte Wd1793::readIo(Word offset)
                 else
                 {
                     byteCount = getBytesPerSector();
+                    startSectorTransfer(cr & 0xF0U);
                 }
             }
 
@@ -160,6 +161,7 @@ void Wd1793::writeIo(Word offset, Byte val)
                 else
                 {
                     byteCount = getBytesPerSector();
+                    startSectorTransfer(cr & 0xF0U);
                 }
             }
 
@@ -262,6 +264,7 @@ void Wd1793::command(Byte command)
                     byteCount = getBytesPerSector();
                     isDataRequest = true;
                     str = (STR_BUSY | STR_DATAREQUEST);
+                    startSectorTransfer(cr & 0xF0U);
                 }
 
                 break;
@@ -291,6 +294,7 @@ void Wd1793::command(Byte command)
                     byteCount = getBytesPerSector();
                     isDataRequest = true;
                     str = STR_DATAREQUEST;
+                    startSectorTransfer(cr & 0xF0U);
                 }
 
                 break;
@@ -372,6 +376,11 @@ bool Wd1793::startCommand(Byte /*command_un*/)
     return true;
 }
 
+// should be reimplemented by subclass.
+void Wd1793::startSectorTransfer(Byte /*command_un*/)
+{
+}
+
 Byte Wd1793::readByte(Word index, Byte /*command_un*/)
 {
     return static_cast<Byte>(index);
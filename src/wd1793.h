@@ -187,6 +187,10 @@ protected:
 
     // Read and write functions
     virtual bool startCommand(Byte command_un);
+    // Called once for each sector of a read or write sector command
+    // before the first byte is transferred. A read error can be signaled
+    // by setStatusReadError().
+    virtual void startSectorTransfer(Byte command_un);
     virtual Byte readByte(Word index, Byte command_un);
     virtual void writeByte(Word &index, Byte command_un);
     virtual bool isDriveReady() const;
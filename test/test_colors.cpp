@@ -23,6 +23,7 @@
 
 #include "gtest/gtest.h"
 #include "typedefs.h"
+#include "e2.h"
 #include "colors.h"
 
 
@@ -60,3 +61,23 @@ TEST(test_colors, fct_getColorForName)
     EXPECT_FALSE(flx::getColorForName("invalid", rgbColor));
 }
 
+
+TEST(test_colors, fct_createColorTable)
+{
+    auto colorTable = flx::createColorTable("white", false);
+    ASSERT_EQ(colorTable.size(), 64U);
+    EXPECT_EQ(colorTable[0], 0xFF000000U);
+    EXPECT_EQ(colorTable[63], 0xFFFFFFFFU);
+    colorTable = flx::createColorTable("white", true);
+    ASSERT_EQ(colorTable.size(), 64U);
+    EXPECT_EQ(colorTable[0], 0xFFFFFFFFU);
+    EXPECT_EQ(colorTable[63], 0xFF000000U);
+    colorTable = flx::createColorTable("blue", false);
+    EXPECT_EQ(colorTable[63], 0xFF0000FFU);
+    colorTable = flx::createColorTable("default", false);
+    ASSERT_EQ(colorTable.size(), 64U);
+    EXPECT_EQ(colorTable[0], 0xFF000000U);
+    EXPECT_EQ(colorTable[GREEN_HIGH], 0xFF00AA00U);
+    EXPECT_EQ(colorTable[RED_HIGH | RED_LOW], 0xFFFF0000U);
+    EXPECT_EQ(colorTable[63], 0xFFFFFFFFU);
+}
@@ -271,6 +271,143 @@ TEST(test_fcnffile, fct_GetRuntimeSupportOption)
         EXPECT_EQ(expectedValue, value);
         fs::remove(path);
     }
+
+    for (const auto &expectedValue : validFlagStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "syncDisplayRefresh=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value =
+            cnfFile.GetRuntimeSupportOption("syncDisplayRefresh");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
+
+    for (const auto &expectedValue : validFlagStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "idleLoopDetection=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value =
+            cnfFile.GetRuntimeSupportOption("idleLoopDetection");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
+
+    for (const auto &expectedValue : validFlagStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "rtcEmulatedTime=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value =
+            cnfFile.GetRuntimeSupportOption("rtcEmulatedTime");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
+
+    for (const auto &expectedValue : validFlagStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "diskDriverHLE=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value = cnfFile.GetRuntimeSupportOption("diskDriverHLE");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
+
+    static const std::vector<const char *> validRefreshRateStrings
+    {
+        "1", "25", "50", "60", "144", "240",
+    };
+
+    for (const auto &expectedValue : validRefreshRateStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "maxDisplayRefreshRate=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value =
+            cnfFile.GetRuntimeSupportOption("maxDisplayRefreshRate");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
+
+    static const std::vector<const char *> validPacingSliceStrings
+    {
+        "0", "100", "500", "1000", "10000",
+    };
+
+    for (const auto &expectedValue : validPacingSliceStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "frequencyPacingSlice=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value =
+            cnfFile.GetRuntimeSupportOption("frequencyPacingSlice");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
+
+    static const std::vector<const char *> validTurboQuietTimeStrings
+    {
+        "0", "10", "500", "60000",
+    };
+
+    for (const auto &expectedValue : validTurboQuietTimeStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "turboOnDemand=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value = cnfFile.GetRuntimeSupportOption("turboOnDemand");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
+
+    static const std::vector<const char *> validSectorCacheStrings
+    {
+        "0", "16", "1024", "16384",
+    };
+
+    for (const auto &expectedValue : validSectorCacheStrings)
+    {
+        std::fstream ofs(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[RuntimeSupport]\n"
+            "diskSectorCache=" << expectedValue << "\n";
+        ofs.close();
+        FlexemuConfigFile cnfFile(path);
+        const auto value = cnfFile.GetRuntimeSupportOption("diskSectorCache");
+        EXPECT_EQ(expectedValue, value);
+        fs::remove(path);
+    }
 }
 
 TEST(test_fcnffile, fct_GetSerparAddress)
@@ -363,6 +500,48 @@ TEST(test_fcnffile, fct_GetBootCharacter)
     fs::remove(path);
 }
 
+TEST(test_fcnffile, fct_GetDiskDriverEntryPoints)
+{
+    const auto path = fs::temp_directory_path() / u8"cnf43.conf";
+    std::fstream ofs(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[DiskDriverHLE]\n"
+        "neumon54.hex=DE00,DE03\n"
+        "mon54.s19= de00,de03,2000 \n";
+    ofs.close();
+    FlexemuConfigFile cnfFile(path);
+    ASSERT_TRUE(cnfFile.IsValid());
+#ifdef _WIN32
+    auto monitorFilePath = fs::u8path(u8"C:\\Temp\\subdir1\\neumon54.hex");
+#else
+    auto monitorFilePath = fs::u8path(u8"/tmp/subdir1/neumon54.hex");
+#endif
+    auto optional_value = cnfFile.GetDiskDriverEntryPoints(monitorFilePath);
+    ASSERT_TRUE(optional_value.has_value());
+    // false positive
+    // NOLINTBEGIN(bugprone-unchecked-optional-access)
+    EXPECT_EQ(optional_value.value().readAddress, 0xDE00);
+    EXPECT_EQ(optional_value.value().writeAddress, 0xDE03);
+    EXPECT_FALSE(optional_value.value().cycles.has_value());
+    // NOLINTEND(bugprone-unchecked-optional-access)
+    monitorFilePath = fs::u8path(u8"anydir") / u8"mon54.s19";
+    optional_value = cnfFile.GetDiskDriverEntryPoints(monitorFilePath);
+    ASSERT_TRUE(optional_value.has_value());
+    // false positive
+    // NOLINTBEGIN(bugprone-unchecked-optional-access)
+    EXPECT_EQ(optional_value.value().readAddress, 0xDE00);
+    EXPECT_EQ(optional_value.value().writeAddress, 0xDE03);
+    ASSERT_TRUE(optional_value.value().cycles.has_value());
+    EXPECT_EQ(optional_value.value().cycles.value(), 2000U);
+    // NOLINTEND(bugprone-unchecked-optional-access)
+    optional_value = cnfFile.GetDiskDriverEntryPoints(u8"mon54.s19x");
+    EXPECT_FALSE(optional_value.has_value());
+    optional_value = cnfFile.GetDiskDriverEntryPoints(u8"");
+    EXPECT_FALSE(optional_value.has_value());
+    fs::remove(path);
+}
+
 TEST(test_fcnffile, fct_GetBootSectorFileProperties)
 {
     const auto path = fs::temp_directory_path() / u8"cnf11.conf";
@@ -542,6 +721,184 @@ TEST(test_fcnffile, fct_GetRuntimeSupportOption_exceptions)
     EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
             testing::Throws<FlexException>());
     fs::remove(path);
+
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "maxDisplayRefreshRate=\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "maxDisplayRefreshRate=0\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "maxDisplayRefreshRate=241\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "maxDisplayRefreshRate=5x\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "maxDisplayRefreshRate=1000\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "syncDisplayRefresh=2\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "idleLoopDetection=on\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "rtcEmulatedTime=on\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "frequencyPacingSlice=99\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "frequencyPacingSlice=10001\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "frequencyPacingSlice=1x\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "frequencyPacingSlice=\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "turboOnDemand=9\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "turboOnDemand=60001\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "turboOnDemand=-1\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "diskSectorCache=15\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "diskSectorCache=16385\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "diskSectorCache=x\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
+    ofs.open(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[RuntimeSupport]\n"
+        "diskDriverHLE=on\n";
+    ofs.close();
+    EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+            testing::Throws<FlexException>());
+    fs::remove(path);
 }
 
 TEST(test_fcnffile, fct_GetSerparAddress_exceptions)
@@ -641,6 +998,33 @@ TEST(test_fcnffile, fct_GetBootCharacter_exceptions)
     fs::remove(path);
 }
 
+TEST(test_fcnffile, fct_GetDiskDriverEntryPoints_exceptions)
+{
+    const auto path = fs::temp_directory_path() / u8"cnf44.conf";
+    std::fstream ofs;
+
+    static const std::vector<const char *> invalidLines
+    {
+        "monitor.hex=10000,DE03",
+        "monitor.hex=DE00",
+        "monitor.hex=DE00,DE00",
+        "monitor.hex=DE00,DE03,100001",
+        "monitor.hex=DE00,DE03,x",
+    };
+
+    for (const auto *line : invalidLines)
+    {
+        ofs.open(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[DiskDriverHLE]\n" << line << "\n";
+        ofs.close();
+        EXPECT_THAT([&](){ FlexemuConfigFile cnfFile(path); },
+                testing::Throws<FlexException>());
+        fs::remove(path);
+    }
+}
+
 TEST(test_fcnffile, fct_GetBootSectorFileProperties_exceptions)
 {
     const auto path = fs::temp_directory_path() / u8"cnf12.conf";
@@ -800,6 +1184,48 @@ TEST(test_fcnffile, fct_GetIoDeviceLogging_unicode)
     fs::remove(path);
 }
 
+TEST(test_fcnffile, fct_GetIoDeviceLogFilter)
+{
+    const auto path = fs::temp_directory_path() / u8"cnf42.conf";
+    ASSERT_TRUE(createCnfFile(path));
+    FlexemuConfigFile cnfFile(path);
+    ASSERT_TRUE(cnfFile.IsValid());
+    auto filter = cnfFile.GetIoDeviceLogFilter();
+    EXPECT_TRUE(filter.isLogRead);
+    EXPECT_TRUE(filter.isLogWrite);
+    EXPECT_TRUE(filter.offsets.empty());
+    fs::remove(path);
+
+    std::fstream ofs(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs <<
+        "[IoDeviceLogging]\n"
+        "devices=fdc\n"
+        "modes= write \n"
+        "offsets=0, 3\n";
+    ofs.close();
+    FlexemuConfigFile cnfFile2(path);
+    filter = cnfFile2.GetIoDeviceLogFilter();
+    EXPECT_FALSE(filter.isLogRead);
+    EXPECT_TRUE(filter.isLogWrite);
+    EXPECT_EQ(filter.offsets, (std::set<Word>{ 0U, 3U }));
+    fs::remove(path);
+
+    for (const auto *line : { "modes=read,append\n", "offsets=1,x\n",
+                              "offsets=65536\n" })
+    {
+        ofs.open(path, std::ios::out | std::ios::trunc);
+        ASSERT_TRUE(ofs.is_open());
+        ofs <<
+            "[IoDeviceLogging]\n"
+            "devices=fdc\n" << line;
+        ofs.close();
+        EXPECT_THAT([&](){ FlexemuConfigFile cnfFile3(path); },
+                testing::Throws<FlexException>());
+        fs::remove(path);
+    }
+}
+
 TEST(test_fcnffile, fct_GetDebugSupportOption_unicode)
 {
     const auto path = fs::temp_directory_path() / u8"cnf10.conf";
@@ -0,0 +1,306 @@
+/*
+    test_fdrvhle.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "fdrvhle.h"
+#include "mc6809.h"
+#include "mc6809st.h"
+#include "memory.h"
+#include "e2floppy.h"
+#include "ffilecnt.h"
+#include "fcnffile.h"
+#include "soptions.h"
+#include "wd1793.h"
+#include <array>
+#include <memory>
+#include <optional>
+#include <fstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// Execute the READ and WRITE routine of the FLEX disk driver on the CPU.
+// The guest routines only load B with a marker value, so it can be
+// checked if the trap handler or the guest routine has been executed.
+class test_fdrvhle : public ::testing::Test
+{
+protected:
+    static constexpr Word CALLER{0x1000U};
+    static constexpr Word READ{0xDE00U};
+    static constexpr Word WRITE{0xDE03U};
+    static constexpr Word STACK{0x7F00U};
+    static constexpr Word BUFFER{0x2000U};
+    static constexpr Byte GUEST_READ{0xAAU};
+    static constexpr Byte GUEST_WRITE{0xBBU};
+    static constexpr int TRACKS{35};
+    static constexpr int SECTORS{10};
+    static constexpr Byte RECORD_NOT_FOUND{Wd1793::STR_RECORDNOTFOUND};
+    using Sector_t = std::array<Byte, SECTOR_SIZE>;
+
+    test_fdrvhle()
+        : directory(CreateDirectory())
+        , configFile(std::make_shared<FlexemuConfigFile>(
+                     directory / "flexemu.conf"))
+        , memory(options, configFile)
+        , cpu(memory)
+        , fdc(options, configFile)
+        , hle(cpu, memory, fdc)
+    {
+        // READ: LDB #GUEST_READ, RTS. WRITE: LDB #GUEST_WRITE, RTS.
+        const std::array<Byte, 6> guestDriver{
+            0xC6U, GUEST_READ, 0x39U, 0xC6U, GUEST_WRITE, 0x39U };
+        Word address = READ;
+
+        for (const auto value : guestDriver)
+        {
+            memory.write_ram_rom(address++, value);
+        }
+        memory.write_ram_rom(0xFFFEU, CALLER >> 8U);
+        memory.write_ram_rom(0xFFFFU, CALLER & 0xFFU);
+        cpu.reset();
+        hle.Install(sDiskDriverEntryPoints{READ, WRITE, std::nullopt});
+    }
+
+    ~test_fdrvhle() override
+    {
+        fdc.umount_all_drives();
+        std::error_code error;
+        fs::remove_all(directory, error);
+    }
+
+    static fs::path CreateDirectory()
+    {
+        const auto path = fs::temp_directory_path() / u8"test_fdrvhle";
+
+        fs::create_directories(path);
+        std::ofstream ofs(path / "flexemu.conf");
+
+        return path;
+    }
+
+    void MountDisk()
+    {
+        const auto path = directory / "test.dsk";
+        std::unique_ptr<FlexDisk> disk(FlexDisk::Create(path,
+                FileTimeAccess::NONE, TRACKS, SECTORS, DiskType::DSK));
+
+        ASSERT_NE(disk, nullptr);
+        disk.reset();
+        ASSERT_TRUE(fdc.mount_drive(path, 0));
+        fdc.select_drive(0);
+    }
+
+    Sector_t ReadSectorFromFile(int trk, int sec) const
+    {
+        Sector_t sector{};
+        std::ifstream ifs(directory / "test.dsk", std::ios::binary);
+
+        ifs.seekg((trk * SECTORS + sec - 1) * SECTOR_SIZE);
+        ifs.read(reinterpret_cast<char *>(sector.data()), sector.size());
+        EXPECT_TRUE(ifs.good());
+
+        return sector;
+    }
+
+    void SetBuffer(const Sector_t &sector)
+    {
+        Word address = BUFFER;
+
+        for (const auto value : sector)
+        {
+            memory.write_byte(address++, value);
+        }
+    }
+
+    Sector_t GetBuffer()
+    {
+        Sector_t sector{};
+        Word address = BUFFER;
+
+        for (auto &value : sector)
+        {
+            value = memory.read_byte(address++);
+        }
+
+        return sector;
+    }
+
+    // Call the disk driver routine at entry with JSR. Return the
+    // registers after executing the given number of instructions.
+    Mc6809CpuStatus Call(Word entry, Byte trk, Byte sec, Byte ccValue,
+                         int steps)
+    {
+        const std::array<Byte, 3> jsr{
+            0xBDU, static_cast<Byte>(entry >> 8U),
+            static_cast<Byte>(entry & 0xFFU) };
+        Mc6809CpuStatus regs;
+        Word address = CALLER;
+
+        for (const auto value : jsr)
+        {
+            memory.write_ram_rom(address++, value);
+        }
+        cpu.get_status(&regs);
+        regs.pc = CALLER;
+        regs.s = STACK;
+        regs.a = trk;
+        regs.b = sec;
+        regs.x = BUFFER;
+        regs.cc = ccValue;
+        cpu.set_status(&regs);
+
+        cpu.run(RunMode::SingleStepInto);
+        cpu.get_status(&regs);
+        EXPECT_EQ(regs.pc, entry);
+        for (int step = 0; step < steps; ++step)
+        {
+            cpu.run(RunMode::SingleStepInto);
+        }
+        cpu.get_status(&regs);
+
+        return regs;
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+    fs::path directory;
+    sOptions options;
+    FlexemuConfigFileSPtr configFile;
+    Memory memory;
+    Mc6809 cpu;
+    E2floppy fdc;
+    FlexDiskDriverHle hle;
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(test_fdrvhle, fct_Read)
+{
+    Sector_t pattern{};
+
+    MountDisk();
+    pattern.fill(0x55U);
+    SetBuffer(pattern);
+
+    // Track 0 sector 3 is the system information record.
+    auto regs = Call(READ, 0U, 3U, CC_BIT_C | CC_BIT_N | CC_BIT_V, 1);
+    EXPECT_EQ(regs.pc, CALLER + 3U);
+    EXPECT_EQ(regs.s, STACK);
+    EXPECT_EQ(regs.b, 0U);
+    EXPECT_EQ(regs.x, BUFFER + SECTOR_SIZE);
+    EXPECT_EQ(regs.cc, CC_BIT_C | CC_BIT_Z);
+    EXPECT_EQ(GetBuffer(), ReadSectorFromFile(0, 3));
+
+    regs = Call(READ, 0U, 5U, 0U, 1);
+    EXPECT_EQ(regs.b, 0U);
+    EXPECT_EQ(regs.cc, CC_BIT_Z);
+    EXPECT_EQ(regs.x, BUFFER + SECTOR_SIZE);
+    EXPECT_EQ(GetBuffer(), ReadSectorFromFile(0, 5));
+}
+
+TEST_F(test_fdrvhle, fct_Read_error)
+{
+    Sector_t pattern{};
+
+    MountDisk();
+    pattern.fill(0x55U);
+    SetBuffer(pattern);
+
+    // The sector does not exist, X and memory are unchanged.
+    const auto regs = Call(READ, 0U, SECTORS + 1, CC_BIT_C | CC_BIT_Z, 1);
+    EXPECT_EQ(regs.pc, CALLER + 3U);
+    EXPECT_EQ(regs.s, STACK);
+    EXPECT_EQ(regs.b, RECORD_NOT_FOUND);
+    EXPECT_EQ(regs.x, BUFFER);
+    EXPECT_EQ(regs.cc, CC_BIT_C);
+    EXPECT_EQ(GetBuffer(), pattern);
+}
+
+TEST_F(test_fdrvhle, fct_Write)
+{
+    Sector_t pattern{};
+    Sector_t zeros{};
+    Byte value = 0U;
+
+    MountDisk();
+    for (auto &item : pattern)
+    {
+        item = value++;
+    }
+    SetBuffer(pattern);
+
+    auto regs = Call(WRITE, TRACKS - 1, SECTORS, CC_BIT_N, 1);
+    EXPECT_EQ(regs.pc, CALLER + 3U);
+    EXPECT_EQ(regs.s, STACK);
+    EXPECT_EQ(regs.b, 0U);
+    EXPECT_EQ(regs.x, BUFFER + SECTOR_SIZE);
+    EXPECT_EQ(regs.cc, CC_BIT_Z);
+
+    // Read back the sector by the trap handler.
+    SetBuffer(zeros);
+    regs = Call(READ, TRACKS - 1, SECTORS, 0U, 1);
+    EXPECT_EQ(regs.b, 0U);
+    EXPECT_EQ(GetBuffer(), pattern);
+    fdc.umount_all_drives();
+    EXPECT_EQ(ReadSectorFromFile(TRACKS - 1, SECTORS), pattern);
+}
+
+TEST_F(test_fdrvhle, fct_Write_error)
+{
+    MountDisk();
+
+    const auto regs = Call(WRITE, TRACKS, 1U, CC_BIT_C, 1);
+    EXPECT_EQ(regs.pc, CALLER + 3U);
+    EXPECT_EQ(regs.s, STACK);
+    EXPECT_EQ(regs.b, RECORD_NOT_FOUND);
+    EXPECT_EQ(regs.x, BUFFER);
+    EXPECT_EQ(regs.cc, CC_BIT_C);
+}
+
+TEST_F(test_fdrvhle, fct_no_disk)
+{
+    // Without a disk the guest routines are executed.
+    auto regs = Call(READ, 0U, 1U, 0U, 1);
+    EXPECT_EQ(regs.pc, READ + 2U);
+    EXPECT_EQ(regs.b, GUEST_READ);
+    cpu.run(RunMode::SingleStepInto);
+    cpu.get_status(&regs);
+    EXPECT_EQ(regs.pc, CALLER + 3U);
+    EXPECT_EQ(regs.s, STACK);
+    EXPECT_EQ(regs.x, BUFFER);
+
+    regs = Call(WRITE, 0U, 1U, 0U, 2);
+    EXPECT_EQ(regs.pc, CALLER + 3U);
+    EXPECT_EQ(regs.b, GUEST_WRITE);
+    EXPECT_EQ(regs.x, BUFFER);
+}
+
+TEST_F(test_fdrvhle, fct_reset_traps)
+{
+    MountDisk();
+    cpu.reset_traps();
+
+    const auto regs = Call(READ, 0U, 3U, 0U, 2);
+    EXPECT_EQ(regs.pc, CALLER + 3U);
+    EXPECT_EQ(regs.b, GUEST_READ);
+    EXPECT_EQ(regs.x, BUFFER);
+}
@@ -0,0 +1,139 @@
+/*
+    test_fhcache.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "fhcache.h"
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+static fs::path createFile(const std::string &filename, std::size_t size)
+{
+    const auto path = fs::temp_directory_path() / fs::u8path(filename);
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc |
+                            std::ios::binary);
+
+    for (std::size_t index = 0U; index < size; ++index)
+    {
+        ofs.put(static_cast<char>(index & 0xFFU));
+    }
+
+    return path;
+}
+
+TEST(test_fhcache, fct_Read_Write)
+{
+    const auto path = createFile("test_fhcache1.dat", 300U);
+    std::array<Byte, 4> buffer{};
+    std::vector<SDWord> closedIds;
+    {
+        FileHandleCache cache(4U, [&](SDWord id, const fs::path &p_path,
+                                      bool isWritten){
+            EXPECT_EQ(p_path, path);
+            EXPECT_TRUE(isWritten);
+            closedIds.push_back(id);
+        });
+
+        auto count = cache.Read(1, path, buffer.data(), buffer.size(), 10U);
+        ASSERT_TRUE(count.has_value());
+        EXPECT_EQ(count.value(), 4U);
+        EXPECT_EQ(buffer, (std::array<Byte, 4>{10U, 11U, 12U, 13U}));
+        // Read beyond end of file.
+        count = cache.Read(1, path, buffer.data(), buffer.size(), 298U);
+        ASSERT_TRUE(count.has_value());
+        EXPECT_EQ(count.value(), 2U);
+        count = cache.Read(1, path, buffer.data(), buffer.size(), 400U);
+        ASSERT_TRUE(count.has_value());
+        EXPECT_EQ(count.value(), 0U);
+
+        buffer = {0xAAU, 0xBBU, 0xCCU, 0xDDU};
+        EXPECT_TRUE(cache.Write(1, path, buffer.data(), buffer.size(), 100U));
+        EXPECT_EQ(cache.GetOpenCount(), 1U);
+
+        // Written data is immediately visible.
+        std::ifstream ifs(path, std::ios::in | std::ios::binary);
+        ASSERT_TRUE(ifs.is_open());
+        ifs.seekg(100);
+        std::array<char, 4> read{};
+        ifs.read(read.data(), read.size());
+        EXPECT_EQ(static_cast<Byte>(read[0]), 0xAAU);
+        EXPECT_EQ(static_cast<Byte>(read[3]), 0xDDU);
+        EXPECT_TRUE(closedIds.empty());
+    }
+    // Destruction closes all files.
+    EXPECT_EQ(closedIds, std::vector<SDWord>{1});
+    fs::remove(path);
+}
+
+TEST(test_fhcache, fct_LRU_Close)
+{
+    std::vector<fs::path> paths;
+    std::vector<SDWord> closedIds;
+    std::array<Byte, 1> buffer{};
+    FileHandleCache cache(2U, [&](SDWord id, const fs::path &,
+                                  bool isWritten){
+        EXPECT_FALSE(isWritten);
+        closedIds.push_back(id);
+    });
+
+    for (int index = 0; index < 3; ++index)
+    {
+        paths.push_back(createFile("test_fhcache_" +
+                                   std::to_string(index) + ".dat", 10U));
+    }
+
+    EXPECT_TRUE(cache.Read(0, paths[0], buffer.data(), 1U, 0U).has_value());
+    EXPECT_TRUE(cache.Read(1, paths[1], buffer.data(), 1U, 0U).has_value());
+    EXPECT_TRUE(cache.Read(0, paths[0], buffer.data(), 1U, 0U).has_value());
+    // The least recently used file 1 is closed.
+    EXPECT_TRUE(cache.Read(2, paths[2], buffer.data(), 1U, 0U).has_value());
+    EXPECT_EQ(closedIds, std::vector<SDWord>{1});
+    EXPECT_EQ(cache.GetOpenCount(), 2U);
+
+    cache.Close(2);
+    cache.Close(3);
+    EXPECT_EQ(closedIds, (std::vector<SDWord>{1, 2}));
+    EXPECT_EQ(cache.GetOpenCount(), 1U);
+
+    // A file which does not exist is neither opened nor created.
+    const auto missingPath = fs::temp_directory_path() / u8"test_fhcache.xxx";
+    fs::remove(missingPath);
+    EXPECT_FALSE(cache.Read(4, missingPath, buffer.data(), 1U, 0U));
+    EXPECT_FALSE(cache.Write(4, missingPath, buffer.data(), 1U, 0U));
+    EXPECT_FALSE(fs::exists(missingPath));
+
+    cache.CloseAll();
+    EXPECT_EQ(closedIds, (std::vector<SDWord>{1, 2, 0}));
+    EXPECT_EQ(cache.GetOpenCount(), 0U);
+    for (const auto &path : paths)
+    {
+        fs::remove(path);
+    }
+}
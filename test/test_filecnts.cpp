@@ -29,13 +29,20 @@
 #include "misc1.h"
 #include "ffilecnt.h"
 #include "rfilecnt.h"
+#include "mfilecnt.h"
+#include "cfilecnt.h"
 #include "ndircont.h"
 #include "filfschk.h"
 #include "fixt_filecont.h"
+#include <cstddef>
+#include <chrono>
 #include <ios>
+#include <memory>
+#include <optional>
 #include <string>
 #include <array>
 #include <fstream>
+#include <thread>
 #include <algorithm>
 #include <filesystem>
 
@@ -43,6 +50,27 @@
 using ::testing::StartsWith;
 namespace fs = std::filesystem;
 
+// A FlexDisk on which writing sectors fails while isWriteError is set.
+class FailingFlexDisk : public FlexDisk
+{
+    const bool &isWriteError;
+
+public:
+    FailingFlexDisk(const fs::path &p_path, const FileTimeAccess &fileTimeAccess,
+                    const bool &p_isWriteError)
+        : FlexDisk(p_path, std::ios::in | std::ios::out | std::ios::binary,
+                   fileTimeAccess)
+        , isWriteError(p_isWriteError)
+    {
+    }
+
+    bool WriteSector(const Byte *buffer, int trk, int sec,
+                     std::optional<int> side = std::nullopt) override
+    {
+        return !isWriteError && FlexDisk::WriteSector(buffer, trk, sec, side);
+    }
+};
+
 class test_IFlexDiskBySector : public test_FlexDiskFixture
 {
 protected:
@@ -262,6 +290,461 @@ TEST_F(test_IFlexDiskBySector, fct_WriteSector)
     }
 }
 
+TEST_F(test_IFlexDiskBySector, FlexMappedDisk_ReadWriteSector)
+{
+    const auto mode = std::ios::in | std::ios::out | std::ios::binary;
+    const auto romode = std::ios::in | std::ios::binary;
+    std::array<Byte, SECTOR_SIZE> expected{};
+    std::array<Byte, SECTOR_SIZE> buffer{};
+
+    for (int tidx = DSK; tidx <= FLX; ++tidx)
+    {
+        const auto &diskPath = diskPaths[RW][tidx];
+        {
+            FlexMappedDisk disk(diskPath, mode, no_ft);
+
+            EXPECT_TRUE((disk.GetFlexDiskOptions() & DiskOptions::Mapped) ==
+                        DiskOptions::Mapped);
+            ASSERT_TRUE(disks[RW][tidx]->ReadSector(expected.data(), 0, 3));
+            ASSERT_TRUE(disk.ReadSector(buffer.data(), 0, 3));
+            EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+            EXPECT_FALSE(disk.ReadSector(buffer.data(), tracks, 1));
+
+            std::fill(expected.begin(), expected.end(), '\x55');
+            EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1,
+                                         sectors));
+            EXPECT_TRUE(disk.Sync());
+        }
+
+        // Changes are written back into the disk image file.
+        FlexDisk disk(diskPath, romode, no_ft);
+        ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1, sectors));
+        EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+
+        FlexMappedDisk rodisk(diskPaths[RO][tidx], romode, no_ft);
+        EXPECT_TRUE(rodisk.ReadSector(buffer.data(), 0, 3));
+        EXPECT_FALSE(rodisk.WriteSector(expected.data(), 0, 3));
+    }
+}
+
+TEST_F(test_IFlexDiskBySector, FlexCachedDisk_ReadWriteSector)
+{
+    const auto mode = std::ios::in | std::ios::out | std::ios::binary;
+    const auto romode = std::ios::in | std::ios::binary;
+    const std::size_t cacheSize = 16U;
+    std::array<Byte, SECTOR_SIZE> expected{};
+    std::array<Byte, SECTOR_SIZE> buffer{};
+
+    for (int tidx = DSK; tidx <= FLX; ++tidx)
+    {
+        const auto &diskPath = diskPaths[RW][tidx];
+        const auto journalPath = FlexCachedDisk::GetJournalPath(diskPath);
+        {
+            FlexCachedDisk disk(
+                std::make_unique<FlexDisk>(diskPath, mode, no_ft), cacheSize);
+
+            EXPECT_TRUE((disk.GetFlexDiskOptions() & DiskOptions::Cached) ==
+                        DiskOptions::Cached);
+            EXPECT_TRUE(fs::exists(journalPath));
+            EXPECT_FALSE(disk.ReadSector(buffer.data(), tracks, 1));
+
+            // Write more sectors than cached, the least recently used
+            // ones are written back.
+            for (int sector = 1; sector <= sectors; ++sector)
+            {
+                std::fill(expected.begin(), expected.end(),
+                          static_cast<Byte>(sector));
+                EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1,
+                                             sector));
+                EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 2,
+                                             sector));
+            }
+            for (int sector = 1; sector <= sectors; ++sector)
+            {
+                std::fill(expected.begin(), expected.end(),
+                          static_cast<Byte>(sector));
+                ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1,
+                                            sector));
+                EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+            }
+
+            // A checkpoint truncates the journal.
+            EXPECT_TRUE(disk.Sync());
+            EXPECT_EQ(fs::file_size(journalPath), 0U);
+        }
+
+        // Changes are written back into the disk image file,
+        // the journal is removed.
+        EXPECT_FALSE(fs::exists(journalPath));
+        FlexDisk disk(diskPath, romode, no_ft);
+        for (int sector = 1; sector <= sectors; ++sector)
+        {
+            std::fill(expected.begin(), expected.end(),
+                      static_cast<Byte>(sector));
+            ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 2, sector));
+            EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+        }
+
+        FlexCachedDisk rodisk(
+            std::make_unique<FlexDisk>(diskPaths[RO][tidx], romode, no_ft),
+            cacheSize);
+        EXPECT_TRUE(rodisk.ReadSector(buffer.data(), 0, 3));
+        EXPECT_FALSE(rodisk.WriteSector(expected.data(), 0, 3));
+        EXPECT_FALSE(fs::exists(
+            FlexCachedDisk::GetJournalPath(diskPaths[RO][tidx])));
+    }
+}
+
+TEST_F(test_IFlexDiskBySector, FlexCachedDisk_GroupCommit)
+{
+    const auto mode = std::ios::in | std::ios::out | std::ios::binary;
+    const std::size_t cacheSize = 64U;
+    const auto records = 2U * FlexCachedDisk::JOURNAL_COMMIT_RECORDS + 1U;
+    const auto recordSize = 12U + SECTOR_SIZE;
+    std::array<Byte, SECTOR_SIZE> expected{};
+
+    for (int tidx = DSK; tidx <= FLX; ++tidx)
+    {
+        const auto &diskPath = diskPaths[RW][tidx];
+        const auto journalPath = FlexCachedDisk::GetJournalPath(diskPath);
+        FlexCachedDisk disk(
+            std::make_unique<FlexDisk>(diskPath, mode, no_ft), cacheSize);
+
+        // Each record is immediately written into the journal file,
+        // independent of the journal being synced to the storage device.
+        for (std::size_t index = 0U; index < records; ++index)
+        {
+            const auto trk = tracks - 1 - static_cast<int>(index) / sectors;
+            const auto sec = static_cast<int>(index) % sectors + 1;
+
+            std::fill(expected.begin(), expected.end(),
+                      static_cast<Byte>(index));
+            EXPECT_TRUE(disk.WriteSector(expected.data(), trk, sec));
+            EXPECT_EQ(fs::file_size(journalPath), (index + 1U) * recordSize)
+                << "path=" << diskPath.u8string();
+        }
+
+        EXPECT_TRUE(disk.Sync());
+        EXPECT_EQ(fs::file_size(journalPath), 0U);
+    }
+}
+
+TEST_F(test_IFlexDiskBySector, FlexCachedDisk_ReplayJournal)
+{
+    const auto mode = std::ios::in | std::ios::out | std::ios::binary;
+    const std::size_t cacheSize = 64U;
+    std::array<Byte, SECTOR_SIZE> expected{};
+    std::array<Byte, SECTOR_SIZE> buffer{};
+    std::array<Byte, SECTOR_SIZE> zeros{};
+
+    for (int tidx = DSK; tidx <= FLX; ++tidx)
+    {
+        const auto &diskPath = diskPaths[RW][tidx];
+        const auto journalPath = FlexCachedDisk::GetJournalPath(diskPath);
+        auto savedJournalPath = journalPath;
+        savedJournalPath += ".saved";
+        {
+            FlexCachedDisk disk(
+                std::make_unique<FlexDisk>(diskPath, mode, no_ft), cacheSize);
+
+            std::fill(expected.begin(), expected.end(), '\xAA');
+            EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1, 1));
+            EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1, 2));
+            // Keep the journal as it is before a crash.
+            fs::copy_file(journalPath, savedJournalPath,
+                          fs::copy_options::overwrite_existing);
+        }
+
+        // Simulate that the cached sectors never have been written
+        // into the disk image and that the last record is incomplete.
+        {
+            FlexDisk disk(diskPath, mode, no_ft);
+            ASSERT_TRUE(disk.WriteSector(zeros.data(), tracks - 1, 1));
+            ASSERT_TRUE(disk.WriteSector(zeros.data(), tracks - 1, 2));
+            ASSERT_TRUE(disk.WriteSector(zeros.data(), tracks - 1, 3));
+        }
+        fs::rename(savedJournalPath, journalPath);
+        {
+            std::ofstream ofs(journalPath,
+                              std::ios::out | std::ios::app | std::ios::binary);
+            ASSERT_TRUE(ofs.is_open());
+            ofs << "FJNL\x22\x03";
+        }
+
+        {
+            FlexCachedDisk disk(
+                std::make_unique<FlexDisk>(diskPath, mode, no_ft), cacheSize);
+            EXPECT_EQ(fs::file_size(journalPath), 0U);
+        }
+
+        FlexDisk disk(diskPath, std::ios::in | std::ios::binary, no_ft);
+        ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1, 1));
+        EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+        ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1, 2));
+        EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+        ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1, 3));
+        EXPECT_EQ(buffer, zeros) << "path=" << diskPath.u8string();
+    }
+}
+
+TEST_F(test_IFlexDiskBySector, FlexCachedDisk_WriteBackError)
+{
+    const std::size_t cacheSize = 4U;
+    std::array<Byte, SECTOR_SIZE> expected{};
+    std::array<Byte, SECTOR_SIZE> buffer{};
+    bool isWriteError = false;
+
+    for (int tidx = DSK; tidx <= FLX; ++tidx)
+    {
+        const auto &diskPath = diskPaths[RW][tidx];
+        const auto journalPath = FlexCachedDisk::GetJournalPath(diskPath);
+        {
+            FlexCachedDisk disk(std::make_unique<FailingFlexDisk>(
+                    diskPath, no_ft, isWriteError), cacheSize);
+
+            std::fill(expected.begin(), expected.end(), '\x55');
+            EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1, 1));
+            EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1, 2));
+
+            // A failed write back keeps the sectors in the cache and in the
+            // journal and write protects the disk.
+            isWriteError = true;
+            EXPECT_FALSE(disk.Sync());
+            EXPECT_TRUE(disk.IsWriteProtected());
+            EXPECT_FALSE(disk.WriteSector(expected.data(), tracks - 1, 3));
+            EXPECT_NE(fs::file_size(journalPath), 0U);
+            for (int sector = 1; sector <= static_cast<int>(cacheSize) + 1;
+                 ++sector)
+            {
+                ASSERT_TRUE(disk.ReadSector(buffer.data(), 0, sector));
+            }
+            ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1, 1));
+            EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+
+            // The next successful checkpoint removes the write protection.
+            isWriteError = false;
+            EXPECT_TRUE(disk.Sync());
+            EXPECT_FALSE(disk.IsWriteProtected());
+            EXPECT_EQ(fs::file_size(journalPath), 0U);
+            EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1, 3));
+        }
+
+        EXPECT_FALSE(fs::exists(journalPath));
+        FlexDisk disk(diskPath, std::ios::in | std::ios::binary, no_ft);
+        for (int sector = 1; sector <= 3; ++sector)
+        {
+            ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1, sector));
+            EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+        }
+    }
+}
+
+TEST_F(test_IFlexDiskBySector, FlexCachedDisk_ReplayJournalError)
+{
+    const auto mode = std::ios::in | std::ios::out | std::ios::binary;
+    const std::size_t cacheSize = 64U;
+    std::array<Byte, SECTOR_SIZE> expected{};
+    std::array<Byte, SECTOR_SIZE> buffer{};
+    bool isWriteError = false;
+
+    for (int tidx = DSK; tidx <= FLX; ++tidx)
+    {
+        const auto &diskPath = diskPaths[RW][tidx];
+        const auto journalPath = FlexCachedDisk::GetJournalPath(diskPath);
+        auto savedJournalPath = journalPath;
+        savedJournalPath += ".saved";
+        {
+            FlexCachedDisk disk(
+                std::make_unique<FlexDisk>(diskPath, mode, no_ft), cacheSize);
+
+            std::fill(expected.begin(), expected.end(), '\x66');
+            EXPECT_TRUE(disk.WriteSector(expected.data(), tracks - 1, 1));
+            fs::copy_file(journalPath, savedJournalPath,
+                          fs::copy_options::overwrite_existing);
+        }
+        {
+            std::array<Byte, SECTOR_SIZE> zeros{};
+            FlexDisk disk(diskPath, mode, no_ft);
+            ASSERT_TRUE(disk.WriteSector(zeros.data(), tracks - 1, 1));
+        }
+        fs::rename(savedJournalPath, journalPath);
+        const auto journalSize = fs::file_size(journalPath);
+
+        // If the journal can not be replayed it is kept and the disk is
+        // write protected.
+        isWriteError = true;
+        {
+            FlexCachedDisk disk(std::make_unique<FailingFlexDisk>(
+                    diskPath, no_ft, isWriteError), cacheSize);
+
+            EXPECT_TRUE(disk.IsWriteProtected());
+            EXPECT_FALSE(disk.WriteSector(expected.data(), tracks - 1, 2));
+            EXPECT_TRUE(disk.Sync());
+            EXPECT_TRUE(disk.IsWriteProtected());
+            ASSERT_TRUE(fs::exists(journalPath));
+            EXPECT_EQ(fs::file_size(journalPath), journalSize);
+        }
+        ASSERT_TRUE(fs::exists(journalPath));
+        EXPECT_EQ(fs::file_size(journalPath), journalSize);
+
+        isWriteError = false;
+        {
+            FlexCachedDisk disk(std::make_unique<FailingFlexDisk>(
+                    diskPath, no_ft, isWriteError), cacheSize);
+
+            EXPECT_FALSE(disk.IsWriteProtected());
+            ASSERT_TRUE(disk.ReadSector(buffer.data(), tracks - 1, 1));
+            EXPECT_EQ(buffer, expected) << "path=" << diskPath.u8string();
+        }
+        EXPECT_FALSE(fs::exists(journalPath));
+    }
+}
+
+#ifdef __linux__
+TEST_F(test_IFlexDiskBySector, DirectoryDisk_HostChanges)
+{
+    const auto ft_access = FileTimeAccess::Get | FileTimeAccess::Set;
+    const auto &directory = diskPaths[RW][DIR];
+    const auto path = directory / "hostfile.txt";
+    auto *disk = disks[RW][DIR].get();
+    ASSERT_NE(disk, nullptr);
+
+    st_t start{};
+    // Return the free sectors and the number of records of hostfile.txt.
+    // Records is -1 if the file is not in the directory.
+    const auto readDirectory = [&](Word &free, int &records)
+    {
+        struct s_sys_info_sector sis{};
+        struct s_dir_sector dirSector{};
+        st_t next{0, 5};
+
+        records = -1;
+        ASSERT_TRUE(disk->ReadSector(reinterpret_cast<Byte *>(&sis), 0, 3));
+        free = flx::getValueBigEndian<Word>(&sis.sir.free[0]);
+        while (next.sec != 0)
+        {
+            ASSERT_TRUE(disk->ReadSector(reinterpret_cast<Byte *>(&dirSector),
+                                         next.trk, next.sec));
+            for (const auto &dir_entry : dirSector.dir_entries)
+            {
+                if (flx::getstr<>(dir_entry.filename) == "HOSTFILE" &&
+                    flx::getstr<>(dir_entry.file_ext) == "TXT")
+                {
+                    records =
+                        flx::getValueBigEndian<Word>(&dir_entry.records[0]);
+                    start = dir_entry.start;
+                }
+            }
+            next = dirSector.next;
+        }
+    };
+    // Host changes are reported asynchronously by the directory watcher
+    // thread. They are applied on the next sector access. Wait until the
+    // expected number of records is reached or a timeout occurs.
+    const auto waitForRecords = [&](Word &free, int expected)
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        int records = -1;
+
+        readDirectory(free, records);
+        while (records != expected && Clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            readDirectory(free, records);
+        }
+
+        return records;
+    };
+    // Wait until the first data byte of hostfile.txt has the expected
+    // value or a timeout occurs.
+    const auto waitForData = [&](char expected)
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        std::array<Byte, SECTOR_SIZE> buffer{};
+        Word free{};
+        int records{};
+
+        do
+        {
+            // Reading the directory applies the host changes.
+            readDirectory(free, records);
+            EXPECT_TRUE(disk->ReadSector(buffer.data(), start.trk, start.sec));
+            if (buffer[4] == static_cast<Byte>(expected))
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        } while (Clock::now() < deadline);
+
+        return false;
+    };
+    const auto writeFile = [&](std::size_t size)
+    {
+        std::ofstream ofs(path, std::ios::out | std::ios::binary);
+        const std::string content(size, 'x');
+
+        ofs << content;
+    };
+    // Replace the file by a new file with the same size.
+    const auto replaceFile = [&](std::size_t size, char ch)
+    {
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream ofs(tmpPath, std::ios::out | std::ios::binary);
+            const std::string content(size, ch);
+
+            ofs << content;
+        }
+        fs::rename(tmpPath, path);
+    };
+    Word initialFree{};
+    Word free{};
+    int records{};
+
+    readDirectory(initialFree, records);
+    EXPECT_EQ(records, -1);
+
+    // Add a file with 3 sectors.
+    writeFile(DBPS * 3U);
+    ASSERT_EQ(waitForRecords(free, 3), 3)
+        << "Timeout waiting for the directory watcher";
+    EXPECT_EQ(free, initialFree - 3);
+    FlexDiskCheck checker1(*disk, ft_access);
+    EXPECT_TRUE(checker1.CheckFileSystem());
+
+    // Replace the file while a file handle is cached for it.
+    ASSERT_TRUE(waitForData('x'));
+    replaceFile(DBPS * 3U, 'y');
+    EXPECT_TRUE(waitForData('y'))
+        << "Timeout waiting for the replaced file content";
+    readDirectory(free, records);
+    EXPECT_EQ(records, 3);
+
+    // Shrink and grow the file.
+    writeFile(DBPS);
+    ASSERT_EQ(waitForRecords(free, 1), 1)
+        << "Timeout waiting for the directory watcher";
+    EXPECT_EQ(free, initialFree - 1);
+    writeFile(DBPS * 4U + 1U);
+    ASSERT_EQ(waitForRecords(free, 5), 5)
+        << "Timeout waiting for the directory watcher";
+    EXPECT_EQ(free, initialFree - 5);
+    FlexDiskCheck checker2(*disk, ft_access);
+    EXPECT_TRUE(checker2.CheckFileSystem());
+
+    // Delete the file, the sectors are added to the free chain.
+    fs::remove(path);
+    ASSERT_EQ(waitForRecords(free, -1), -1)
+        << "Timeout waiting for the directory watcher";
+    EXPECT_EQ(free, initialFree);
+    FlexDiskCheck checker3(*disk, ft_access);
+    EXPECT_TRUE(checker3.CheckFileSystem());
+}
+#endif
+
 TEST_F(test_IFlexDiskBySector, fct_FormatSector)
 {
     std::array<Byte, SECTOR_SIZE> buffer{};
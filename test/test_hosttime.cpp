@@ -0,0 +1,170 @@
+/*
+    test_hosttime.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "hosttime.h"
+#include "fcnffile.h"
+#include "bobserv.h"
+#include "bobshelp.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+#if defined(_WIN32) || defined(USE_TIMERFD) || defined(USE_POSIX_TIMERS)
+class TimerEventCounter : public BObserver
+{
+public:
+    explicit TimerEventCounter(int p_uniqueTimerId)
+        : uniqueTimerId(p_uniqueTimerId)
+    {
+    }
+
+    void UpdateFrom(NotifyId id, void *param) override
+    {
+        if (id == NotifyId::HostTimerEvent &&
+            *static_cast<int *>(param) == uniqueTimerId)
+        {
+            ++count;
+        }
+    }
+
+    // Wait at most two seconds until at least minCount events occurred.
+    bool WaitForCount(int minCount) const
+    {
+        const auto endTime = std::chrono::steady_clock::now() + 2s;
+
+        while (count.load() < minCount)
+        {
+            if (std::chrono::steady_clock::now() > endTime)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+
+        return true;
+    }
+
+    std::atomic<int> count{};
+
+private:
+    const int uniqueTimerId;
+};
+
+class test_hosttime : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        path = fs::temp_directory_path() / u8"hosttime.conf";
+        std::ofstream ofs(path);
+        ASSERT_TRUE(ofs.is_open());
+        ofs << "[RuntimeSupport]\n";
+        ofs.close();
+        configFile = std::make_shared<FlexemuConfigFile>(path);
+    }
+
+    void TearDown() override
+    {
+        configFile.reset();
+        fs::remove(path);
+    }
+
+    static bool Start(HostTimer &timer, int uniqueTimerId,
+                      std::int64_t cycleTimeNs)
+    {
+        HostTimerUpdate_t params{cycleTimeNs, uniqueTimerId, false};
+
+        timer.UpdateFrom(NotifyId::SetHostTimer, &params);
+
+        return params.isValid;
+    }
+
+    fs::path path;
+    FlexemuConfigFileSPtr configFile;
+};
+
+TEST_F(test_hosttime, fct_SetHostTimer)
+{
+    TimerEventCounter counter(1);
+    HostTimer timer(1, configFile);
+
+    timer.Attach(counter);
+    ASSERT_TRUE(Start(timer, 1, 1000000));
+    EXPECT_TRUE(counter.WaitForCount(10)) <<
+        "Only " << counter.count.load() << " timer events within 2 s";
+
+    // After disabling the timer no more events are sent.
+    timer.UpdateFrom(NotifyId::SetHostTimer, nullptr);
+    const auto count = counter.count.load();
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(counter.count.load(), count);
+    timer.Detach(counter);
+}
+
+TEST_F(test_hosttime, fct_SetHostTimer_other_id)
+{
+    TimerEventCounter counter(1);
+    HostTimer timer(1, configFile);
+    HostTimerUpdate_t params{1000000, 2, false};
+
+    timer.Attach(counter);
+    timer.UpdateFrom(NotifyId::SetHostTimer, &params);
+    EXPECT_FALSE(params.isValid);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(counter.count.load(), 0);
+    timer.Detach(counter);
+}
+
+TEST_F(test_hosttime, fct_multiple_timers)
+{
+    TimerEventCounter counter1(1);
+    TimerEventCounter counter2(2);
+    HostTimer timer1(1, configFile);
+    HostTimer timer2(2, configFile);
+
+    timer1.Attach(counter1);
+    timer2.Attach(counter2);
+    ASSERT_TRUE(Start(timer1, 1, 1000000));
+    ASSERT_TRUE(Start(timer2, 2, 2000000));
+    EXPECT_TRUE(counter1.WaitForCount(20)) <<
+        "Only " << counter1.count.load() << " timer1 events within 2 s";
+    EXPECT_TRUE(counter2.WaitForCount(10)) <<
+        "Only " << counter2.count.load() << " timer2 events within 2 s";
+
+    // Stopping one timer keeps the other one running.
+    timer1.UpdateFrom(NotifyId::SetHostTimer, nullptr);
+    const auto count1 = counter1.count.load();
+    const auto count2 = counter2.count.load();
+    EXPECT_TRUE(counter2.WaitForCount(count2 + 5)) <<
+        "timer2 stopped after timer1 was disabled";
+    EXPECT_EQ(counter1.count.load(), count1);
+    timer1.Detach(counter1);
+    timer2.Detach(counter2);
+}
+#endif
@@ -0,0 +1,116 @@
+/*
+    test_idleloop.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "idleloop.h"
+#include "schedcpu.h"
+#include "cpustate.h"
+#include <string>
+
+
+class FakeCpu : public ScheduledCpu
+{
+public:
+    void do_reset() override { }
+    CpuState run(RunMode /*mode*/) override { return CpuState::NONE; }
+    void exit_run() override { }
+    QWord get_cycles(bool /*reset*/ = false) override { return cycles; }
+    void get_status(CpuStatus * /*cpu_status*/) override { }
+    CpuStatusPtr create_status_object() override { return nullptr; }
+    void get_interrupt_status(tInterruptStatus & /*s*/) override { }
+    void set_required_cyclecount(cycles_t /*p_cycles*/) override { }
+    void set_idle() override { ++idleCount; }
+    void set_event_deadline(QWord /*p_cycles*/) override { }
+    std::string get_name() override { return "fake"; }
+
+    QWord cycles{};
+    int idleCount{};
+};
+
+// Simulate n loop iterations polling the same I/O register.
+static void poll(IdleLoopDetector &detector, FakeCpu &cpu, DWord n,
+                 QWord cyclesPerLoop, Word address = 0xFCF4U,
+                 Byte value = 0x02U)
+{
+    for (DWord i = 0U; i < n; ++i)
+    {
+        cpu.cycles += cyclesPerLoop;
+        detector.OnIoRead(address, value);
+    }
+}
+
+TEST(test_idleloop, fct_OnIoRead)
+{
+    FakeCpu cpu;
+    IdleLoopDetector detector(cpu);
+
+    // The first read only gets the loop cycle count.
+    poll(detector, cpu, IdleLoopDetector::MIN_MATCHES, 40U);
+    EXPECT_EQ(cpu.idleCount, 0);
+    poll(detector, cpu, 1U, 40U);
+    EXPECT_EQ(cpu.idleCount, 1);
+    poll(detector, cpu, IdleLoopDetector::MIN_MATCHES, 40U);
+    EXPECT_EQ(cpu.idleCount, 2);
+}
+
+TEST(test_idleloop, fct_OnIoRead_no_idle_loop)
+{
+    FakeCpu cpu;
+    IdleLoopDetector detector(cpu);
+
+    // Loop is too long.
+    poll(detector, cpu, 2U * IdleLoopDetector::MIN_MATCHES,
+         IdleLoopDetector::MAX_LOOP_CYCLES + 1U);
+    EXPECT_EQ(cpu.idleCount, 0);
+
+    // Loop changes the emulated state.
+    for (DWord i = 0U; i < 2U * IdleLoopDetector::MIN_MATCHES; ++i)
+    {
+        poll(detector, cpu, 1U, 40U);
+        detector.OnStateChange();
+    }
+    EXPECT_EQ(cpu.idleCount, 0);
+
+    // Value read from I/O register changes.
+    for (DWord i = 0U; i < 2U * IdleLoopDetector::MIN_MATCHES; ++i)
+    {
+        poll(detector, cpu, 1U, 40U, 0xFCF4U, static_cast<Byte>(i));
+    }
+    EXPECT_EQ(cpu.idleCount, 0);
+
+    // Different number of cycles between I/O register reads.
+    for (DWord i = 0U; i < 2U * IdleLoopDetector::MIN_MATCHES; ++i)
+    {
+        poll(detector, cpu, 1U, 40U + (i & 1U));
+    }
+    EXPECT_EQ(cpu.idleCount, 0);
+
+    // Alternating I/O register reads.
+    for (DWord i = 0U; i < 2U * IdleLoopDetector::MIN_MATCHES; ++i)
+    {
+        poll(detector, cpu, 1U, 40U, static_cast<Word>(0xFCF4U + (i & 1U)));
+    }
+    EXPECT_EQ(cpu.idleCount, 0);
+}
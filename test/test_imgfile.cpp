@@ -0,0 +1,100 @@
+/*
+    test_imgfile.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "imgfile.h"
+#include <array>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+static std::vector<Byte> readFile(const fs::path &path)
+{
+    std::ifstream ifs(path, std::ios::in | std::ios::binary);
+
+    return { std::istreambuf_iterator<char>(ifs),
+             std::istreambuf_iterator<char>() };
+}
+
+static DWord getBigEndian(const std::vector<Byte> &data, std::size_t offset)
+{
+    return (static_cast<DWord>(data[offset]) << 24U) |
+           (static_cast<DWord>(data[offset + 1U]) << 16U) |
+           (static_cast<DWord>(data[offset + 2U]) << 8U) |
+           static_cast<DWord>(data[offset + 3U]);
+}
+
+TEST(test_imgfile, fct_writePngFile)
+{
+    const auto path = fs::temp_directory_path() / u8"imgfile.png";
+    const std::array<Byte, 8> signature{
+        0x89U, 'P', 'N', 'G', '\r', '\n', 0x1AU, '\n'
+    };
+    const std::vector<Byte> pixels{ 0U, 1U, 1U, 0U, 1U, 0U };
+    const std::vector<DWord> colorTable{ 0xFF000000U, 0xFF00FF00U };
+
+    EXPECT_TRUE(flx::writePngFile(path, 3, 2, pixels.data(), colorTable));
+    const auto data = readFile(path);
+    ASSERT_GT(data.size(), 45U);
+    EXPECT_TRUE(std::equal(signature.cbegin(), signature.cend(),
+                           data.cbegin()));
+    // IHDR chunk: width, height, bit depth 8, color type 3 (palette).
+    EXPECT_EQ(getBigEndian(data, 8U), 13U);
+    EXPECT_EQ(std::string(&data[12], &data[16]), "IHDR");
+    EXPECT_EQ(getBigEndian(data, 16U), 3U);
+    EXPECT_EQ(getBigEndian(data, 20U), 2U);
+    EXPECT_EQ(data[24], 8U);
+    EXPECT_EQ(data[25], 3U);
+    // PLTE chunk with two RGB colors.
+    EXPECT_EQ(getBigEndian(data, 33U), 6U);
+    EXPECT_EQ(std::string(&data[37], &data[41]), "PLTE");
+    EXPECT_EQ(data[44], 0x00U);
+    EXPECT_EQ(data[45], 0xFFU);
+    EXPECT_EQ(data[46], 0x00U);
+    // IEND chunk.
+    EXPECT_EQ(std::string(data.end() - 8, data.end() - 4), "IEND");
+    fs::remove(path);
+
+    const auto invalidPath =
+        fs::temp_directory_path() / u8"not_existent_dir" / u8"imgfile.png";
+    EXPECT_FALSE(flx::writePngFile(invalidPath, 3, 2, pixels.data(),
+                                   colorTable));
+}
+
+TEST(test_imgfile, fct_writeRawFile)
+{
+    const auto path = fs::temp_directory_path() / u8"imgfile.raw";
+    const std::vector<Byte> pixels{ 0U, 1U, 2U, 3U, 0x3FU };
+
+    EXPECT_TRUE(flx::writeRawFile(path, pixels.data(), pixels.size()));
+    EXPECT_EQ(readFile(path), pixels);
+    fs::remove(path);
+}
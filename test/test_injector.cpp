@@ -0,0 +1,172 @@
+/*
+    test_injector.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "injector.h"
+#include <fstream>
+#include <optional>
+#include <string>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+static void skipResetDelay(InputInjector &injector)
+{
+    for (Word i = 0U; i < InputInjector::RESET_DELAY; ++i)
+    {
+        EXPECT_FALSE(injector.IsCharAvailable());
+    }
+}
+
+// Read all characters. Each character is read as soon as it is
+// available, the status is polled until the character delay has elapsed.
+static std::string readAll(InputInjector &injector)
+{
+    std::string result;
+    Word polls = 0U;
+
+    while (polls <= InputInjector::CHAR_DELAY)
+    {
+        if (!injector.IsCharAvailable())
+        {
+            ++polls;
+            continue;
+        }
+
+        const auto optional_char = injector.ReadChar();
+
+        if (!optional_char.has_value())
+        {
+            break;
+        }
+        result.push_back(static_cast<char>(optional_char.value()));
+        polls = 0U;
+    }
+
+    return result;
+}
+
+TEST(test_injector, fct_Inject)
+{
+    InputInjector injector;
+
+    EXPECT_FALSE(injector.IsCharAvailable());
+    injector.Inject("dir 0\nlist a\r\nb\rc");
+    skipResetDelay(injector);
+    EXPECT_EQ(readAll(injector), "dir 0\rlist a\rb\rc");
+    EXPECT_FALSE(injector.IsCharAvailable());
+    // No delay after the reset delay has elapsed.
+    injector.Inject("x");
+    EXPECT_EQ(readAll(injector), "x");
+}
+
+TEST(test_injector, fct_ReadChar)
+{
+    InputInjector injector;
+
+    injector.Inject("ab");
+    skipResetDelay(injector);
+    // A character is only read after a status read.
+    EXPECT_FALSE(injector.ReadChar().has_value());
+    EXPECT_TRUE(injector.IsCharAvailable());
+    EXPECT_TRUE(injector.IsCharAvailable());
+    EXPECT_EQ(injector.ReadChar(), std::optional<Byte>('a'));
+    EXPECT_FALSE(injector.ReadChar().has_value());
+    // The next character is delayed.
+    for (Word i = 0U; i < InputInjector::CHAR_DELAY; ++i)
+    {
+        EXPECT_FALSE(injector.IsCharAvailable());
+    }
+    EXPECT_TRUE(injector.IsCharAvailable());
+    EXPECT_EQ(injector.ReadChar(), std::optional<Byte>('b'));
+    EXPECT_FALSE(injector.IsCharAvailable());
+    EXPECT_FALSE(injector.ReadChar().has_value());
+}
+
+// Simulate the monitor reading characters with echo: INCH polls the status
+// until a character is available and reads it. The echo (OUTA) reads the
+// status for a Ctrl-X check, if a character is available it reads and
+// drops it. Then it waits for the transmit data register being empty,
+// which also reads the status.
+TEST(test_injector, fct_ReadChar_with_echo)
+{
+    InputInjector injector;
+    std::string input;
+    std::string dropped;
+
+    injector.Inject("asmb test\n");
+    skipResetDelay(injector);
+    for (int count = 0; count < 10; ++count)
+    {
+        Word polls = 0U;
+
+        while (!injector.IsCharAvailable() && polls < 100U)
+        {
+            ++polls;
+        }
+        const auto optional_char = injector.ReadChar();
+        ASSERT_TRUE(optional_char.has_value());
+        input.push_back(static_cast<char>(optional_char.value()));
+
+        if (injector.IsCharAvailable())
+        {
+            dropped.push_back(static_cast<char>(
+                        injector.ReadChar().value_or('?')));
+        }
+        injector.IsCharAvailable();
+    }
+
+    EXPECT_EQ(input, "asmb test\r");
+    EXPECT_EQ(dropped, "");
+}
+
+TEST(test_injector, fct_ResetDelay)
+{
+    InputInjector injector;
+
+    injector.Inject("ab");
+    skipResetDelay(injector);
+    EXPECT_TRUE(injector.IsCharAvailable());
+    injector.ResetDelay();
+    EXPECT_FALSE(injector.ReadChar().has_value());
+    skipResetDelay(injector);
+    EXPECT_EQ(readAll(injector), "ab");
+}
+
+TEST(test_injector, fct_InjectFile)
+{
+    const auto path = fs::temp_directory_path() / u8"injector.txt";
+    InputInjector injector;
+
+    EXPECT_FALSE(injector.InjectFile(
+                fs::temp_directory_path() / u8"injector_notexist.txt"));
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    ASSERT_TRUE(ofs.is_open());
+    ofs << "asmb test\n+++\n";
+    ofs.close();
+    EXPECT_TRUE(injector.InjectFile(path));
+    skipResetDelay(injector);
+    EXPECT_EQ(readAll(injector), "asmb test\r+++\r");
+    fs::remove(path);
+}
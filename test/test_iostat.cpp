@@ -0,0 +1,99 @@
+/*
+    test_iostat.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "iostat.h"
+#include <chrono>
+#include <string>
+
+using namespace std::chrono_literals;
+
+
+TEST(test_iostat, fct_LatencyHistogram_Add)
+{
+    LatencyHistogram histogram;
+
+    histogram.Add(500ns);
+    histogram.Add(1us);
+    histogram.Add(3us);
+    histogram.Add(4us);
+    histogram.Add(7999us);
+    histogram.Add(3600s);
+    EXPECT_EQ(histogram.GetCount(0U), 1U);
+    EXPECT_EQ(histogram.GetCount(1U), 1U);
+    EXPECT_EQ(histogram.GetCount(2U), 1U);
+    EXPECT_EQ(histogram.GetCount(3U), 1U);
+    EXPECT_EQ(histogram.GetCount(13U), 1U);
+    EXPECT_EQ(histogram.GetCount(LatencyHistogram::BUCKETS - 1U), 1U);
+    EXPECT_EQ(histogram.GetTotalCount(), 6U);
+    EXPECT_EQ(LatencyHistogram::GetUpperLimitUs(0U), 1U);
+    EXPECT_EQ(LatencyHistogram::GetUpperLimitUs(13U), 8192U);
+    EXPECT_EQ(LatencyHistogram::GetUpperLimitUs(
+                LatencyHistogram::BUCKETS - 1U), 0U);
+}
+
+TEST(test_iostat, fct_IoDeviceStatistics_Count)
+{
+    IoDeviceStatistics statistics(4U, nullptr);
+
+    statistics.CountRead(0U);
+    statistics.CountRead(0U);
+    statistics.CountRead(3U);
+    statistics.CountWrite(1U);
+    statistics.CountReset();
+    EXPECT_EQ(statistics.GetSize(), 4U);
+    EXPECT_EQ(statistics.GetReadCount(0U), 2U);
+    EXPECT_EQ(statistics.GetReadCount(1U), 0U);
+    EXPECT_EQ(statistics.GetReadCount(3U), 1U);
+    EXPECT_EQ(statistics.GetWriteCount(1U), 1U);
+    EXPECT_EQ(statistics.GetTotalReadCount(), 3U);
+    EXPECT_EQ(statistics.GetTotalWriteCount(), 1U);
+    EXPECT_EQ(statistics.GetResetCount(), 1U);
+    EXPECT_EQ(statistics.GetHostLatency(), nullptr);
+}
+
+TEST(test_iostat, fct_IoDeviceStatistics_ToJson)
+{
+    IoDeviceStatistics statistics(2U, nullptr);
+
+    statistics.CountRead(1U);
+    statistics.CountWrite(0U);
+    statistics.CountWrite(0U);
+    EXPECT_EQ(statistics.ToJson("pia1"),
+        "{\"name\":\"pia1\",\"reads\":1,\"writes\":2,\"resets\":0,"
+        "\"registers\":[{\"offset\":0,\"reads\":0,\"writes\":2},"
+        "{\"offset\":1,\"reads\":1,\"writes\":0}]}");
+
+    LatencyHistogram histogram;
+    IoDeviceStatistics statistics2(1U, &histogram);
+
+    histogram.Add(2us);
+    const auto json = statistics2.ToJson("fdc");
+    EXPECT_NE(json.find(",\"hostLatency\":[{\"upperLimitUs\":1,\"count\":0},"
+                        "{\"upperLimitUs\":2,\"count\":0},"
+                        "{\"upperLimitUs\":4,\"count\":1},"),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"upperLimitUs\":0,\"count\":0}]}"),
+              std::string::npos);
+}
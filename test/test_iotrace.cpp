@@ -0,0 +1,109 @@
+/*
+    test_iotrace.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "iotrace.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+static std::vector<std::string> readLines(const fs::path &path)
+{
+    std::vector<std::string> lines;
+    std::ifstream ifs(path);
+    std::string line;
+
+    while (std::getline(ifs, line))
+    {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+TEST(test_iotrace, fct_Decode)
+{
+    EXPECT_EQ(IoTracer::Decode({ 123U, 3U, 0U, IoTraceMode::Read, 0x8AU },
+                               "fdc"),
+              "mode=read  offset=   3 result=8A device=fdc cycles=123\n");
+    EXPECT_EQ(IoTracer::Decode({ 4567U, 12U, 0U, IoTraceMode::Write, 0x0FU },
+                               "pia1"),
+              "mode=write offset=  12 value=0F  device=pia1 cycles=4567\n");
+    EXPECT_EQ(IoTracer::Decode({ 0U, 0U, 0U, IoTraceMode::Reset, 0U },
+                               "acia1"),
+              "mode=reset device=acia1 cycles=0\n");
+}
+
+TEST(test_iotrace, fct_Record_Flush)
+{
+    const auto path = fs::temp_directory_path() / u8"test_iotrace1.log";
+    {
+        IoTracer tracer(path);
+        const auto fdcIndex = tracer.AddDevice("fdc");
+        const auto piaIndex = tracer.AddDevice("pia1");
+
+        EXPECT_EQ(fdcIndex, 0U);
+        EXPECT_EQ(piaIndex, 1U);
+        tracer.Record({ 10U, 0U, fdcIndex, IoTraceMode::Reset, 0U });
+        tracer.Record({ 20U, 1U, piaIndex, IoTraceMode::Write, 0x55U });
+        tracer.Record({ 30U, 3U, fdcIndex, IoTraceMode::Read, 0xAAU });
+        tracer.Flush();
+
+        const auto lines = readLines(path);
+        ASSERT_EQ(lines.size(), 3U);
+        EXPECT_EQ(lines[0], "mode=reset device=fdc cycles=10");
+        EXPECT_EQ(lines[1],
+                  "mode=write offset=   1 value=55  device=pia1 cycles=20");
+        EXPECT_EQ(lines[2],
+                  "mode=read  offset=   3 result=AA device=fdc cycles=30");
+    }
+    fs::remove(path);
+}
+
+TEST(test_iotrace, fct_Record_more_than_capacity)
+{
+    const auto path = fs::temp_directory_path() / u8"test_iotrace2.log";
+    const QWord count = 100000U;
+    {
+        IoTracer tracer(path);
+        const auto index = tracer.AddDevice("vico1");
+
+        for (QWord cycles = 0U; cycles < count; ++cycles)
+        {
+            tracer.Record({ cycles, 0U, index, IoTraceMode::Write,
+                            static_cast<Byte>(cycles) });
+        }
+    }
+
+    // All records are written when the tracer is destroyed.
+    const auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), count);
+    EXPECT_EQ(lines.back(),
+              "mode=write offset=   0 value=9F  device=vico1 cycles=99999");
+    fs::remove(path);
+}
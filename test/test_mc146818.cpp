@@ -0,0 +1,129 @@
+/*
+    test_mc146818.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "e2.h"
+#include "mc146818.h"
+#include "mc6809.h"
+#include "memory.h"
+#include "inout.h"
+#include "schedule.h"
+#include "fcnffile.h"
+#include "soptions.h"
+#include "cpustate.h"
+#include <array>
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// Run the CPU in an endless loop (BRA *) with the RTC using emulated time.
+class test_mc146818 : public ::testing::Test
+{
+protected:
+    static constexpr Word START{0x1000U};
+    static constexpr Word SECONDS{0x00U};
+
+    test_mc146818()
+        : configFile(std::make_shared<FlexemuConfigFile>(CreateConfigFile()))
+        , memory(options, configFile)
+        , cpu(memory)
+        , inout(options, memory)
+        , scheduler(cpu, inout)
+        , rtc(configFile)
+    {
+        const std::array<Byte, 2> endlessLoop{ 0x20U, 0xFEU };
+        Word address = START;
+
+        for (const auto value : endlessLoop)
+        {
+            memory.write_ram_rom(address++, value);
+        }
+        memory.write_ram_rom(0xFFFEU, START >> 8U);
+        memory.write_ram_rom(0xFFFFU, START & 0xFFU);
+        cpu.reset();
+    }
+
+    ~test_mc146818() override
+    {
+        std::error_code error;
+        fs::remove(fs::temp_directory_path() / u8"test_mc146818.conf", error);
+    }
+
+    // An empty configuration file contains the default configuration.
+    static fs::path CreateConfigFile()
+    {
+        const auto path = fs::temp_directory_path() / u8"test_mc146818.conf";
+        std::ofstream ofs(path);
+
+        return path;
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+    sOptions options;
+    FlexemuConfigFileSPtr configFile;
+    Memory memory;
+    Mc6809 cpu;
+    Inout inout;
+    Scheduler scheduler;
+    Mc146818 rtc;
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(test_mc146818, fct_emulated_time)
+{
+    const auto cyclesPerSecond =
+        static_cast<QWord>(ORIGINAL_FREQUENCY * 1000000.0F);
+
+    // The same sequence as on emulator startup: Set emulated time and
+    // afterwards reset all I/O devices.
+    rtc.set_emulated_time(&scheduler);
+    rtc.resetIo();
+    ASSERT_TRUE(rtc.is_emulated_time());
+
+    // Read the seconds register each emulated second, always half a
+    // second after the clock update. Stop after three seconds.
+    std::vector<Byte> seconds{ rtc.readIo(SECONDS) };
+
+    for (QWord count = 0U; count < 3U; ++count)
+    {
+        const auto cycles = count * cyclesPerSecond + cyclesPerSecond / 2U;
+
+        scheduler.schedule_event(cycles, [&](){
+            seconds.push_back(rtc.readIo(SECONDS));
+        });
+    }
+    scheduler.schedule_event(3U * cyclesPerSecond, [&](){
+        scheduler.request_new_state(CpuState::Stop);
+    });
+    EXPECT_EQ(scheduler.runloop(RunMode::RunningStart), CpuState::Stop);
+
+    // The clock is updated exactly once per emulated second.
+    ASSERT_EQ(seconds.size(), 4U);
+    EXPECT_EQ(seconds[1], seconds[0]);
+    EXPECT_EQ(seconds[2], (seconds[0] + 1U) % 60U);
+    EXPECT_EQ(seconds[3], (seconds[0] + 2U) % 60U);
+}
@@ -0,0 +1,118 @@
+/*
+    test_mc6809.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "mc6809.h"
+#include "memory.h"
+#include "fcnffile.h"
+#include "soptions.h"
+#include "cpustate.h"
+#include <array>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// Execute an idle loop (BRA *) on the CPU and check how the runloop
+// continues after the idle loop has been detected.
+class test_mc6809 : public ::testing::Test
+{
+protected:
+    static constexpr Word START{0x1000U};
+
+    test_mc6809()
+        : memory(options, std::make_shared<FlexemuConfigFile>(
+                 CreateConfigFile()))
+        , cpu(memory)
+    {
+        const std::array<Byte, 2> idleLoop{ 0x20U, 0xFEU };
+        Word address = START;
+
+        for (const auto value : idleLoop)
+        {
+            memory.write_ram_rom(address++, value);
+        }
+        memory.write_ram_rom(0xFFFEU, START >> 8U);
+        memory.write_ram_rom(0xFFFFU, START & 0xFFU);
+        cpu.reset();
+    }
+
+    ~test_mc6809() override
+    {
+        std::error_code error;
+        fs::remove(fs::temp_directory_path() / u8"test_mc6809.conf", error);
+    }
+
+    // An empty configuration file contains the default configuration.
+    static fs::path CreateConfigFile()
+    {
+        const auto path = fs::temp_directory_path() / u8"test_mc6809.conf";
+        std::ofstream ofs(path);
+
+        return path;
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+    sOptions options;
+    Memory memory;
+    Mc6809 cpu;
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(test_mc6809, fct_Idle_no_event)
+{
+    // Without frequency control and without a device event the CPU
+    // thread is suspended until the next timer tick.
+    cpu.set_idle();
+    EXPECT_EQ(cpu.run(RunMode::RunningStart), CpuState::Suspend);
+    EXPECT_EQ(cpu.get_cycles(), 0U);
+}
+
+TEST_F(test_mc6809, fct_Idle_event_deadline)
+{
+    // Without frequency control (frequency 0) the idle loop is skipped
+    // until the next device event.
+    cpu.set_event_deadline(100000U);
+    cpu.set_idle();
+    EXPECT_EQ(cpu.run(RunMode::RunningStart), CpuState::Schedule);
+    EXPECT_EQ(cpu.get_cycles(), 100000U);
+}
+
+TEST_F(test_mc6809, fct_Idle_event_deadline_frequency_control)
+{
+    // With frequency control the idle loop is skipped until the next
+    // device event if it is due before the required cycle count.
+    cpu.set_required_cyclecount(20000U);
+    cpu.set_event_deadline(5000U);
+    cpu.set_idle();
+    EXPECT_EQ(cpu.run(RunMode::RunningStart), CpuState::Schedule);
+    EXPECT_EQ(cpu.get_cycles(), 5000U);
+
+    // Otherwise until the required cycle count.
+    cpu.set_event_deadline(100000U);
+    cpu.set_idle();
+    EXPECT_EQ(cpu.run(RunMode::RunningContinue), CpuState::Suspend);
+    EXPECT_EQ(cpu.get_cycles(), 20000U);
+}
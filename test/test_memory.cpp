@@ -0,0 +1,224 @@
+/*
+    test_memory.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "e2.h"
+#include "memory.h"
+#include "iodevice.h"
+#include "fcnffile.h"
+#include "soptions.h"
+#include <bitset>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+// An I/O device which always reads the same value.
+class ConstantIoDevice : public IoDevice
+{
+public:
+    Byte readIo(Word /*offset*/) override { return 0x5AU; }
+    void writeIo(Word /*offset*/, Byte /*value*/) override { }
+    void resetIo() override { }
+    const char *getName() override { return "constant"; }
+    const char *getDescription() override { return ""; }
+    const char *getClassName() override { return "constant"; }
+    const char *getClassDescription() override { return ""; }
+    const char *getVendor() override { return ""; }
+    Word sizeOfIo() override { return 4U; }
+};
+
+class test_memory : public ::testing::Test
+{
+protected:
+    ~test_memory() override
+    {
+        std::error_code error;
+        fs::remove(GetConfigPath(), error);
+    }
+
+    static fs::path GetConfigPath()
+    {
+        return fs::temp_directory_path() / u8"test_memory.conf";
+    }
+
+    // Create a Memory with the given RAM pattern and debug option
+    // presetRAM.
+    std::unique_ptr<Memory> CreateMemory(const std::string &ramPattern,
+                                         bool isPresetRam = false)
+    {
+        {
+            std::ofstream ofs(GetConfigPath());
+
+            ofs << "[DebugSupport]\npresetRAM=" << (isPresetRam ? 1 : 0) <<
+                "\n[RuntimeSupport]\npresetRAMPattern=" << ramPattern << "\n";
+        }
+        const auto configFile =
+            std::make_shared<FlexemuConfigFile>(GetConfigPath());
+
+        return std::make_unique<Memory>(options, configFile);
+    }
+
+    // Return the number of bits set in main memory.
+    static std::size_t CountBits(Memory &memory)
+    {
+        std::size_t count = 0U;
+
+        for (DWord address = 0U; address <= 0xFFFFU; ++address)
+        {
+            count += std::bitset<8>(
+                memory.read_ram_rom(static_cast<Word>(address))).count();
+        }
+
+        return count;
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+    sOptions options;
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(test_memory, fct_pattern_all_zero)
+{
+    options.isRamExtension = true;
+    auto memory = CreateMemory("all_zero");
+    const auto *video_ram = memory->get_video_ram(0U, 0);
+
+    EXPECT_EQ(CountBits(*memory), 0U);
+    for (DWord offset = 0U; offset < VIDEORAM_SIZE; ++offset)
+    {
+        ASSERT_EQ(video_ram[offset], 0x00U) << "offset=" << offset;
+    }
+}
+
+TEST_F(test_memory, fct_pattern_all_one)
+{
+    options.isRamExtension = true;
+    auto memory = CreateMemory("all_one");
+    const auto *video_ram = memory->get_video_ram(1U, 0);
+
+    EXPECT_EQ(CountBits(*memory), 0x10000U * 8U);
+    for (DWord offset = 0U; offset < VIDEORAM_SIZE; ++offset)
+    {
+        ASSERT_EQ(video_ram[offset], 0xFFU) << "offset=" << offset;
+    }
+}
+
+TEST_F(test_memory, fct_pattern_lines64)
+{
+    options.isRamExtension = true;
+    auto memory = CreateMemory("lines64");
+    const auto *video_ram = memory->get_video_ram(0U, 0);
+
+    for (DWord address = 0U; address <= 0xFFFFU; ++address)
+    {
+        const Byte expected = ((address / 64U) % 2U == 0U) ? 0x00U : 0xFFU;
+
+        ASSERT_EQ(memory->read_ram_rom(static_cast<Word>(address)), expected)
+            << "address=" << address;
+    }
+    for (DWord offset = 0U; offset < VIDEORAM_SIZE; ++offset)
+    {
+        const Byte expected = ((offset / 64U) % 2U == 0U) ? 0x00U : 0xFFU;
+
+        ASSERT_EQ(video_ram[offset], expected) << "offset=" << offset;
+    }
+}
+
+TEST_F(test_memory, fct_pattern_random)
+{
+    const auto totalBits = 0x10000U * 8.0;
+
+    for (int percent = 10; percent <= 90; percent += 10)
+    {
+        const auto ramPattern = "random" + std::to_string(percent);
+        auto memory = CreateMemory(ramPattern);
+        const auto ratio = static_cast<double>(CountBits(*memory)) / totalBits;
+
+        EXPECT_NEAR(ratio, percent / 100.0, 0.02) << ramPattern;
+        // The pattern is not repeated within a table size.
+        bool isEqual = true;
+        for (Word address = 0U; address < 0x400U && isEqual; ++address)
+        {
+            isEqual = memory->read_ram_rom(address) ==
+                memory->read_ram_rom(address + 0x400U);
+        }
+        EXPECT_FALSE(isEqual) << ramPattern;
+    }
+}
+
+TEST_F(test_memory, fct_presetRAM)
+{
+    // With RAM extension the debug option presetRAM has priority over the
+    // RAM pattern. Each 16 KByte page contains its MMU index.
+    options.isRamExtension = true;
+    auto memory = CreateMemory("all_one", true);
+
+    for (DWord address = 0U; address <= 0xFFFFU; ++address)
+    {
+        const auto expected = static_cast<Byte>(((address >> 14U) << 4U) | 3U);
+
+        ASSERT_EQ(memory->read_ram_rom(static_cast<Word>(address)), expected)
+            << "address=" << address;
+    }
+    // Without HiMem the video RAM banks are shared by all MMU index
+    // groups, they contain the index of the last group.
+    EXPECT_EQ(memory->get_video_ram(0U, 0)[0], 0x3CU);
+    EXPECT_EQ(memory->get_video_ram(1U, 0)[0], 0x38U);
+
+    // Without RAM extension the RAM pattern is used.
+    options.isRamExtension = false;
+    memory = CreateMemory("all_one", true);
+    EXPECT_EQ(CountBits(*memory), 0x10000U * 8U);
+}
+
+TEST_F(test_memory, fct_ROM_and_IO_untouched)
+{
+    // RAM is only preset on construction. ROM and I/O devices added
+    // afterwards are not changed by it, also not on reset.
+    options.isRamExtension = true;
+    auto memory = CreateMemory("random50", true);
+    ConstantIoDevice device;
+
+    for (DWord address = 0xF000U; address <= 0xFFFFU; ++address)
+    {
+        memory->write_ram_rom(static_cast<Word>(address),
+                              static_cast<Byte>(address));
+    }
+    ASSERT_TRUE(memory->add_io_device(device, 0xFC00U));
+    memory->reset_io();
+
+    for (DWord address = 0xF000U; address <= 0xFFFFU; ++address)
+    {
+        ASSERT_EQ(memory->read_ram_rom(static_cast<Word>(address)),
+                  static_cast<Byte>(address)) << "address=" << address;
+    }
+    for (Word offset = 0U; offset < device.sizeOfIo(); ++offset)
+    {
+        EXPECT_EQ(memory->read_byte(0xFC00U + offset), 0x5AU);
+    }
+    EXPECT_EQ(memory->read_ram_rom(0x0000U), 0x03U);
+}
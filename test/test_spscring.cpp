@@ -0,0 +1,109 @@
+/*
+    test_spscring.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "spscring.h"
+#include <thread>
+#include <vector>
+
+
+TEST(test_spscring, fct_push_pop)
+{
+    SpscRing<int, 4U> ring;
+
+    EXPECT_EQ(ring.capacity(), 4U);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.size(), 0U);
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+    EXPECT_TRUE(ring.push(3));
+    EXPECT_TRUE(ring.push(4));
+    EXPECT_FALSE(ring.push(5));
+    EXPECT_EQ(ring.size(), 4U);
+    EXPECT_FALSE(ring.empty());
+    EXPECT_EQ(ring.front(), 1);
+    ring.pop();
+    EXPECT_EQ(ring.front(), 2);
+    ring.pop();
+    EXPECT_TRUE(ring.push(5));
+    EXPECT_TRUE(ring.push(6));
+    EXPECT_FALSE(ring.push(7));
+    std::vector<int> values;
+    while (!ring.empty())
+    {
+        values.push_back(ring.front());
+        ring.pop();
+    }
+    EXPECT_EQ(values, (std::vector<int>{ 3, 4, 5, 6 }));
+    EXPECT_EQ(ring.size(), 0U);
+}
+
+TEST(test_spscring, fct_clear)
+{
+    SpscRing<Byte, 8U> ring;
+
+    EXPECT_TRUE(ring.push('a'));
+    EXPECT_TRUE(ring.push('b'));
+    ring.clear();
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.size(), 0U);
+    EXPECT_TRUE(ring.push('c'));
+    EXPECT_EQ(ring.front(), 'c');
+}
+
+TEST(test_spscring, fct_producer_consumer)
+{
+    constexpr DWord count = 100000U;
+    SpscRing<DWord, 16U> ring;
+    std::vector<DWord> values;
+
+    values.reserve(count);
+    std::thread producer([&ring](){
+        for (DWord i = 0U; i < count; ++i)
+        {
+            while (!ring.push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    while (values.size() < count)
+    {
+        if (ring.empty())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        values.push_back(ring.front());
+        ring.pop();
+    }
+    producer.join();
+
+    ASSERT_EQ(values.size(), count);
+    for (DWord i = 0U; i < count; ++i)
+    {
+        ASSERT_EQ(values[i], i);
+    }
+    EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,293 @@
+/*
+    test_termimpr.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "termimpr.h"
+#include "soptions.h"
+#ifdef UNIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+
+TEST(test_termimpr, fct_IsValidEndpoint)
+{
+    EXPECT_TRUE(RemoteTerminalImpl::IsValidEndpoint("pty"));
+    EXPECT_TRUE(RemoteTerminalImpl::IsValidEndpoint("tcp:1"));
+    EXPECT_TRUE(RemoteTerminalImpl::IsValidEndpoint("tcp:65535"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint("tcp:0"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint("tcp:65536"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint("tcp:"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint("tcp:12a"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint("ptyx"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint(""));
+#ifdef UNIX
+    EXPECT_TRUE(RemoteTerminalImpl::IsValidEndpoint("unix:/tmp/sock"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint("unix:"));
+    EXPECT_FALSE(RemoteTerminalImpl::IsValidEndpoint(
+                "unix:/" + std::string(sizeof(sockaddr_un::sun_path), 'x')));
+#endif
+}
+
+#ifdef UNIX
+class test_termimpr_socket : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        path = fs::temp_directory_path() / u8"termimpr.sock";
+        options.terminalEndpoint = "unix:" + path.u8string();
+        terminal = std::make_unique<RemoteTerminalImpl>(options);
+        ASSERT_TRUE(terminal->init(0U, nullptr));
+        ASSERT_TRUE(terminal->is_terminal_supported());
+    }
+
+    void TearDown() override
+    {
+        terminal.reset();
+        EXPECT_FALSE(fs::exists(path));
+    }
+
+    // Return a connected client socket or -1 on error.
+    int Connect() const
+    {
+        struct sockaddr_un address{};
+        const auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd < 0)
+        {
+            return -1;
+        }
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.u8string().c_str(),
+                     sizeof(address.sun_path) - 1U);
+        if (connect(fd, reinterpret_cast<struct sockaddr *>(&address),
+                    sizeof(address)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    // Read characters on the CPU side until expected has been received,
+    // but at most two seconds. Return all characters received.
+    std::string ReadSerial(const std::string &expected) const
+    {
+        const auto endTime = std::chrono::steady_clock::now() + 2s;
+        std::string result;
+
+        while (result.size() < expected.size() &&
+               std::chrono::steady_clock::now() < endTime)
+        {
+            if (terminal->has_char_serial())
+            {
+                result.push_back(static_cast<char>(
+                            terminal->read_char_serial()));
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        return result;
+    }
+
+    // Read characters on the client side until size characters have
+    // been received, but at most two seconds.
+    static std::string ReadClient(int fd, std::size_t size)
+    {
+        std::string result;
+        struct pollfd pfd{};
+
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        while (result.size() < size && poll(&pfd, 1, 2000) > 0)
+        {
+            std::array<char, 256> buffer{};
+            const auto count = read(fd, buffer.data(), buffer.size());
+
+            if (count <= 0)
+            {
+                break;
+            }
+            result.append(buffer.data(), static_cast<std::size_t>(count));
+        }
+
+        return result;
+    }
+
+    static bool WriteClient(int fd, const std::string &text)
+    {
+        return write(fd, text.data(), text.size()) ==
+            static_cast<ssize_t>(text.size());
+    }
+
+    void WriteSerial(const std::string &text) const
+    {
+        for (const auto ch : text)
+        {
+            terminal->write_char_serial(static_cast<Byte>(ch));
+        }
+        terminal->flush_serial();
+    }
+
+    fs::path path;
+    sOptions options;
+    std::unique_ptr<RemoteTerminalImpl> terminal;
+};
+
+TEST_F(test_termimpr_socket, fct_round_trip)
+{
+    const auto fd = Connect();
+    ASSERT_GE(fd, 0) << "Unable to connect to " << path;
+
+    // Input from the client is received on the CPU side.
+    ASSERT_TRUE(WriteClient(fd, "dir 0\r"));
+    EXPECT_EQ(ReadSerial("dir 0\r"), "dir 0\r");
+    EXPECT_FALSE(terminal->has_char_serial());
+
+    // Output from the CPU side is sent to the client.
+    WriteSerial("Hello\r\n");
+    EXPECT_EQ(ReadClient(fd, 7U), "Hello\r\n");
+    close(fd);
+}
+
+TEST_F(test_termimpr_socket, fct_disconnect)
+{
+    const auto fd1 = Connect();
+    ASSERT_GE(fd1, 0) << "Unable to connect to " << path;
+    ASSERT_TRUE(WriteClient(fd1, "a"));
+    EXPECT_EQ(ReadSerial("a"), "a");
+    close(fd1);
+
+    // Only one client is accepted at a time, so the second client
+    // only is served after the disconnect of the first one.
+    const auto fd2 = Connect();
+    ASSERT_GE(fd2, 0) << "Unable to connect to " << path;
+    ASSERT_TRUE(WriteClient(fd2, "b"));
+    EXPECT_EQ(ReadSerial("b"), "b") << "Disconnect was not detected";
+    WriteSerial("c\n");
+    EXPECT_EQ(ReadClient(fd2, 2U), "c\n");
+    close(fd2);
+}
+
+TEST_F(test_termimpr_socket, fct_disconnect_rx_full)
+{
+    // The client sends more than the receive buffer can hold and then
+    // disconnects. The hang up is detected although the receive buffer
+    // is full.
+    const std::string input(5000U, 'x');
+    const auto fd1 = Connect();
+    ASSERT_GE(fd1, 0) << "Unable to connect to " << path;
+    ASSERT_TRUE(WriteClient(fd1, input));
+    std::this_thread::sleep_for(50ms);
+    close(fd1);
+
+    const auto fd2 = Connect();
+    ASSERT_GE(fd2, 0) << "Unable to connect to " << path;
+    ASSERT_TRUE(WriteClient(fd2, "z"));
+    const auto endTime = std::chrono::steady_clock::now() + 2s;
+    std::string result;
+    while ((result.empty() || result.back() != 'z') &&
+           std::chrono::steady_clock::now() < endTime)
+    {
+        if (terminal->has_char_serial())
+        {
+            result.push_back(static_cast<char>(terminal->read_char_serial()));
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    ASSERT_FALSE(result.empty());
+    EXPECT_EQ(result.back(), 'z') << "Second client was not served";
+    close(fd2);
+}
+
+TEST_F(test_termimpr_socket, fct_output_back_pressure)
+{
+    const auto fd = Connect();
+    ASSERT_GE(fd, 0) << "Unable to connect to " << path;
+    ASSERT_TRUE(WriteClient(fd, "a"));
+    EXPECT_EQ(ReadSerial("a"), "a");
+
+    // The client does not read. The guest writes as long as the
+    // terminal accepts output, as it does when polling the transmit data
+    // register empty flag, until the transmit buffer is full.
+    std::string output;
+    const auto endTime = std::chrono::steady_clock::now() + 2s;
+    while (std::chrono::steady_clock::now() < endTime &&
+           output.size() < 16U * 1024U * 1024U)
+    {
+        if (terminal->can_write_char_serial())
+        {
+            const auto ch = static_cast<char>('A' + output.size() % 26U);
+
+            terminal->write_char_serial(static_cast<Byte>(ch));
+            output.push_back(ch);
+        }
+        else if (!output.empty())
+        {
+            break;
+        }
+    }
+    ASSERT_FALSE(terminal->can_write_char_serial());
+
+    // After the client has read some output the terminal accepts
+    // output again. No output has been lost.
+    const auto result = ReadClient(fd, output.size());
+    EXPECT_TRUE(terminal->can_write_char_serial());
+    EXPECT_EQ(result.size(), output.size());
+    EXPECT_TRUE(result == output);
+    close(fd);
+}
+
+TEST_F(test_termimpr_socket, fct_output_without_client)
+{
+    // Output is discarded while no client is connected.
+    WriteSerial("lost\n");
+    const auto fd = Connect();
+    ASSERT_GE(fd, 0) << "Unable to connect to " << path;
+    ASSERT_TRUE(WriteClient(fd, "a"));
+    EXPECT_EQ(ReadSerial("a"), "a");
+    WriteSerial("b\n");
+    EXPECT_EQ(ReadClient(fd, 2U), "b\n");
+    close(fd);
+}
+#endif
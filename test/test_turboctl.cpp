@@ -0,0 +1,176 @@
+/*
+    test_turboctl.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "turboctl.h"
+#include "bobshelp.h"
+#include <vector>
+
+
+class test_turboctl : public ::testing::Test
+{
+protected:
+    test_turboctl()
+        : turboControl([&](bool isTurbo){ turboChanges.push_back(isTurbo); })
+    {
+        turboControl.SetQuietTime(100U);
+    }
+
+    std::vector<bool> turboChanges;
+    TurboControl turboControl;
+};
+
+TEST_F(test_turboctl, fct_OnTimer_quiet_time)
+{
+    turboControl.OnTimer(1000000U);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    turboControl.OnTimer(1050000U);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    turboControl.OnTimer(1099999U);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    turboControl.OnTimer(1100000U);
+    EXPECT_TRUE(turboControl.IsTurbo());
+    turboControl.OnTimer(1200000U);
+    EXPECT_TRUE(turboControl.IsTurbo());
+    EXPECT_EQ(turboChanges, std::vector<bool>{ true });
+}
+
+TEST_F(test_turboctl, fct_UpdateFrom_InputRequested)
+{
+    turboControl.OnTimer(1000000U);
+    turboControl.OnTimer(1100000U);
+    EXPECT_TRUE(turboControl.IsTurbo());
+    turboControl.UpdateFrom(NotifyId::InputRequested);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    turboControl.UpdateFrom(NotifyId::InputRequested);
+    // The quiet time restarts with the last input request.
+    turboControl.OnTimer(1150000U);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    turboControl.OnTimer(1249999U);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    turboControl.OnTimer(1250000U);
+    EXPECT_TRUE(turboControl.IsTurbo());
+    EXPECT_EQ(turboChanges, (std::vector<bool>{ true, false, true }));
+}
+
+TEST_F(test_turboctl, fct_UpdateFrom_DiskActive)
+{
+    turboControl.UpdateFrom(NotifyId::DiskActive);
+    EXPECT_TRUE(turboControl.IsTurbo());
+    turboControl.UpdateFrom(NotifyId::DiskActive);
+    EXPECT_TRUE(turboControl.IsTurbo());
+    turboControl.UpdateFrom(NotifyId::InputRequested);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    turboControl.UpdateFrom(NotifyId::DiskActive);
+    EXPECT_TRUE(turboControl.IsTurbo());
+    EXPECT_EQ(turboChanges, (std::vector<bool>{ true, false, true }));
+}
+
+TEST_F(test_turboctl, fct_UpdateFrom_other)
+{
+    turboControl.UpdateFrom(NotifyId::RequestScreenUpdate);
+    EXPECT_FALSE(turboControl.IsTurbo());
+    EXPECT_TRUE(turboChanges.empty());
+}
+
+// The guest polls the input status in a loop until a character is
+// available.
+TEST(test_inputpoll, fct_OnPoll_blocked)
+{
+    InputPollDetector detector;
+    QWord cycles = 1000U;
+    DWord count = 0U;
+
+    while (!detector.OnPoll(cycles, false) && count < 100U)
+    {
+        cycles += 40U;
+        ++count;
+    }
+    EXPECT_GE(count, InputPollDetector::MIN_POLLS);
+    EXPECT_LE(count, InputPollDetector::MIN_POLLS + 1U);
+    EXPECT_TRUE(detector.OnPoll(cycles + 40U, false));
+    // A character is available, it is read by the guest.
+    EXPECT_FALSE(detector.OnPoll(cycles + 80U, true));
+    detector.OnTransfer();
+    EXPECT_FALSE(detector.OnPoll(cycles + 120U, false));
+}
+
+TEST(test_inputpoll, fct_OnPoll_different_cycles)
+{
+    InputPollDetector detector;
+    QWord cycles = 1000U;
+
+    // A loop with polls at different cycle intervals or with too many
+    // cycles between two polls is not waiting for input.
+    for (DWord i = 0U; i < 4U * InputPollDetector::MIN_POLLS; ++i)
+    {
+        cycles += 40U + (i % 2U);
+        EXPECT_FALSE(detector.OnPoll(cycles, false));
+    }
+    for (DWord i = 0U; i < 4U * InputPollDetector::MIN_POLLS; ++i)
+    {
+        cycles += InputPollDetector::MAX_POLL_CYCLES + 1U;
+        EXPECT_FALSE(detector.OnPoll(cycles, false));
+    }
+}
+
+// The guest prints text. For each character the monitor checks the
+// keyboard for Ctrl-X and writes the character to the serial port
+// after polling the transmit data register empty flag. Both reads the
+// status register. This is no input request, turbo mode stays on.
+TEST_F(test_turboctl, fct_output_polling_keeps_turbo)
+{
+    InputPollDetector detector;
+    QWord cycles = 1000U;
+    QWord timeUs = 1000000U;
+
+    turboControl.OnTimer(timeUs);
+    timeUs += 100000U;
+    turboControl.OnTimer(timeUs);
+    ASSERT_TRUE(turboControl.IsTurbo());
+
+    for (int count = 0; count < 1000; ++count)
+    {
+        // Ctrl-X check.
+        cycles += 60U;
+        if (detector.OnPoll(cycles, false))
+        {
+            turboControl.UpdateFrom(NotifyId::InputRequested);
+        }
+        // Wait for transmit data register empty.
+        cycles += 30U;
+        if (detector.OnPoll(cycles, false))
+        {
+            turboControl.UpdateFrom(NotifyId::InputRequested);
+        }
+        detector.OnTransfer();
+        if (count % 100 == 0)
+        {
+            timeUs += 10000U;
+            turboControl.OnTimer(timeUs);
+        }
+    }
+
+    EXPECT_TRUE(turboControl.IsTurbo());
+    EXPECT_EQ(turboChanges, std::vector<bool>{ true });
+}
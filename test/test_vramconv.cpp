@@ -0,0 +1,88 @@
+/*
+    test_vramconv.cpp
+
+
+    flexemu, an MC6809 emulator running FLEX
+    Copyright (C) 2026  W. Schwotzer
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+
+
+#include "gtest/gtest.h"
+#include "typedefs.h"
+#include "e2.h"
+#include "vramconv.h"
+#include <array>
+#include <vector>
+
+
+TEST(test_vramconv, fct_getColorPlanes)
+{
+    EXPECT_EQ(flx::getColorPlanes(2), 1U);
+    EXPECT_EQ(flx::getColorPlanes(8), 3U);
+    EXPECT_EQ(flx::getColorPlanes(64), 6U);
+}
+
+TEST(test_vramconv, fct_convertVideoRamBlock)
+{
+    std::vector<Byte> videoRam(static_cast<size_t>(YBLOCK_SIZE) *
+                               COLOR_PLANES);
+    std::vector<Byte> pixels(static_cast<size_t>(WINDOWWIDTH) * BLOCKHEIGHT);
+
+    // 2 colors: Only plane 0 is used.
+    videoRam[0] = 0x81U;
+    videoRam[RASTERLINE_SIZE] = 0x40U;
+    flx::convertVideoRamBlock(pixels.data(), WINDOWWIDTH, videoRam.data(), 2,
+                              false);
+    EXPECT_EQ(pixels[0], GREEN_HIGH);
+    EXPECT_EQ(pixels[1], 0U);
+    EXPECT_EQ(pixels[7], GREEN_HIGH);
+    EXPECT_EQ(pixels[8], 0U);
+    EXPECT_EQ(pixels[WINDOWWIDTH], 0U);
+    EXPECT_EQ(pixels[WINDOWWIDTH + 1], GREEN_HIGH);
+
+    // 2 colors inverse: Color index is shifted to the end of the color table.
+    flx::convertVideoRamBlock(pixels.data(), WINDOWWIDTH, videoRam.data(), 2,
+                              true);
+    EXPECT_EQ(pixels[0], GREEN_HIGH + 31U);
+    EXPECT_EQ(pixels[1], 31U);
+
+    // 64 colors: All six planes are used. The planes are ordered
+    // green, red, blue high followed by green, red, blue low.
+    videoRam.assign(videoRam.size(), 0U);
+    for (int plane = 0; plane < COLOR_PLANES; ++plane)
+    {
+        videoRam[static_cast<size_t>(plane) * YBLOCK_SIZE] =
+            static_cast<Byte>(0x80U >> plane);
+    }
+    flx::convertVideoRamBlock(pixels.data(), WINDOWWIDTH, videoRam.data(), 64,
+                              false);
+    EXPECT_EQ(pixels[0], GREEN_HIGH);
+    EXPECT_EQ(pixels[1], RED_HIGH);
+    EXPECT_EQ(pixels[2], BLUE_HIGH);
+    EXPECT_EQ(pixels[3], GREEN_LOW);
+    EXPECT_EQ(pixels[4], RED_LOW);
+    EXPECT_EQ(pixels[5], BLUE_LOW);
+    EXPECT_EQ(pixels[6], 0U);
+
+    // No video source: Use the highest available color.
+    flx::convertVideoRamBlock(pixels.data(), WINDOWWIDTH, nullptr, 2, false);
+    EXPECT_EQ(pixels[0], 0x3FU);
+    EXPECT_EQ(pixels[(WINDOWWIDTH * BLOCKHEIGHT) - 1], 0x3FU);
+    flx::convertVideoRamBlock(pixels.data(), WINDOWWIDTH, nullptr, 2, true);
+    EXPECT_EQ(pixels[0], 0x00U);
+}